@@ -0,0 +1,65 @@
+/*
+  icondensedworkstate_c.h: packed section work states published
+    through the condensed work state process data
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef ICONDENSEDWORKSTATE_C_H
+#define ICONDENSEDWORKSTATE_C_H
+
+#include "impl/procdata/condensedworkstate_c.h"
+#include "iprocdata_c.h"
+
+
+namespace IsoAgLib {
+
+  /** Section work states of a wide boom, published through the condensed
+      work state DDIs (161..176 actual, 290..305 setpoint). Set the states
+      per section as often as convenient, only the changed DDIs are
+      committed to their iProcData_c once per cycle. */
+  class iCondensedWorkState_c : private __IsoAgLib::CondensedWorkState_c {
+    public:
+      iCondensedWorkState_c() : CondensedWorkState_c() {}
+      virtual ~iCondensedWorkState_c() {}
+
+      //! add the iProcData_c of one condensed work state DDI
+      void add( iProcData_c& pd ) {
+        CondensedWorkState_c::add( static_cast<__IsoAgLib::ProcData_c&>( pd ) );
+      }
+
+      //! @param section 0..255
+      void setState( uint16_t section, ProcData::WorkState_t state ) {
+        CondensedWorkState_c::setState( section, state );
+      }
+      ProcData::WorkState_t getState( uint16_t section ) const {
+        return CondensedWorkState_c::getState( section );
+      }
+
+      //! commit all changed states immediately
+      void flush() {
+        CondensedWorkState_c::flush();
+      }
+
+      //! number of DDIs with states not yet committed
+      unsigned numPending() const {
+        return CondensedWorkState_c::numPending();
+      }
+  };
+
+}
+
+#endif
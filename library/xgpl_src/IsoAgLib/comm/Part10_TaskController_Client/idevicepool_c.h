@@ -182,6 +182,10 @@ namespace IsoAgLib {
       virtual void calcChecksumStart() { /* no default implementation */ }
       virtual void calcChecksumAdd( uint8_t ) { /* no default implementation */ }
       virtual void calcChecksumEnd() { /* no default implementation */ }
+      // default passes the bytes one by one to calcChecksumAdd( uint8_t )
+      virtual void calcChecksumAdd( const uint8_t* bp, size_t len ) {
+        __IsoAgLib::DevicePool_c::calcChecksumAdd( bp, len );
+      }
 
       void calcChecksum() {
         __IsoAgLib::DevicePool_c::calcChecksum();
@@ -202,12 +206,6 @@ namespace IsoAgLib {
         __IsoAgLib::DevicePool_c::clear();
       }
 
-      /* changing designators is not yet supported */
-      template<class T>
-      void changeDesignator( T& obj, const char* str ) {
-        __IsoAgLib::DevicePool_c::changeDesignator( obj, str );
-      }
-
       void setLocalSettings( const localSettings_s& l ) {
         __IsoAgLib::DevicePool_c::setLocalSettings( l );
       }
@@ -0,0 +1,105 @@
+/*
+  connectedpdtable_c.cpp: open addressing table of a connection's
+    ConnectedPd_c by (DDI, element)
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "connectedpdtable_c.h"
+#include <IsoAgLib/util/iassert.h>
+
+
+namespace __IsoAgLib {
+
+  void
+  ConnectedPdTable_c::reserve( uint32_t numEntries )
+  {
+    uint32_t numSlots = 8;
+    uint8_t shift = 32 - 3;
+    while( numSlots < 2 * numEntries )
+    {
+      numSlots *= 2;
+      --shift;
+    }
+
+    Slot_s unused = { 0, NULL };
+    mvec_slots.assign( numSlots, unused );
+    mui32_mask = numSlots - 1;
+    mui8_shift = shift;
+    mui32_size = 0;
+  }
+
+
+  void
+  ConnectedPdTable_c::clear()
+  {
+    mvec_slots.clear();
+    mui32_mask = 0;
+    mui8_shift = 32;
+    mui32_size = 0;
+  }
+
+
+  void
+  ConnectedPdTable_c::insert( uint16_t ddi, uint16_t element, ConnectedPd_c& cPd )
+  {
+    if( 2 * ( mui32_size + 1 ) > mvec_slots.size() )
+    { // not (enough) reserved: grow and re-insert
+      STL_NAMESPACE::vector<Slot_s> old;
+      old.swap( mvec_slots );
+      reserve( mui32_size + 1 );
+      for( uint32_t i = 0; i < old.size(); ++i )
+      {
+        if( old[ i ].cPd )
+          insert( uint16_t( old[ i ].key >> 16 ), uint16_t( old[ i ].key ), *old[ i ].cPd );
+      }
+    }
+
+    const uint32_t k = key( ddi, element );
+    for( uint32_t index = startIndex( k );; index = ( index + 1 ) & mui32_mask )
+    {
+      Slot_s& s = mvec_slots[ index ];
+      if( s.cPd == NULL )
+      {
+        s.key = k;
+        s.cPd = &cPd;
+        ++mui32_size;
+        return;
+      }
+      isoaglib_assert( s.key != k );
+    }
+  }
+
+
+  ConnectedPd_c*
+  ConnectedPdTable_c::find( uint16_t ddi, uint16_t element ) const
+  {
+    if( mui32_size == 0 )
+      return NULL;
+
+    const uint32_t k = key( ddi, element );
+    // terminates, as the table is at most half full
+    for( uint32_t index = startIndex( k );; index = ( index + 1 ) & mui32_mask )
+    {
+      const Slot_s& s = mvec_slots[ index ];
+      if( s.cPd == NULL )
+        return NULL;
+      if( s.key == k )
+        return s.cPd;
+    }
+  }
+
+}
@@ -0,0 +1,76 @@
+/*
+  connectedpdtable_c.h: open addressing table of a connection's
+    ConnectedPd_c by (DDI, element)
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef CONNECTEDPDTABLE_C_H
+#define CONNECTEDPDTABLE_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <vector>
+
+
+namespace __IsoAgLib {
+
+  class ConnectedPd_c;
+
+
+  /** Lookup of the ConnectedPd_c for incoming process data commands.
+      The table is sized once per connection from the number of process
+      data of the pool (at most half full, so the probe sequences stay
+      short) and only cleared as a whole, so there are no tombstones.
+    */
+  class ConnectedPdTable_c
+  {
+  public:
+    ConnectedPdTable_c() : mvec_slots(), mui32_mask( 0 ), mui8_shift( 32 ), mui32_size( 0 ) {}
+
+    /** clear and size the table for the given number of entries */
+    void reserve( uint32_t numEntries );
+    void clear();
+
+    void insert( uint16_t ddi, uint16_t element, ConnectedPd_c& cPd );
+    ConnectedPd_c* find( uint16_t ddi, uint16_t element ) const;
+
+    uint32_t size() const { return mui32_size; }
+    bool empty() const { return mui32_size == 0; }
+
+    /** for iterating over all entries: slots may be empty (NULL) */
+    uint32_t numSlots() const { return uint32_t( mvec_slots.size() ); }
+    ConnectedPd_c* slot( uint32_t index ) const { return mvec_slots[ index ].cPd; }
+
+  private:
+    struct Slot_s
+    {
+      uint32_t key;
+      ConnectedPd_c* cPd; // NULL: unused
+    };
+
+    static uint32_t key( uint16_t ddi, uint16_t element ) { return ( uint32_t( ddi ) << 16 ) | element; }
+    // multiplicative hashing, the upper bits of the product depend on all bits of the key
+    uint32_t startIndex( uint32_t aui32_key ) const { return uint32_t( aui32_key * 0x9E3779B1UL ) >> mui8_shift; }
+
+    STL_NAMESPACE::vector<Slot_s> mvec_slots;
+    uint32_t mui32_mask;
+    uint8_t mui8_shift; // 32 - log2( number of slots )
+    uint32_t mui32_size;
+  };
+
+}
+
+#endif
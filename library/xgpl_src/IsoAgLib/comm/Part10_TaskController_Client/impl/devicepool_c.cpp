@@ -32,6 +32,7 @@ namespace __IsoAgLib {
   /* --- DeviceObject_c -------------------------------------------------- */
 
   uint16_t DeviceObject_c::m_objIdCounter = 1;
+  uint32_t DeviceObject_c::m_changeCounter = 0;
 
   DeviceObject_c::DeviceObject_c( const IsoAgLib::ProcData::DeviceObjectType_t type, const char* desig )
     : m_objectType( type ),
@@ -48,6 +49,7 @@ namespace __IsoAgLib {
   void DeviceObject_c::init( const char* desig ) {
     isoaglib_assert( !desig || (CNAMESPACE::strlen( desig ) <= 32) );
     m_designator = desig;
+    setChanged();
   }
 
 
@@ -55,6 +57,7 @@ namespace __IsoAgLib {
     isoaglib_assert( desig );
     isoaglib_assert( CNAMESPACE::strlen( desig ) <= 32 );
     m_designator = desig;
+    setChanged();
   }
 
 
@@ -71,12 +74,25 @@ namespace __IsoAgLib {
   }
 
 
-  void DeviceObject_c::calcChecksumAddHeader( DevicePool_c &pool ) const
+
+  void DeviceObject_c::formatStructureHeader( StructureImage_c &image ) const
   {
     static const char* deviceLabels[] = { "DVC", "DET", "DPD", "DPT", "DVP" };
 
-    pool.calcChecksumAdd( ( const uint8_t* )(deviceLabels[m_objectType]), 3 );
-    pool.calcChecksumAdd( m_objectId );
+    image.format( ( const uint8_t* )(deviceLabels[m_objectType]), 3 );
+    image.format( m_objectId );
+  }
+
+
+  void StructureImage_c::format( uint16_t val ) {
+    format( ( uint8_t )( val & 0xff ) );
+    format( ( uint8_t )( ( val >> 8 ) & 0xff ) );
+  }
+
+
+  void StructureImage_c::format( uint32_t val ) {
+    format( ( uint16_t )( val & 0xffff ) );
+    format( ( uint16_t )( ( val >> 16 ) & 0xffff ) );
   }
 
 
@@ -224,17 +240,17 @@ namespace __IsoAgLib {
 
 
   void
-  DeviceObjectDvc_c::calcChecksumAdd( DevicePool_c &pool ) const
+  DeviceObjectDvc_c::formatStructure( StructureImage_c &image ) const
   {
-    calcChecksumAddHeader( pool );
+    formatStructureHeader( image );
 
-  //pool.calcChecksumAdd( m_designator );
-  //pool.calcChecksumAdd( m_version );
-  //pool.calcChecksumAdd( getWsmName().outputString(), 8 );
-  //pool.calcChecksumAdd( m_serialNumber );
+  //image.format( m_designator );
+  //image.format( m_version );
+  //image.format( getWsmName().outputString(), 8 );
+  //image.format( m_serialNumber );
 
-  //pool.calcChecksumAdd( ( uint8_t* )&m_structLabel, 7 );
-  //pool.calcChecksumAdd( ( uint8_t* )&m_localization, 7 );
+  //image.format( ( uint8_t* )&m_structLabel, 7 );
+  //image.format( ( uint8_t* )&m_localization, 7 );
   }
 
 
@@ -295,6 +311,7 @@ namespace __IsoAgLib {
 
     const size_t oldSize = m_childList.size();
     m_childList.push_back( childId );
+    setChanged();
     return m_childList.size() > oldSize;
   }
 
@@ -310,20 +327,21 @@ namespace __IsoAgLib {
   }
 
 
+
   void
-  DeviceObjectDet_c::calcChecksumAdd( DevicePool_c &pool ) const
+  DeviceObjectDet_c::formatStructure( StructureImage_c &image ) const
   {
-    calcChecksumAddHeader( pool );
+    formatStructureHeader( image );
 
-    pool.calcChecksumAdd( uint8_t( m_type ) );
-  //pool.calcChecksumAdd( m_designator );
-    pool.calcChecksumAdd( m_elementNumber );
-    pool.calcChecksumAdd( m_parentId );
-    pool.calcChecksumAdd( ( uint16_t )m_childList.size() );
+    image.format( uint8_t( m_type ) );
+  //image.format( m_designator );
+    image.format( m_elementNumber );
+    image.format( m_parentId );
+    image.format( ( uint16_t )m_childList.size() );
 
     STL_NAMESPACE::vector<uint16_t>::const_iterator it;
     for ( it = m_childList.begin(); it != m_childList.end(); ++it )
-      pool.calcChecksumAdd( *it );
+      image.format( *it );
   }
 
 
@@ -331,6 +349,7 @@ namespace __IsoAgLib {
   DeviceObjectDet_c::clearChildren()
   {
 	  m_childList.clear();
+	  setChanged();
   }
 
 
@@ -401,16 +420,17 @@ namespace __IsoAgLib {
   }
 
 
+
   void
-  DeviceObjectDpd_c::calcChecksumAdd( DevicePool_c &pool ) const
+  DeviceObjectDpd_c::formatStructure( StructureImage_c &image ) const
   {
-    calcChecksumAddHeader( pool );
+    formatStructureHeader( image );
 
-    pool.calcChecksumAdd( m_ddi );
-    pool.calcChecksumAdd( m_properties );
-    pool.calcChecksumAdd( m_method );
-  //pool.calcChecksumAdd( m_designator );
-    pool.calcChecksumAdd( m_dvpObjectId );
+    image.format( m_ddi );
+    image.format( m_properties );
+    image.format( m_method );
+  //image.format( m_designator );
+    image.format( m_dvpObjectId );
   }
 
 
@@ -461,15 +481,16 @@ namespace __IsoAgLib {
   }
 
 
+
   void
-  DeviceObjectDpt_c::calcChecksumAdd( DevicePool_c &pool ) const
+  DeviceObjectDpt_c::formatStructure( StructureImage_c &image ) const
   {
-    calcChecksumAddHeader( pool );
+    formatStructureHeader( image );
 
-    pool.calcChecksumAdd( m_ddi );
-    pool.calcChecksumAdd( m_value );
-  //pool.calcChecksumAdd( m_designator );
-    pool.calcChecksumAdd( m_dvpObjectId );
+    image.format( m_ddi );
+    image.format( m_value );
+  //image.format( m_designator );
+    image.format( m_dvpObjectId );
   }
 
 
@@ -499,15 +520,16 @@ namespace __IsoAgLib {
   }
 
 
+
   void
-  DeviceObjectDvp_c::calcChecksumAdd( DevicePool_c &pool ) const
+  DeviceObjectDvp_c::formatStructure( StructureImage_c &image ) const
   {
-    calcChecksumAddHeader( pool );
+    formatStructureHeader( image );
 
-  //pool.calcChecksumAdd( m_offset );
-  //pool.calcChecksumAdd( m_scale );
-  //pool.calcChecksumAdd( m_decimals );
-  //pool.calcChecksumAdd( m_designator );
+  //image.format( m_offset );
+  //image.format( m_scale );
+  //image.format( m_decimals );
+  //image.format( m_designator );
   }
 
 
@@ -518,6 +540,9 @@ namespace __IsoAgLib {
   DevicePool_c::DevicePool_c( unsigned int reserveSize )
     : PdPool_c( reserveSize )
     , m_devicePool()
+    , m_structureImage()
+    , m_structureImageValid( false )
+    , m_structureImageChangeCounter( 0 )
   {}
 
 
@@ -563,6 +588,7 @@ namespace __IsoAgLib {
     isoaglib_assert( (devObj.getObjectType() != IsoAgLib::ProcData::ObjectTypeDET) || (getDetObject(((DeviceObjectDet_c*)&devObj)->elementNumber()) == NULL) );
     (void)m_devicePool.insert(
       STL_NAMESPACE::pair<uint16_t, DeviceObject_c*>( devObj.getObjectId(), &devObj ) ).second;
+    invalidateCache();
   }
 
 
@@ -580,8 +606,18 @@ namespace __IsoAgLib {
   {
     m_devicePool.clear();
     m_procDatas.clear();
+    invalidateCache();
   }
 
+
+  void DevicePool_c::invalidateCache()
+  {
+    m_cachedBytestream[ 0 ].valid = false;
+    m_cachedBytestream[ 1 ].valid = false;
+    m_structureImageValid = false;
+  }
+
+
 #if 0
 // currently not supported
   void DevicePool_c::changeDesignator( DeviceObject_c& obj, const char* str ) {
@@ -593,6 +629,7 @@ namespace __IsoAgLib {
 
 
   void DevicePool_c::setLocalSettings( const localSettings_s& l ) {
+    // as part of the DVC the localization isn't cached, so there's nothing to invalidate
     getDvcObject()->setLocalSettings( l );
     // @todo: call TcClient_c function (partial Pool-Upload will be triggered)
   }
@@ -610,36 +647,83 @@ namespace __IsoAgLib {
 
 
   ByteStreamBuffer_c DevicePool_c::getBytestream( uint8_t cmd, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) {
-    const uint32_t size = getBytestreamSize( caps ) + 1; // one extra byte for command
+    const STL_NAMESPACE::vector<uint8_t>& cached = getCachedBytestream( caps );
+    const DeviceObjectDvc_c* dvc = getDvcObject();
+
+    const uint32_t size = 1 // one extra byte for command
+                        + ( dvc ? dvc->getSize( caps ) : 0 )
+                        + uint32_t( cached.size() );
     ByteStreamBuffer_c buffer;
     buffer.setBuffer( allocByteStreamBuffer( size ) );
     buffer.setSize( size );
     buffer.format( cmd );
 
-    for ( deviceMap_t::iterator it = m_devicePool.begin(); it != m_devicePool.end(); ++it ) {
-      it->second->formatBytestream( buffer, caps );
+    // the DVC has object id 0, so it's always the first object
+    if( dvc )
+      dvc->formatBytestream( buffer, caps );
+
+    if( !cached.empty() )
+    {
+      CNAMESPACE::memcpy( buffer.getBuffer() + buffer.getEnd(), &cached[ 0 ], cached.size() );
+      buffer.setEnd( buffer.getEnd() + uint32_t( cached.size() ) );
     }
+    isoaglib_assert( buffer.getEnd() == size );
 
     return buffer;
   }
 
 
-  uint32_t DevicePool_c::getBytestreamSize( const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) const {
+  const STL_NAMESPACE::vector<uint8_t>& DevicePool_c::getCachedBytestream( const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) {
+    CachedBytestream_s &cache = m_cachedBytestream[ caps.hasPeerControl ? 1 : 0 ];
+    if( cache.valid && ( cache.changeCounter == DeviceObject_c::m_changeCounter ) )
+      return cache.bytes;
+
     uint32_t size = 0;
     for ( deviceMap_t::const_iterator it = m_devicePool.begin(); it != m_devicePool.end(); ++it ) {
-      size += it->second->getSize( caps );
+      if( it->second->getObjectType() != IsoAgLib::ProcData::ObjectTypeDVC )
+        size += it->second->getSize( caps );
     }
-    return size;
+
+    cache.bytes.resize( size );
+
+    ByteStreamBuffer_c buffer;
+    buffer.setBuffer( cache.bytes.empty() ? NULL : &cache.bytes[ 0 ] );
+    buffer.setSize( size );
+    for ( deviceMap_t::const_iterator it = m_devicePool.begin(); it != m_devicePool.end(); ++it ) {
+      if( it->second->getObjectType() != IsoAgLib::ProcData::ObjectTypeDVC ) {
+        it->second->formatBytestream( buffer, caps );
+      }
+    }
+    isoaglib_assert( buffer.getEnd() == size );
+
+    cache.valid = true;
+    cache.changeCounter = DeviceObject_c::m_changeCounter;
+    return cache.bytes;
   }
 
-  void DevicePool_c::calcChecksum()
+
+  const StructureImage_c& DevicePool_c::getStructureImage()
   {
-    calcChecksumStart();
-    
+    if( m_structureImageValid && ( m_structureImageChangeCounter == DeviceObject_c::m_changeCounter ) )
+      return m_structureImage;
+
+    m_structureImage.clear();
     for ( deviceMap_t::const_iterator it = m_devicePool.begin(); it != m_devicePool.end(); ++it ) {
-      it->second->calcChecksumAdd( *this );
+      it->second->formatStructure( m_structureImage );
     }
 
+    m_structureImageValid = true;
+    m_structureImageChangeCounter = DeviceObject_c::m_changeCounter;
+    return m_structureImage;
+  }
+
+
+  void DevicePool_c::calcChecksum()
+  {
+    const StructureImage_c &image = getStructureImage();
+
+    calcChecksumStart();
+    calcChecksumAdd( image.data(), image.size() );
     calcChecksumEnd();
   }
 
@@ -24,6 +24,8 @@
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/procdata_c.h>
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/pdpool_c.h>
 
+#include <vector>
+
 
 namespace __IsoAgLib {
 
@@ -56,6 +58,28 @@ namespace __IsoAgLib {
   } ExtendedStructureLabel_s;
 
 
+  /* growing little endian byte image of the structure relevant parts
+     of the device objects, the structure checksum is calculated on */
+  class StructureImage_c {
+    public:
+      StructureImage_c() : m_bytes() {}
+
+      void format( uint8_t val ) { m_bytes.push_back( val ); }
+      void format( uint16_t val );
+      void format( uint32_t val );
+      void format( int32_t val ) { format( uint32_t( val ) ); }
+      void format( const uint8_t* bp, size_t len ) { m_bytes.insert( m_bytes.end(), bp, bp + len ); }
+
+      void clear() { m_bytes.clear(); }
+      bool empty() const { return m_bytes.empty(); }
+      const uint8_t* data() const { return m_bytes.empty() ? NULL : &m_bytes[ 0 ]; }
+      size_t size() const { return m_bytes.size(); }
+
+    private:
+      STL_NAMESPACE::vector<uint8_t> m_bytes;
+  };
+
+
   class DeviceObject_c {
     public:
       DeviceObject_c( const IsoAgLib::ProcData::DeviceObjectType_t type, const char* desig );
@@ -71,6 +95,8 @@ namespace __IsoAgLib {
         return m_objectType;
       }
 
+      // the designator isn't copied: change it with setDesignator() only, as
+      // a changed content of the buffer isn't noticed by the cached DDOP
       void setDesignator( const char* );
       const char* getDesignator() const {
         return m_designator;
@@ -86,11 +112,17 @@ namespace __IsoAgLib {
 
       void formatHeader( ByteStreamBuffer_c& byteStream ) const;
       virtual void formatBytestream( ByteStreamBuffer_c& byteStream, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) const = 0;
-      virtual void calcChecksumAdd( DevicePool_c & ) const = 0;
-      void calcChecksumAddHeader( DevicePool_c & ) const;
+      virtual void formatStructure( StructureImage_c& ) const = 0;
+      void formatStructureHeader( StructureImage_c& ) const;
+
+      // to be called on every change of the serialized object
+      static void setChanged() { ++m_changeCounter; }
 
     private:
       static uint16_t m_objIdCounter;
+      // counts the changes of all device objects, so DevicePool_c
+      // knows whether its cached bytestreams are still up to date
+      static uint32_t m_changeCounter;
       friend class DevicePool_c;
   };
 
@@ -132,7 +164,7 @@ namespace __IsoAgLib {
 
       uint32_t getSize( const IsoAgLib::ProcData::ConnectionCapabilities_s& ) const;
       void formatBytestream( ByteStreamBuffer_c& byteStream, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) const;
-      void calcChecksumAdd( DevicePool_c & ) const;
+      void formatStructure( StructureImage_c& ) const;
   };
 
 
@@ -152,7 +184,7 @@ namespace __IsoAgLib {
     private:
       uint32_t getSize( const IsoAgLib::ProcData::ConnectionCapabilities_s& ) const;
       void formatBytestream( ByteStreamBuffer_c& byteStream, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) const;
-      void calcChecksumAdd( DevicePool_c & ) const;
+      void formatStructure( StructureImage_c& ) const;
 
       size_t numberOfChildren() const {
         return m_childList.size();
@@ -197,7 +229,7 @@ namespace __IsoAgLib {
     private:
       uint32_t getSize( const IsoAgLib::ProcData::ConnectionCapabilities_s& ) const;
       void formatBytestream( ByteStreamBuffer_c& byteStream, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) const;
-      void calcChecksumAdd( DevicePool_c & ) const;
+      void formatStructure( StructureImage_c& ) const;
 
       uint16_t m_ddi;
       uint8_t m_properties;
@@ -222,7 +254,7 @@ namespace __IsoAgLib {
     private:
       uint32_t getSize( const IsoAgLib::ProcData::ConnectionCapabilities_s& ) const;
       void formatBytestream( ByteStreamBuffer_c& byteStream, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) const;
-      void calcChecksumAdd( DevicePool_c & ) const;
+      void formatStructure( StructureImage_c& ) const;
 
       uint16_t m_ddi;
       int32_t m_value;
@@ -238,12 +270,15 @@ namespace __IsoAgLib {
 
       void setOffset( int32_t offset ) {
         m_offset = offset;
+        setChanged();
       }
       void setDecimals( uint8_t decimals ) {
         m_decimals = decimals;
+        setChanged();
       }
       void setScale( float scale ) {
         m_scale = scale;
+        setChanged();
       }
 
       void setUnitDesignator( const char* desig ) {
@@ -263,7 +298,7 @@ namespace __IsoAgLib {
     private:
       uint32_t getSize( const IsoAgLib::ProcData::ConnectionCapabilities_s& ) const;
       void formatBytestream( ByteStreamBuffer_c& byteStream, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps ) const;
-      void calcChecksumAdd( DevicePool_c & ) const;
+      void formatStructure( StructureImage_c& ) const;
 
       int32_t m_offset;
       float m_scale;
@@ -287,12 +322,13 @@ namespace __IsoAgLib {
       virtual void calcChecksumStart() = 0;
       virtual void calcChecksumAdd( uint8_t ) = 0;
       virtual void calcChecksumEnd() = 0;
+      // the whole structure image is passed at once, override for a bulk checksum algorithm
+      virtual void calcChecksumAdd( const uint8_t* bp, size_t len );
 
       void calcChecksum();
 
       void calcChecksumAdd( uint16_t val );
       void calcChecksumAdd( uint32_t val );
-      void calcChecksumAdd( const uint8_t* bp, size_t len );
       void calcChecksumAdd( const char* str );
       void calcChecksumAdd( int32_t val );
       void calcChecksumAdd( float val );
@@ -322,13 +358,32 @@ namespace __IsoAgLib {
       DeviceObject_c* getObject( const uint16_t objId, const IsoAgLib::ProcData::DeviceObjectType_t ) const;
 
       ByteStreamBuffer_c getBytestream( uint8_t cmdByte, const IsoAgLib::ProcData::ConnectionCapabilities_s& caps );
-      uint32_t getBytestreamSize( const IsoAgLib::ProcData::ConnectionCapabilities_s& ) const;
+
+      /* The bytestream of all objects but the DVC is cached for both peer
+         control variants (the only capability which affects these objects).
+         The DVC is formatted on each request, as it depends on the version,
+         the localization and the WSM's NAME. */
+      const STL_NAMESPACE::vector<uint8_t>& getCachedBytestream( const IsoAgLib::ProcData::ConnectionCapabilities_s& caps );
+      const StructureImage_c& getStructureImage();
+      void invalidateCache();
 
       typedef STL_NAMESPACE::list<ProcData_c*> ProcDataList_t;
       ProcDataList_t &getProcDataList() { return *reinterpret_cast<ProcDataList_t*>( &m_procDatas ); }
 
       typedef STL_NAMESPACE::map<uint16_t, DeviceObject_c*> deviceMap_t;
       deviceMap_t m_devicePool;
+
+      struct CachedBytestream_s {
+        CachedBytestream_s() : bytes(), valid( false ), changeCounter( 0 ) {}
+        STL_NAMESPACE::vector<uint8_t> bytes;
+        bool valid;
+        uint32_t changeCounter;
+      };
+      CachedBytestream_s m_cachedBytestream[ 2 ]; // without / with peer control
+
+      StructureImage_c m_structureImage;
+      bool m_structureImageValid;
+      uint32_t m_structureImageChangeCounter;
   };
 
 }
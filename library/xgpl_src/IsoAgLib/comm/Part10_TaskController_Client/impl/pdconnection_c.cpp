@@ -128,22 +128,22 @@ namespace __IsoAgLib {
 
   void PdConnection_c::createMeasureProgs()
   {
+    m_connectedPds.reserve( uint32_t( m_pool->getPdList().size() ) );
+
     for( PdPool_c::PdBases_t::const_iterator i = m_pool->getPdList().begin(); i != m_pool->getPdList().end(); ++i )
     {
       PdBase_c* pd = ( *i );
-      const uint32_t key = getMapKey( pd->DDI(), pd->element());
-      isoaglib_assert( m_connectedPds.find( key ) == m_connectedPds.end() );
+      isoaglib_assert( m_connectedPds.find( pd->DDI(), pd->element() ) == NULL );
 
-      ConnectedPd_c* cPd = &( pd->createConnectedPd( *this ) );
-      m_connectedPds[ key ] = cPd;
+      m_connectedPds.insert( pd->DDI(), pd->element(), pd->createConnectedPd( *this ) );
     }
   }
 
 
   void PdConnection_c::destroyMeasureProgs()
   {
-    for( ConnectedPdMap_t::iterator i = m_connectedPds.begin(); i != m_connectedPds.end(); ++i )
-      delete i->second;
+    for( uint32_t i = 0; i < m_connectedPds.numSlots(); ++i )
+      delete m_connectedPds.slot( i );
     
     m_connectedPds.clear();
   }
@@ -271,13 +271,12 @@ namespace __IsoAgLib {
 
 
   void PdConnection_c::processRequestMsg( const ProcessPkg_c& data ) {
-    const uint32_t key = getMapKey( data.mui16_DDI, data.mui16_element );
-    ConnectedPdMap_t::iterator iter = m_connectedPds.find(key);
+    ConnectedPd_c* cPd = m_connectedPds.find( data.mui16_DDI, data.mui16_element );
 
     const bool wasBroadcast = ( data.getMonitorItemForDA() == NULL );
 
-    if ( iter != m_connectedPds.end())
-      iter->second->handleRequest();
+    if( cPd )
+      cPd->handleRequest();
     else
       sendNackNotFound( data.mui16_DDI, data.mui16_element, IsoAgLib::ProcData::RequestValue, wasBroadcast );
   }
@@ -285,27 +284,25 @@ namespace __IsoAgLib {
 
   void PdConnection_c::processSetMsg( const ProcessPkg_c& data )
   {
-    const uint32_t key = getMapKey( data.mui16_DDI, data.mui16_element );
-    ConnectedPdMap_t::iterator iter = m_connectedPds.find(key);
+    ConnectedPd_c* cPd = m_connectedPds.find( data.mui16_DDI, data.mui16_element );
 
     const bool wasBroadcast = ( data.getMonitorItemForDA() == NULL );
 
-    if( iter != m_connectedPds.end() )
-      iter->second->handleIncoming( data.mi32_pdValue, wasBroadcast );
+    if( cPd )
+      cPd->handleIncoming( data.mi32_pdValue, wasBroadcast );
     else
       sendNackNotFound( data.mui16_DDI, data.mui16_element, IsoAgLib::ProcData::Value, wasBroadcast );
   }
 
 
   void PdConnection_c::processMeasurementMsg( const ProcessPkg_c& data ) {
-    const uint32_t key = getMapKey( data.mui16_DDI, data.mui16_element );
-    ConnectedPdMap_t::iterator iter = m_connectedPds.find(key);
+    ConnectedPd_c* found = m_connectedPds.find( data.mui16_DDI, data.mui16_element );
 
     const bool wasBroadcast = ( data.getMonitorItemForDA() == NULL );
 
-    if( iter != m_connectedPds.end() )
+    if( found )
     {
-      ConnectedPd_c &cPd = *( iter->second );
+      ConnectedPd_c &cPd = *found;
 
       // measurementCommand_t and CommandType_t are unified for all measurement types
       const bool measurementAccepted = cPd.startMeasurement( IsoAgLib::ProcData::MeasurementCommand_t( data.men_command ), data.mi32_pdValue );
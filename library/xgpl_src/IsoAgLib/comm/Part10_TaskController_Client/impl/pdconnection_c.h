@@ -25,7 +25,7 @@
 #endif
 #include <IsoAgLib/comm/Part5_NetworkManagement/impl/identitem_c.h>
 #include <IsoAgLib/comm/Part10_TaskController_Client/iprocdata.h>
-#include <map>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/connectedpdtable_c.h>
 
 
 namespace __IsoAgLib
@@ -94,11 +94,8 @@ namespace __IsoAgLib
     PdPool_c* m_pool;
     IsoAgLib::ProcData::ConnectionCapabilities_s m_capsConnection; // initialized along with server caps, or set to defaults.
 
-    // Measure progs presorted for DDIs
-    static uint32_t getMapKey(uint16_t ddi, uint16_t element) { return ( uint32_t( uint32_t( ddi ) << 16 ) ) | uint32_t(element); }
-
-    typedef STL_NAMESPACE::map<uint32_t, ConnectedPd_c*> ConnectedPdMap_t;
-    ConnectedPdMap_t m_connectedPds;
+    // Measure progs by (DDI, element), sized from the pool on start()
+    ConnectedPdTable_c m_connectedPds;
 
     IsoAgLib::ProcData::iNackHandler_c* m_nackHandler;
   };
@@ -0,0 +1,179 @@
+/*
+  condensedworkstate_c.cpp: packed section work states published
+    through the condensed work state process data
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "condensedworkstate_c.h"
+#include <IsoAgLib/scheduler/impl/scheduler_c.h>
+#include <IsoAgLib/util/iassert.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/iddidefinition.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/pdlocal_c.h>
+
+
+namespace __IsoAgLib {
+
+  CondensedWorkState_c::CondensedWorkState_c()
+    : SchedulerTask_c( CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_CYCLE_TIME, false )
+    , mui16_pending( 0 )
+    , mui8_nextCommit( 0 )
+    , mt_lastCycle( 0 )
+  {
+    for( unsigned i = 0; i < NumDdis; ++i )
+    {
+      marr_pd[ i ] = NULL;
+      marr_states[ i ] = 0xFFFFFFFFUL; // all sections not available
+    }
+  }
+
+
+  CondensedWorkState_c::~CondensedWorkState_c()
+  {
+    if( isRegistered() )
+      getSchedulerInstance().deregisterTask( *this );
+  }
+
+
+  void
+  CondensedWorkState_c::add( PdLocal_c& pd )
+  {
+    unsigned index = NumDdis;
+    if( ( pd.DDI() >= DDI_ACTUAL_CONDENSED_WORK_STATE_1_16 ) && ( pd.DDI() < DDI_ACTUAL_CONDENSED_WORK_STATE_1_16 + NumDdis ) )
+      index = pd.DDI() - DDI_ACTUAL_CONDENSED_WORK_STATE_1_16;
+    else if( ( pd.DDI() >= DDI_SETPOINT_CONDENSED_WORK_STATE_1_16 ) && ( pd.DDI() < DDI_SETPOINT_CONDENSED_WORK_STATE_1_16 + NumDdis ) )
+      index = pd.DDI() - DDI_SETPOINT_CONDENSED_WORK_STATE_1_16;
+
+    isoaglib_assert( index < NumDdis );
+    if( index >= NumDdis )
+      return;
+
+    isoaglib_assert( marr_pd[ index ] == NULL );
+    marr_pd[ index ] = &pd;
+
+    // publish the states set so far
+    mui16_pending |= uint16_t( 1u << index );
+    schedule();
+  }
+
+
+  void
+  CondensedWorkState_c::setState( uint16_t section, IsoAgLib::ProcData::WorkState_t state )
+  {
+    isoaglib_assert( section < MaxSections );
+    if( section >= MaxSections )
+      return;
+
+    const unsigned index = section / SectionsPerDdi;
+    const unsigned shift = 2 * ( section % SectionsPerDdi );
+    const uint32_t states = ( marr_states[ index ] & ~( 0x3UL << shift ) ) | ( uint32_t( state & 0x3 ) << shift );
+    if( states == marr_states[ index ] )
+      return;
+
+    marr_states[ index ] = states;
+    mui16_pending |= uint16_t( 1u << index );
+    schedule();
+  }
+
+
+  IsoAgLib::ProcData::WorkState_t
+  CondensedWorkState_c::getState( uint16_t section ) const
+  {
+    isoaglib_assert( section < MaxSections );
+    if( section >= MaxSections )
+      return IsoAgLib::ProcData::WorkStateNotAvailable;
+
+    return IsoAgLib::ProcData::WorkState_t( ( marr_states[ section / SectionsPerDdi ] >> ( 2 * ( section % SectionsPerDdi ) ) ) & 0x3 );
+  }
+
+
+  unsigned
+  CondensedWorkState_c::numPending() const
+  {
+    unsigned count = 0;
+    for( uint16_t pending = mui16_pending; pending != 0; pending &= uint16_t( pending - 1 ) )
+      ++count;
+    return count;
+  }
+
+
+  bool
+  CondensedWorkState_c::commit( unsigned index )
+  {
+    mui16_pending &= uint16_t( ~( 1u << index ) );
+
+    PdLocal_c* pd = marr_pd[ index ];
+    if( ( pd == NULL ) || ( uint32_t( pd->getMeasurement().getValue() ) == marr_states[ index ] ) )
+      return false; // changed back before it was committed
+
+    pd->getMeasurement().setMeasurementValue( *pd, int32_t( marr_states[ index ] ) );
+    return true;
+  }
+
+
+  void
+  CondensedWorkState_c::flush()
+  {
+    for( unsigned i = 0; i < NumDdis; ++i )
+    {
+      if( mui16_pending & ( 1u << i ) )
+        (void)commit( i );
+    }
+
+    if( isRegistered() )
+      getSchedulerInstance().deregisterTask( *this );
+  }
+
+
+  void
+  CondensedWorkState_c::timeEvent()
+  {
+    mt_lastCycle = System_c::getTime();
+
+    unsigned budget = CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_DDIS_PER_CYCLE;
+    for( unsigned n = 0; ( n < NumDdis ) && ( mui16_pending != 0 ) && ( budget > 0 ); ++n )
+    {
+      const unsigned index = ( mui8_nextCommit + n ) % NumDdis;
+      if( ( mui16_pending & ( 1u << index ) ) && commit( index ) )
+      {
+        --budget;
+        mui8_nextCommit = uint8_t( ( index + 1 ) % NumDdis );
+      }
+    }
+
+    if( mui16_pending == 0 )
+      getSchedulerInstance().deregisterTask( *this );
+    else
+      setNextTriggerTime( mt_lastCycle + CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_CYCLE_TIME );
+  }
+
+
+  void
+  CondensedWorkState_c::schedule()
+  {
+    if( isRegistered() )
+      return; // changes are coalesced until the next cycle
+
+    // keep the cycle time between two cycles, but otherwise
+    // commit in the next scheduler run after the changes
+    int32_t delay = int32_t( mt_lastCycle + CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_CYCLE_TIME - System_c::getTime() );
+    if( delay < 0 )
+      delay = 0;
+
+    getSchedulerInstance().registerTask( *this, delay );
+  }
+
+}
@@ -0,0 +1,86 @@
+/*
+  condensedworkstate_c.h: packed section work states published
+    through the condensed work state process data
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef CONDENSEDWORKSTATE_C_H
+#define CONDENSEDWORKSTATE_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/iprocdata.h>
+#include <IsoAgLib/scheduler/impl/schedulertask_c.h>
+
+
+namespace __IsoAgLib {
+
+class PdLocal_c;
+
+
+/** Work states of up to 256 sections, packed 2 bits each into the values
+    of the 16 (actual or setpoint) condensed work state DDIs.
+    Changing states only marks the affected DDIs, they're committed to the
+    process data together in the next scheduler cycle. Only DDIs whose
+    value really changed are committed, and not more than
+    CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_DDIS_PER_CYCLE per cycle, as each
+    one may send an on-change frame on every connection.
+  */
+class CondensedWorkState_c : public SchedulerTask_c
+{
+public:
+  enum { SectionsPerDdi = 16, NumDdis = 16, MaxSections = SectionsPerDdi * NumDdis };
+
+  CondensedWorkState_c();
+  virtual ~CondensedWorkState_c();
+
+  /** add the process data of one of the 16 condensed work state DDIs,
+      all need to be either the actual or the setpoint ones */
+  void add( PdLocal_c& pd );
+
+  /** @param section 0..255 (section 1..256 in the DDI naming) */
+  void setState( uint16_t section, IsoAgLib::ProcData::WorkState_t state );
+  IsoAgLib::ProcData::WorkState_t getState( uint16_t section ) const;
+
+  /** commit all changed states now, regardless of the budget */
+  void flush();
+
+  unsigned numPending() const;
+
+private:
+  virtual void timeEvent();
+
+  /** @return true if the DDI's value was changed */
+  bool commit( unsigned ddiIndex );
+  void schedule();
+
+private:
+  PdLocal_c* marr_pd[ NumDdis ];
+  uint32_t marr_states[ NumDdis ];
+  uint16_t mui16_pending; // bit per DDI with changed states
+  uint8_t mui8_nextCommit; // round robin among the pending DDIs
+  ecutime_t mt_lastCycle;
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  CondensedWorkState_c( const CondensedWorkState_c& );
+  /** not copyable : copy operator is only declared, never defined */
+  CondensedWorkState_c& operator=( const CondensedWorkState_c& );
+};
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+  measureengine_c.cpp: central scheduling of the time and distance
+    proportional measurement triggers of one TcClient_c
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "measureengine_c.h"
+#include <IsoAgLib/scheduler/impl/scheduler_c.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/measuresubprog_c.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/tcclient_c.h>
+
+
+namespace __IsoAgLib {
+
+  // the distance is polled at least that often, as the speed may change
+  static const int32_t sci32_maxDistPollPeriod = 500;
+  static const int32_t sci32_minDistPollPeriod = 10;
+  static const int32_t sci32_noSpeedPollPeriod = 500;
+
+
+  MeasureEngine_c::MeasureEngine_c( TcClient_c& tcClient )
+    : SchedulerTask_c( sci32_maxDistPollPeriod, false )
+    , m_tcClient( tcClient )
+    , m_timeTriggers()
+    , m_distTriggers()
+  {
+  }
+
+
+  void
+  MeasureEngine_c::update( MeasureTimeProp_c& trigger )
+  {
+    m_timeTriggers.update( trigger );
+    schedule( System_c::getTime(), false );
+  }
+
+
+  void
+  MeasureEngine_c::update( MeasureDistProp_c& trigger )
+  {
+    m_distTriggers.update( trigger );
+    schedule( System_c::getTime(), false );
+  }
+
+
+  void
+  MeasureEngine_c::remove( MeasureTimeProp_c& trigger )
+  {
+    m_timeTriggers.remove( trigger );
+    schedule( System_c::getTime(), false );
+  }
+
+
+  void
+  MeasureEngine_c::remove( MeasureDistProp_c& trigger )
+  {
+    m_distTriggers.remove( trigger );
+    schedule( System_c::getTime(), false );
+  }
+
+
+  void
+  MeasureEngine_c::timeEvent()
+  {
+    const ecutime_t now = System_c::getTime();
+
+    while( !m_timeTriggers.empty() && ( m_timeTriggers.top().mt_nextTime <= now ) )
+    {
+      MeasureTimeProp_c& trigger = m_timeTriggers.top();
+      trigger.fire( now );
+      m_timeTriggers.update( trigger );
+    }
+
+    if( !m_distTriggers.empty() )
+    {
+      const uint32_t distance = m_tcClient.getProvider()->provideDistance();
+      while( !m_distTriggers.empty() && ( int32_t( distance - m_distTriggers.top().mui32_nextDistance ) >= 0 ) )
+      {
+        MeasureDistProp_c& trigger = m_distTriggers.top();
+        trigger.fire( distance );
+        m_distTriggers.update( trigger );
+      }
+    }
+
+    schedule( now, true );
+  }
+
+
+  int32_t
+  MeasureEngine_c::timeToNextDistTrigger() const
+  {
+    const TcClient_c::Provider_c& provider = *m_tcClient.getProvider();
+    const int32_t ci32_restDistance = int32_t( m_distTriggers.top().mui32_nextDistance - provider.provideDistance() );
+    const uint16_t cui16_speed = provider.provideSpeed();
+
+    // zero or no speed
+    if( ( 0 == cui16_speed ) || ( cui16_speed > 0xFAFFu ) )
+      return sci32_noSpeedPollPeriod;
+
+    if( ci32_restDistance <= 0 )
+      return 0;
+
+    // distance (in mm) div speed (in mm/sec) => time in msec
+    const int32_t ci32_time = int32_t( ( int64_t( ci32_restDistance ) * 1000 ) / cui16_speed );
+    if( ci32_time < sci32_minDistPollPeriod )
+      return sci32_minDistPollPeriod;
+    return ( ci32_time > sci32_maxDistPollPeriod ) ? sci32_maxDistPollPeriod : ci32_time;
+  }
+
+
+  void
+  MeasureEngine_c::schedule( ecutime_t now, bool inTimeEvent )
+  {
+    if( m_timeTriggers.empty() && m_distTriggers.empty() )
+    {
+      if( isRegistered() )
+        getSchedulerInstance().deregisterTask( *this );
+      return;
+    }
+
+    int32_t delay = sci32_maxDistPollPeriod;
+    if( !m_distTriggers.empty() )
+      delay = timeToNextDistTrigger();
+
+    if( !m_timeTriggers.empty() )
+    {
+      const int32_t ci32_timeDelay = int32_t( m_timeTriggers.top().mt_nextTime - now );
+      if( m_distTriggers.empty() || ( ci32_timeDelay < delay ) )
+        delay = ci32_timeDelay;
+    }
+
+    if( delay < 0 )
+      delay = 0;
+
+    if( !isRegistered() )
+      getSchedulerInstance().registerTask( *this, delay );
+    else if( inTimeEvent || ( now + delay < getNextTriggerTime() ) )
+      setNextTriggerTime( now + delay );
+  }
+
+}
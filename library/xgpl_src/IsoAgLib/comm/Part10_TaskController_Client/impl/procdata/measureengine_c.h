@@ -0,0 +1,166 @@
+/*
+  measureengine_c.h: central scheduling of the time and distance
+    proportional measurement triggers of one TcClient_c
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef MEASUREENGINE_C_H
+#define MEASUREENGINE_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <IsoAgLib/scheduler/impl/schedulertask_c.h>
+#include <IsoAgLib/util/iassert.h>
+
+#include <vector>
+
+
+namespace __IsoAgLib {
+
+class TcClient_c;
+class MeasureTimeProp_c;
+class MeasureDistProp_c;
+
+
+/** Binary min-heap of measurement triggers. The triggers know their
+    position (mi_heapIndex, -1 if not in a heap), so they can be removed
+    or moved after a change of their key in O(log n).
+    TRIGGER_T::isDueBefore( const TRIGGER_T& ) defines the order.
+  */
+template <class TRIGGER_T>
+class MeasureTriggerHeap_c
+{
+public:
+  MeasureTriggerHeap_c() : m_heap() {}
+
+  bool empty() const { return m_heap.empty(); }
+  unsigned size() const { return unsigned( m_heap.size() ); }
+  TRIGGER_T& top() const { isoaglib_assert( !empty() ); return *m_heap[ 0 ]; }
+
+  /** insert the trigger or move it to its new place after its key changed */
+  void update( TRIGGER_T& trigger )
+  {
+    if( trigger.mi_heapIndex < 0 )
+    {
+      m_heap.push_back( &trigger );
+      trigger.mi_heapIndex = int( m_heap.size() ) - 1;
+    }
+    siftDown( siftUp( unsigned( trigger.mi_heapIndex ) ) );
+  }
+
+  void remove( TRIGGER_T& trigger )
+  {
+    if( trigger.mi_heapIndex < 0 )
+      return;
+
+    const unsigned pos = unsigned( trigger.mi_heapIndex );
+    trigger.mi_heapIndex = -1;
+
+    TRIGGER_T* last = m_heap.back();
+    m_heap.pop_back();
+    if( pos < m_heap.size() )
+    {
+      place( pos, last );
+      siftDown( siftUp( pos ) );
+    }
+  }
+
+private:
+  void place( unsigned pos, TRIGGER_T* trigger )
+  {
+    m_heap[ pos ] = trigger;
+    trigger->mi_heapIndex = int( pos );
+  }
+
+  unsigned siftUp( unsigned pos )
+  {
+    TRIGGER_T* trigger = m_heap[ pos ];
+    while( pos > 0 )
+    {
+      const unsigned parent = ( pos - 1 ) / 2;
+      if( !trigger->isDueBefore( *m_heap[ parent ] ) )
+        break;
+      place( pos, m_heap[ parent ] );
+      pos = parent;
+    }
+    place( pos, trigger );
+    return pos;
+  }
+
+  void siftDown( unsigned pos )
+  {
+    TRIGGER_T* trigger = m_heap[ pos ];
+    for( ;; )
+    {
+      unsigned child = 2 * pos + 1;
+      if( child >= m_heap.size() )
+        break;
+      if( ( child + 1 < m_heap.size() ) && m_heap[ child + 1 ]->isDueBefore( *m_heap[ child ] ) )
+        ++child;
+      if( !m_heap[ child ]->isDueBefore( *trigger ) )
+        break;
+      place( pos, m_heap[ child ] );
+      pos = child;
+    }
+    place( pos, trigger );
+  }
+
+  STL_NAMESPACE::vector<TRIGGER_T*> m_heap;
+};
+
+
+/** One scheduler task for all time and distance proportional measurements
+    of a TcClient_c instead of one per measurement. All triggers due are
+    fired in one pass, so their ProcessData messages are sent back-to-back.
+    The task is only registered while there are triggers.
+  */
+class MeasureEngine_c : public SchedulerTask_c
+{
+public:
+  MeasureEngine_c( TcClient_c& tcClient );
+  virtual ~MeasureEngine_c() {}
+
+  /** (re-)schedule the trigger after it was started */
+  void update( MeasureTimeProp_c& trigger );
+  void update( MeasureDistProp_c& trigger );
+
+  void remove( MeasureTimeProp_c& trigger );
+  void remove( MeasureDistProp_c& trigger );
+
+  unsigned numTimeTriggers() const { return m_timeTriggers.size(); }
+  unsigned numDistTriggers() const { return m_distTriggers.size(); }
+
+private:
+  virtual void timeEvent();
+
+  void schedule( ecutime_t now, bool inTimeEvent );
+  int32_t timeToNextDistTrigger() const;
+
+private:
+  TcClient_c& m_tcClient;
+  MeasureTriggerHeap_c<MeasureTimeProp_c> m_timeTriggers; // ordered by time
+  MeasureTriggerHeap_c<MeasureDistProp_c> m_distTriggers; // ordered by distance
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  MeasureEngine_c( const MeasureEngine_c& );
+  /** not copyable : copy operator is only declared, never defined */
+  MeasureEngine_c& operator=( const MeasureEngine_c& );
+};
+
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include "measurement_c.h"
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/measureprog_c.h>
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/pdbase_c.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/pdlogger_c.h>
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/tcclientconnection_c.h>
 
 
@@ -27,6 +28,8 @@ namespace __IsoAgLib {
 
   Measurement_c::Measurement_c()
     : m_value( 0 )
+    , m_logger( NULL )
+    , m_logChannel( 0 )
   {
   }
 
@@ -35,6 +38,9 @@ namespace __IsoAgLib {
   {
     m_value = v;
 
+    if( m_logger )
+      m_logger->log( m_logChannel, v );
+
     for( PdBase_c::ConnectedPds_t::iterator iter = pdBase.connectedPds().begin(); iter != pdBase.connectedPds().end(); ++iter )
       static_cast< MeasureProg_c *>( *iter )->valueUpdated();
   }
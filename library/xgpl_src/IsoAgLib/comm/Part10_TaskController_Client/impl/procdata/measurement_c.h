@@ -29,6 +29,7 @@ namespace __IsoAgLib
   class PdBase_c;
   class PdConnection_c;
   class ConnectedPd_c;
+  class PdLogger_c;
 
   class Measurement_c
   {
@@ -40,8 +41,12 @@ namespace __IsoAgLib
       void setMeasurementValue( PdBase_c &, int32_t );
       void startMeasurement( PdBase_c &, PdConnection_c&, IsoAgLib::ProcData::MeasurementCommand_t, int32_t );
 
+      void setLogger( PdLogger_c *logger, uint16_t channel ) { m_logger = logger; m_logChannel = channel; }
+
     private:
       int32_t m_value;
+      PdLogger_c *m_logger;
+      uint16_t m_logChannel;
   };
 
 }
@@ -18,7 +18,6 @@
   file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
 */
 #include "measuresubprog_c.h"
-#include <IsoAgLib/scheduler/impl/scheduler_c.h>
 #include <IsoAgLib/util/impl/util_funcs.h>
 #include <IsoAgLib/util/iassert.h>
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/procdata_c.h>
@@ -36,21 +35,19 @@ namespace __IsoAgLib {
 
 
 MeasureDistProp_c::MeasureDistProp_c( MeasureProg_c& measureProg )
-  : SchedulerTask_c( 50, false )
-  , m_measureProg( measureProg )
-  , mui32_lastDistance( 0 )
+  : m_measureProg( measureProg )
+  , mui32_nextDistance( 0 )
   , mi32_increment( 0 )
+  , mi_heapIndex( -1 )
 {
   // If Distance-measurement is used there needs to be Provider registered!
   isoaglib_assert( getTcClientInstance( m_measureProg.connection().getMultitonInst() ).getProvider() );
-
-  getSchedulerInstance().registerTask( *this, 0 );
 }
 
 
 MeasureDistProp_c::~MeasureDistProp_c()
 {
-  getSchedulerInstance().deregisterTask( *this );
+  getTcClientInstance( m_measureProg.connection().getMultitonInst() ).measureEngine().remove( *this );
 }
 
 
@@ -58,69 +55,22 @@ void
 MeasureDistProp_c::start( uint32_t currentDistance, int32_t ai32_increment )
 {
   mi32_increment = ai32_increment;
-  mui32_lastDistance = currentDistance;
+  mui32_nextDistance = currentDistance + uint32_t( ai32_increment );
+  getTcClientInstance( m_measureProg.connection().getMultitonInst() ).measureEngine().update( *this );
 
   if( m_measureProg.minMaxLimitsPassed() )
     m_measureProg.sendValue();
 }
 
 
-bool
-MeasureDistProp_c::updateTrigger( uint32_t currentDistance )
+void
+MeasureDistProp_c::fire( uint32_t currentDistance )
 {
   // Distance should always be a monotone increasing function.
   // If not, well, we'll just send out the value. Doesn't matter too much.
-  if( int32_t( currentDistance - mui32_lastDistance ) >= mi32_increment )
-  {
-    mui32_lastDistance = currentDistance;
-    return true;
-  }
-  else
-  {
-    return false;
-  }
-}
-
-
-int32_t
-MeasureDistProp_c::nextTriggerTime( uint32_t distance )
-{
-  const int32_t multitonInst = m_measureProg.connection().getMultitonInst();
-  const int32_t ci32_restDistance = mui32_lastDistance - distance + mi32_increment;
-  const uint16_t cui16_speed = getTcClientInstance( multitonInst ).getProvider()->provideSpeed();
-
-  // zero or no speed
-  if( ( 0 == cui16_speed ) || ( cui16_speed > 0xFAFFu ) )
-    return 500;
-
-  if (ci32_restDistance < 0)
-    return 100;
-
-  int32_t i32_nextTriggerTime = (ci32_restDistance * 1000 ) / cui16_speed; // distance in mm, div speed in mm/sec, result in msec
-
-  if (i32_nextTriggerTime > 500)
-  {
-    i32_nextTriggerTime = 500;
-  }
-
-  return i32_nextTriggerTime;  // distance (in mm) div speed (in mm/sec) => time in msec
-}
-
-
-void MeasureDistProp_c::timeEvent()
-{
-  const int32_t multitonInst = m_measureProg.connection().getMultitonInst();
-  const uint32_t distance = getTcClientInstance( multitonInst ).getProvider()->provideDistance();
-  
-  const bool sendProcMsg = updateTrigger( distance );
-  const int32_t nextTimePeriod = nextTriggerTime( distance );
-
-  if( nextTimePeriod > 0 )
-    setPeriod( nextTimePeriod, false );
-  else
-    setPeriod( 10, false ); // fallback, TODO later...
+  mui32_nextDistance = currentDistance + uint32_t( mi32_increment );
 
-  if( sendProcMsg && m_measureProg.minMaxLimitsPassed() )
+  if( m_measureProg.minMaxLimitsPassed() )
     m_measureProg.sendValue();
 }
 
@@ -131,18 +81,17 @@ void MeasureDistProp_c::timeEvent()
 
 
 MeasureTimeProp_c::MeasureTimeProp_c( MeasureProg_c& measureProg )
-  : SchedulerTask_c( 50, false )
-  , m_measureProg( measureProg )
-  , mt_lastTime( 0 )
+  : m_measureProg( measureProg )
+  , mt_nextTime( 0 )
   , mi32_increment( 0 )
+  , mi_heapIndex( -1 )
 {
-  getSchedulerInstance().registerTask( *this, 0 );
 }
 
 
 MeasureTimeProp_c::~MeasureTimeProp_c()
 {
-  getSchedulerInstance().deregisterTask( *this );
+  getTcClientInstance( m_measureProg.connection().getMultitonInst() ).measureEngine().remove( *this );
 }
 
 
@@ -150,49 +99,20 @@ void
 MeasureTimeProp_c::start( ecutime_t currentTime, int32_t ai32_increment )
 {
   mi32_increment = ai32_increment;
-  mt_lastTime = currentTime;
-
-  setPeriod( ai32_increment, true );
+  mt_nextTime = currentTime + ai32_increment;
+  getTcClientInstance( m_measureProg.connection().getMultitonInst() ).measureEngine().update( *this );
 
   if( m_measureProg.minMaxLimitsPassed() )
     m_measureProg.sendValue();
 }
 
 
-bool
-MeasureTimeProp_c::updateTrigger( ecutime_t currentTime )
-{
-  if( int32_t( currentTime - mt_lastTime ) >= mi32_increment )
-  {
-    mt_lastTime = currentTime;
-    return true;
-  }
-  else
-  {
-    return false;
-  }
-}
-
-
-int32_t
-MeasureTimeProp_c::nextTriggerTime( ecutime_t currentTime )
-{
-  return int32_t(mt_lastTime - currentTime + mi32_increment );
-}
-
-
-void MeasureTimeProp_c::timeEvent()
+void
+MeasureTimeProp_c::fire( ecutime_t currentTime )
 {
-  const ecutime_t now = System_c::getTime();
-  const bool sendProcMsg = updateTrigger( now );
-  const int32_t nextTimePeriod = nextTriggerTime( now );
-
-  if( nextTimePeriod > 0 )
-    setPeriod( nextTimePeriod, false );
-  else
-    setPeriod( 10, false ); // fallback, TODO later...
+  mt_nextTime = currentTime + mi32_increment;
 
-  if( sendProcMsg && m_measureProg.minMaxLimitsPassed() )
+  if( m_measureProg.minMaxLimitsPassed() )
     m_measureProg.sendValue();
 }
 
@@ -22,7 +22,7 @@
 
 #include <IsoAgLib/isoaglib_config.h>
 #include <IsoAgLib/comm/Part10_TaskController_Client/iprocdata.h>
-#include <IsoAgLib/scheduler/impl/schedulertask_c.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/measureengine_c.h>
 
 
 namespace __IsoAgLib {
@@ -30,51 +30,57 @@ namespace __IsoAgLib {
 class ProcData_c;
 class MeasureProg_c;
 
-class MeasureDistProp_c : public SchedulerTask_c 
+class MeasureDistProp_c
 {
 private: // non-copyable
   MeasureDistProp_c( const MeasureDistProp_c& );
 
 public:
   MeasureDistProp_c( MeasureProg_c& measureProg );
-  virtual ~MeasureDistProp_c();
+  ~MeasureDistProp_c();
 
   void start( uint32_t currentDistance, int32_t ai32_increment );
 
+  bool isDueBefore( const MeasureDistProp_c& other ) const { return int32_t( mui32_nextDistance - other.mui32_nextDistance ) < 0; }
+
 private:
-  bool updateTrigger( uint32_t );
-  int32_t nextTriggerTime( uint32_t );
+  friend class MeasureEngine_c;
+  friend class MeasureTriggerHeap_c<MeasureDistProp_c>;
 
-  virtual void timeEvent();
+  void fire( uint32_t currentDistance );
 
 private:
   MeasureProg_c &m_measureProg;
-  uint32_t mui32_lastDistance;
+  uint32_t mui32_nextDistance;
   int32_t mi32_increment;
+  int mi_heapIndex;
 };
 
 
-class MeasureTimeProp_c : public SchedulerTask_c 
+class MeasureTimeProp_c
 {
 private: // non-copyable
   MeasureTimeProp_c( const MeasureTimeProp_c& );
 
 public:
   MeasureTimeProp_c( MeasureProg_c& measureProg );
-  virtual ~MeasureTimeProp_c();
+  ~MeasureTimeProp_c();
 
   void start( ecutime_t currentTime, int32_t ai32_increment );
 
+  bool isDueBefore( const MeasureTimeProp_c& other ) const { return mt_nextTime < other.mt_nextTime; }
+
 private:
-  bool updateTrigger( ecutime_t );
-  int32_t nextTriggerTime( ecutime_t );
+  friend class MeasureEngine_c;
+  friend class MeasureTriggerHeap_c<MeasureTimeProp_c>;
 
-  virtual void timeEvent();
+  void fire( ecutime_t currentTime );
 
 private:
   MeasureProg_c &m_measureProg;
-  ecutime_t mt_lastTime;
+  ecutime_t mt_nextTime;
   int32_t mi32_increment;
+  int mi_heapIndex;
 };
 
 
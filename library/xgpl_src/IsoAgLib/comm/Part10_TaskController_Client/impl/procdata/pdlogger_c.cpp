@@ -0,0 +1,257 @@
+/*
+  pdlogger_c.cpp: binary time-series log of the values of local
+    process data
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "pdlogger_c.h"
+#include <IsoAgLib/scheduler/impl/scheduler_c.h>
+#include <IsoAgLib/util/iassert.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/pdlocal_c.h>
+#include <supplementary_driver/driver/datastreams/streamoutput_c.h>
+
+
+namespace __IsoAgLib {
+
+  static const uint8_t scui8_version = 1;
+  static const uint8_t scui8_blockDictionary = 'D';
+  static const uint8_t scui8_blockSamples = 'S';
+
+
+  PdLogger_c::PdLogger_c()
+    : SchedulerTask_c( CONFIG_TC_CLIENT_PD_LOGGER_FLUSH_PERIOD, false )
+    , mpc_stream( NULL )
+    , mvec_channels()
+    , mvec_samples()
+    , mvec_block()
+    , mui_channelsWritten( 0 )
+    , mui32_written( 0 )
+    , mui32_dropped( 0 )
+  {
+  }
+
+
+  PdLogger_c::~PdLogger_c()
+  {
+    close();
+    clear();
+  }
+
+
+  void
+  PdLogger_c::open( StreamOutput_c& stream )
+  {
+    close();
+
+    mpc_stream = &stream;
+    mui_channelsWritten = 0;
+    mvec_samples.reserve( CONFIG_TC_CLIENT_PD_LOGGER_BUFFER_SAMPLES );
+
+    static const uint8_t scarr_header[] = { 'P', 'D', 'L', 'G', scui8_version };
+    for( unsigned i = 0; i < sizeof( scarr_header ); ++i )
+      mpc_stream->put( scarr_header[ i ] );
+  }
+
+
+  void
+  PdLogger_c::close()
+  {
+    if( !isOpen() )
+      return;
+
+    flush();
+    mpc_stream = NULL;
+  }
+
+
+  void
+  PdLogger_c::add( PdLocal_c& pd )
+  {
+    isoaglib_assert( mvec_channels.size() + 2 <= 0xFFFFu );
+
+    Channel_s channel;
+    channel.pd = &pd;
+    channel.lastValue = 0;
+    channel.inBlock = false;
+
+    channel.kind = KindMeasurement;
+    pd.getMeasurement().setLogger( this, uint16_t( mvec_channels.size() ) );
+    mvec_channels.push_back( channel );
+
+    if( pd.getSetpoint().isSettable() )
+    {
+      channel.kind = KindSetpoint;
+      pd.getSetpoint().setLogger( this, uint16_t( mvec_channels.size() ) );
+      mvec_channels.push_back( channel );
+    }
+  }
+
+
+  void
+  PdLogger_c::clear()
+  {
+    for( STL_NAMESPACE::vector<Channel_s>::iterator iter = mvec_channels.begin(); iter != mvec_channels.end(); ++iter )
+    {
+      if( iter->kind == KindMeasurement )
+        iter->pd->getMeasurement().setLogger( NULL, 0 );
+      else
+        iter->pd->getSetpoint().setLogger( NULL, 0 );
+    }
+
+    mvec_channels.clear();
+    mvec_samples.clear();
+    mui_channelsWritten = 0;
+
+    if( isRegistered() )
+      getSchedulerInstance().deregisterTask( *this );
+  }
+
+
+  void
+  PdLogger_c::log( uint16_t channel, int32_t value )
+  {
+    isoaglib_assert( channel < mvec_channels.size() );
+
+    if( !isOpen() )
+      return;
+
+    Sample_s sample;
+    sample.time = System_c::getTime();
+    sample.value = value;
+    sample.channel = channel;
+    mvec_samples.push_back( sample );
+
+    if( mvec_samples.size() >= CONFIG_TC_CLIENT_PD_LOGGER_BUFFER_SAMPLES )
+      flush();
+    else if( !isRegistered() )
+      getSchedulerInstance().registerTask( *this, CONFIG_TC_CLIENT_PD_LOGGER_FLUSH_PERIOD );
+  }
+
+
+  void
+  PdLogger_c::flush()
+  {
+    if( isRegistered() )
+      getSchedulerInstance().deregisterTask( *this );
+
+    if( !isOpen() || mvec_samples.empty() )
+      return;
+
+    if( !mpc_stream->good() )
+    {
+      mui32_dropped += uint32_t( mvec_samples.size() );
+      mvec_samples.clear();
+      return;
+    }
+
+    if( mui_channelsWritten < mvec_channels.size() )
+    {
+      encodeDictionary();
+      writeBlock( scui8_blockDictionary );
+      mui_channelsWritten = unsigned( mvec_channels.size() );
+    }
+
+    encodeSamples();
+    writeBlock( scui8_blockSamples );
+
+    if( mpc_stream->fail() )
+      mui32_dropped += uint32_t( mvec_samples.size() );
+    else
+      mui32_written += uint32_t( mvec_samples.size() );
+    mvec_samples.clear();
+  }
+
+
+  void
+  PdLogger_c::timeEvent()
+  {
+    flush();
+  }
+
+
+  void
+  PdLogger_c::writeBlock( uint8_t type )
+  {
+    mpc_stream->put( type );
+
+    uint32_t length = uint32_t( mvec_block.size() );
+    while( length >= 0x80 )
+    {
+      mpc_stream->put( uint8_t( length | 0x80 ) );
+      length >>= 7;
+    }
+    mpc_stream->put( uint8_t( length ) );
+
+    for( STL_NAMESPACE::vector<uint8_t>::const_iterator iter = mvec_block.begin(); iter != mvec_block.end(); ++iter )
+      mpc_stream->put( *iter );
+  }
+
+
+  void
+  PdLogger_c::encodeDictionary()
+  {
+    mvec_block.clear();
+    putVarint( mvec_channels.size() - mui_channelsWritten );
+    for( unsigned i = mui_channelsWritten; i < mvec_channels.size(); ++i )
+    {
+      putVarint( i );
+      putUint16( mvec_channels[ i ].pd->DDI() );
+      putUint16( mvec_channels[ i ].pd->element() );
+      mvec_block.push_back( mvec_channels[ i ].kind );
+    }
+  }
+
+
+  void
+  PdLogger_c::encodeSamples()
+  {
+    mvec_block.clear();
+    putVarint( mvec_samples.size() );
+    putSvarint( mvec_samples.front().time );
+
+    for( STL_NAMESPACE::vector<Sample_s>::const_iterator iter = mvec_samples.begin(); iter != mvec_samples.end(); ++iter )
+      putVarint( iter->channel );
+
+    for( unsigned i = 1; i < mvec_samples.size(); ++i )
+      putSvarint( int64_t( mvec_samples[ i ].time - mvec_samples[ i - 1 ].time ) );
+
+    for( STL_NAMESPACE::vector<Sample_s>::const_iterator iter = mvec_samples.begin(); iter != mvec_samples.end(); ++iter )
+    {
+      Channel_s& channel = mvec_channels[ iter->channel ];
+      const int64_t previous = channel.inBlock ? channel.lastValue : 0;
+      putSvarint( int64_t( iter->value ) - previous );
+      channel.lastValue = iter->value;
+      channel.inBlock = true;
+    }
+
+    for( STL_NAMESPACE::vector<Sample_s>::const_iterator iter = mvec_samples.begin(); iter != mvec_samples.end(); ++iter )
+      mvec_channels[ iter->channel ].inBlock = false;
+  }
+
+
+  void
+  PdLogger_c::putVarint( uint64_t value )
+  {
+    while( value >= 0x80 )
+    {
+      mvec_block.push_back( uint8_t( value | 0x80 ) );
+      value >>= 7;
+    }
+    mvec_block.push_back( uint8_t( value ) );
+  }
+
+}
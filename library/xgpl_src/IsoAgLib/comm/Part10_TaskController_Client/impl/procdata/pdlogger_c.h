@@ -0,0 +1,140 @@
+/*
+  pdlogger_c.h: binary time-series log of the values of local
+    process data
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef PDLOGGER_C_H
+#define PDLOGGER_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <IsoAgLib/scheduler/impl/schedulertask_c.h>
+
+#include <vector>
+
+class StreamOutput_c;
+
+
+namespace __IsoAgLib {
+
+class PdLocal_c;
+
+
+/** Logs every measurement value set and every setpoint received of the
+    added process data, whether a TC is connected or not.
+    The samples are buffered in RAM (CONFIG_TC_CLIENT_PD_LOGGER_BUFFER_SAMPLES)
+    and written as one block when the buffer is full, on flush() or at
+    the latest CONFIG_TC_CLIENT_PD_LOGGER_FLUSH_PERIOD after the first
+    buffered sample.
+
+    Format (all multi byte values little endian, "varint" is an unsigned
+    LEB128 number, "svarint" a zigzag encoded signed varint):
+      file   := "PDLG" version(uint8 = 1) block*
+      block  := type(uint8) length(varint) payload[length]
+      'D' dictionary payload := count(varint)
+            { channel(varint) DDI(uint16) element(uint16) kind(uint8) }*count
+          kind: 0 = measurement value, 1 = setpoint value
+      'S' samples payload := count(varint) firstTime(svarint, msec)
+            channels: { channel(varint) }*count
+            times:    { delta to the previous sample's time (svarint) }*(count-1)
+            values:   { delta to the channel's previous value in this block,
+                        the first one of a channel to 0 (svarint) }*count
+    Unknown block types can be skipped by their length. A channel is always
+    defined by a dictionary block before its first samples block, a later
+    dictionary block may define it anew (after clear()).
+    Setpoint channels are only created for settable process data.
+  */
+class PdLogger_c : public SchedulerTask_c
+{
+public:
+  enum Kind_t { KindMeasurement = 0, KindSetpoint = 1 };
+
+  PdLogger_c();
+  virtual ~PdLogger_c();
+
+  /** start logging to the stream, which has to stay valid until close()
+      The file header is written immediately, the dictionary of the
+      channels with the first samples block. */
+  void open( StreamOutput_c& stream );
+
+  /** flush the buffered samples and stop writing to the stream,
+      the channels stay added for the next open() */
+  void close();
+
+  bool isOpen() const { return mpc_stream != NULL; }
+
+  /** log the measurement values and the setpoints of the process data */
+  void add( PdLocal_c& pd );
+
+  /** stop logging of all process data, the buffered samples are dropped */
+  void clear();
+
+  /** called by Measurement_c and Setpoint_c on every value */
+  void log( uint16_t channel, int32_t value );
+
+  /** write the buffered samples to the stream now */
+  void flush();
+
+  unsigned numChannels() const { return unsigned( mvec_channels.size() ); }
+  unsigned numBuffered() const { return unsigned( mvec_samples.size() ); }
+  uint32_t numWritten() const { return mui32_written; }
+  //! samples which couldn't be written as the stream failed
+  uint32_t numDropped() const { return mui32_dropped; }
+
+private:
+  virtual void timeEvent();
+
+  void writeBlock( uint8_t type );
+  void encodeDictionary();
+  void encodeSamples();
+
+  void putVarint( uint64_t value );
+  void putSvarint( int64_t value ) { putVarint( ( uint64_t( value ) << 1 ) ^ uint64_t( value >> 63 ) ); }
+  void putUint16( uint16_t value ) { mvec_block.push_back( uint8_t( value ) ); mvec_block.push_back( uint8_t( value >> 8 ) ); }
+
+private:
+  struct Channel_s {
+    PdLocal_c* pd;
+    uint8_t kind;
+    int32_t lastValue; // while encoding a block
+    bool inBlock;
+  };
+
+  struct Sample_s {
+    ecutime_t time;
+    int32_t value;
+    uint16_t channel;
+  };
+
+  StreamOutput_c* mpc_stream;
+  STL_NAMESPACE::vector<Channel_s> mvec_channels;
+  STL_NAMESPACE::vector<Sample_s> mvec_samples;
+  STL_NAMESPACE::vector<uint8_t> mvec_block; // payload being encoded
+  unsigned mui_channelsWritten; // to the dictionary of the current stream
+  uint32_t mui32_written;
+  uint32_t mui32_dropped;
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  PdLogger_c( const PdLogger_c& );
+  /** not copyable : copy operator is only declared, never defined */
+  PdLogger_c& operator=( const PdLogger_c& );
+};
+
+}
+
+#endif
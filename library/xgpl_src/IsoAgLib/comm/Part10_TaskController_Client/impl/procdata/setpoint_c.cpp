@@ -20,6 +20,7 @@
 #include "setpoint_c.h"
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/pdconnection_c.h>
 #include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/pdbase_c.h>
+#include <IsoAgLib/comm/Part10_TaskController_Client/impl/procdata/pdlogger_c.h>
 
 
 namespace __IsoAgLib {
@@ -29,6 +30,8 @@ namespace __IsoAgLib {
     : m_value( 0 )
     , m_handler( NULL )
     , m_settable( false )
+    , m_logger( NULL )
+    , m_logChannel( 0 )
   {
   }
 
@@ -37,6 +40,8 @@ namespace __IsoAgLib {
     : m_value( 0 )
     , m_handler( handler )
     , m_settable( settable )
+    , m_logger( NULL )
+    , m_logChannel( 0 )
   {
   }
 
@@ -47,6 +52,9 @@ namespace __IsoAgLib {
     const bool b_change = ( m_value != value );
     m_value = value;
 
+    if( m_logger )
+      m_logger->log( m_logChannel, value );
+
     if( m_handler )
       m_handler->_processSetpointSet( pd, value, b_change );
   }
@@ -25,6 +25,7 @@
 namespace __IsoAgLib
 {
   class PdLocal_c;
+  class PdLogger_c;
 
   
   class SetpointHandler_c
@@ -49,12 +50,17 @@ namespace __IsoAgLib
 
     void processMsg( PdLocal_c &, int32_t pdValue );
 
+    void setLogger( PdLogger_c *logger, uint16_t channel ) { m_logger = logger; m_logChannel = channel; }
+
   private:
     int32_t m_value;
 
     SetpointHandler_c *m_handler;
     bool m_settable;
 
+    PdLogger_c *m_logger;
+    uint16_t m_logChannel;
+
     // not copyable
     Setpoint_c( const Setpoint_c& );
     Setpoint_c& operator=( const Setpoint_c& );
@@ -48,12 +48,14 @@ namespace __IsoAgLib {
       m_pdMessageHandler( NULL ),
 #endif
       m_provider( NULL )
+    , m_measureEngine( *this )
     , m_handler( *this )
     , m_customer( *this )
     , m_clientInfo()
     , m_peerConnections()
     , m_pdRemoteNodes()
   {
+    clearRemoteNodesBySa();
   }
 
 
@@ -81,6 +83,7 @@ namespace __IsoAgLib {
     for (ItemToRemoteNodeMap_t::iterator iter = m_pdRemoteNodes.begin(); iter != m_pdRemoteNodes.end(); ++iter)
       delete *iter;
     m_pdRemoteNodes.clear();
+    clearRemoteNodesBySa();
 
 #if defined(HAL_USE_SPECIFIC_FILTERS) && !defined(USE_DIRECT_PD_HANDLING)
     getIsoBusInstance4Comm().deleteFilter( m_customer, IsoAgLib::iMaskFilter_c( ( 0x3FFFF00UL ), ( PROCESS_DATA_PGN | 0xFF ) << 8 ) );
@@ -289,7 +292,7 @@ namespace __IsoAgLib {
             pkg.mi32_pdValue);
 #endif
 
-    PdRemoteNode_c *node = findRemoteNode( *pkg.getMonitorItemForSA() );
+    PdRemoteNode_c *node = findRemoteNodeBySa( *pkg.getMonitorItemForSA() );
     if( node )
       node->processMsg( pkg );
   }
@@ -341,6 +344,25 @@ namespace __IsoAgLib {
   }
 
 
+  PdRemoteNode_c *
+  TcClient_c::findRemoteNodeBySa( const IsoItem_c &item )
+  {
+    PdRemoteNode_c *&cached = marr_remoteNodeBySa[ item.nr() ];
+    if( ( cached == NULL ) || ( &cached->getIsoItem() != &item ) )
+      cached = findRemoteNode( item );
+
+    return cached;
+  }
+
+
+  void
+  TcClient_c::clearRemoteNodesBySa()
+  {
+    for( unsigned i = 0; i < 256; ++i )
+      marr_remoteNodeBySa[ i ] = NULL;
+  }
+
+
   void
   TcClient_c::proprietaryServer( const IsoItem_c &isoItem, bool available )
   {
@@ -408,6 +430,7 @@ namespace __IsoAgLib {
       }
 
       delete remoteNode;
+      clearRemoteNodesBySa();
     }
   }
 
@@ -434,6 +457,7 @@ namespace __IsoAgLib {
 
       delete *i;
       m_pdRemoteNodes.erase( i );
+      clearRemoteNodesBySa();
       break;
     }
   }
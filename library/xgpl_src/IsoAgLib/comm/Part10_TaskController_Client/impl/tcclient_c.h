@@ -21,6 +21,7 @@
 #define TCCLIENT_C_H
 
 #include "tcclientconnection_c.h"
+#include "procdata/measureengine_c.h"
 
 #include <IsoAgLib/isoaglib_config.h>
 #include <IsoAgLib/util/impl/util_funcs.h>
@@ -59,6 +60,8 @@ namespace __IsoAgLib {
       void setProvider( Provider_c * );
       Provider_c *getProvider() const;
 
+      MeasureEngine_c& measureEngine() { return m_measureEngine; }
+
       bool registerClient( IdentItem_c&, const IsoAgLib::ProcData::ClientCapabilities_s&, TcClientConnection_c::StateHandler_c& );
       bool deregisterClient( IdentItem_c& );
 
@@ -121,6 +124,8 @@ namespace __IsoAgLib {
       ServerInstance_c *findNextServerOfSameType( const ServerInstance_c &thisServer ) const;
 
       PdRemoteNode_c *findRemoteNode( const IsoItem_c & ) const;
+      PdRemoteNode_c *findRemoteNodeBySa( const IsoItem_c & );
+      void clearRemoteNodesBySa();
 
 
       /// PROXY-CLASSES
@@ -168,6 +173,7 @@ namespace __IsoAgLib {
 
     private:
       Provider_c *m_provider;
+      MeasureEngine_c m_measureEngine;
       Handler_t m_handler;
       Customer_t m_customer;
 
@@ -188,6 +194,10 @@ namespace __IsoAgLib {
       typedef STL_NAMESPACE::list<PdRemoteNode_c*> ItemToRemoteNodeMap_t;
       ItemToRemoteNodeMap_t m_pdRemoteNodes;
 
+      // direct lookup for incoming messages, filled from m_pdRemoteNodes on demand.
+      // Entries are checked against the IsoItem_c, as its SA may change.
+      PdRemoteNode_c* marr_remoteNodeBySa[ 256 ];
+
       friend TcClient_c &getTcClientInstance( unsigned instance );
       friend class ProcData_c;
   };
@@ -333,12 +333,9 @@ namespace __IsoAgLib {
   bool
   TcClientConnection_c::processControlAssignmentReceiver( bool assign, uint16_t elem, uint16_t ddi, const IsoName_c& name )
   {
-    const uint32_t key = getMapKey( ddi, elem );
-    ConnectedPdMap_t::iterator iter = m_connectedPds.find(key);
-
     bool success = false;
 
-    if ( iter != m_connectedPds.end())
+    if( m_connectedPds.find( ddi, elem ) )
     {
       const IsoItem_c* isoItem = getIsoMonitorInstance4Comm().item( name );
       if( isoItem )
@@ -361,15 +358,14 @@ namespace __IsoAgLib {
   bool
   TcClientConnection_c::processControlAssignmentTransmitter( bool assign, uint16_t elem, uint16_t ddi, const IsoName_c& name, uint16_t destElem )
   {
-    const uint32_t key = getMapKey( ddi, elem );
-    ConnectedPdMap_t::iterator iter = m_connectedPds.find(key);
+    ConnectedPd_c* cPd = m_connectedPds.find( ddi, elem );
 
     bool success = false;
 
-    if ( iter != m_connectedPds.end())
+    if( cPd )
     {
       const IsoItem_c* isoItem = getIsoMonitorInstance4Comm().item( name );
-      MeasureProg_c* mprog = static_cast< MeasureProg_c* >( iter->second );
+      MeasureProg_c* mprog = static_cast< MeasureProg_c* >( cPd );
 
       if( isoItem && mprog->pdLocal().isControlSource() )
       {
@@ -677,8 +673,11 @@ namespace __IsoAgLib {
   void
   TcClientConnection_c::stopRunningMeasurement()
   {
-    for( ConnectedPdMap_t::iterator i = m_connectedPds.begin(); i != m_connectedPds.end(); ++i )
-      static_cast<MeasureProg_c *>( i->second )->stopAllMeasurements();
+    for( uint32_t i = 0; i < m_connectedPds.numSlots(); ++i )
+    {
+      if( m_connectedPds.slot( i ) )
+        static_cast<MeasureProg_c *>( m_connectedPds.slot( i ) )->stopAllMeasurements();
+    }
   }
 
 
@@ -396,7 +396,7 @@ namespace __IsoAgLib {
     case PoolStateUploaded:
     case PoolStateActive:
     case PoolStateError:
-      m_schedulerTaskProxy.retriggerNow();
+      m_schedulerTaskProxy.trigger();
       break;
 
     case PoolStateDisconnected:
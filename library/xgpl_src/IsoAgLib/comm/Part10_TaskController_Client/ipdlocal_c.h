@@ -61,6 +61,7 @@ namespace IsoAgLib {
     void startMeasurement( iPdConnection_c&, ProcData::MeasurementCommand_t, int32_t _increment );
 
     friend class iPdPool_c;
+    friend class iPdLogger_c;
   };
 
 
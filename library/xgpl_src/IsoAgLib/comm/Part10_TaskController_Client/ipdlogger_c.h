@@ -0,0 +1,81 @@
+/*
+  ipdlogger_c.h: binary time-series log of the values of local
+    process data
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef IPDLOGGER_C_H
+#define IPDLOGGER_C_H
+
+#include "impl/procdata/pdlogger_c.h"
+#include "iprocdata_c.h"
+#include "ipdlocal_c.h"
+
+
+namespace IsoAgLib {
+
+  /** Logs all measurement values set and all setpoints received of the
+      added process data at full rate into a compact binary stream,
+      independent of any TC connection. See __IsoAgLib::PdLogger_c for
+      the format, tools/pdlogreader converts it to CSV. */
+  class iPdLogger_c : private __IsoAgLib::PdLogger_c {
+    public:
+      iPdLogger_c() : PdLogger_c() {}
+      virtual ~iPdLogger_c() {}
+
+      //! start logging to the stream, it has to stay valid until close()
+      void open( StreamOutput_c& stream ) {
+        PdLogger_c::open( stream );
+      }
+      //! write the buffered samples and stop logging to the stream
+      void close() {
+        PdLogger_c::close();
+      }
+      bool isOpen() const {
+        return PdLogger_c::isOpen();
+      }
+
+      void add( iProcData_c& pd ) {
+        PdLogger_c::add( static_cast<__IsoAgLib::ProcData_c&>( pd ) );
+      }
+      void add( iPdLocal_c& pd ) {
+        PdLogger_c::add( static_cast<__IsoAgLib::PdLocal_c&>( pd ) );
+      }
+      //! stop logging of all process data
+      void clear() {
+        PdLogger_c::clear();
+      }
+
+      //! write the buffered samples now
+      void flush() {
+        PdLogger_c::flush();
+      }
+
+      unsigned numBuffered() const {
+        return PdLogger_c::numBuffered();
+      }
+      uint32_t numWritten() const {
+        return PdLogger_c::numWritten();
+      }
+      uint32_t numDropped() const {
+        return PdLogger_c::numDropped();
+      }
+  };
+
+}
+
+#endif
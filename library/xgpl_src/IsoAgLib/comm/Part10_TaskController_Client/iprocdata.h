@@ -98,6 +98,13 @@ namespace IsoAgLib
       ElementTypeConnector,
       ElementTypeNavigationReference };
 
+    // 2 bit section states as packed into the condensed work state DDIs
+    enum WorkState_t {
+      WorkStateOff = 0,
+      WorkStateOn = 1,
+      WorkStateError = 2,
+      WorkStateNotAvailable = 3 };
+
     enum TriggerMethod_t { 
       TimeInterval = 0,
       DistInterval = 1,
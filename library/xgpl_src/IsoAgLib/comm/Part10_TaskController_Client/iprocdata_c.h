@@ -77,6 +77,8 @@ namespace IsoAgLib {
       }
 
       friend class iDevicePool_c;
+      friend class iCondensedWorkState_c;
+      friend class iPdLogger_c;
   };
 
 }
@@ -56,6 +56,7 @@ public:
     @param aui16_index index of delivered DTC [0..scui16_sizeDTCList-1]
     NOTE: no test if the index is valid !
     Writing to a DTC in this container shall only be done on load of the stored DTCs from non-volatile!
+    (The (SPN,FMI) index is rebuilt from the loaded DTCs when the diagnostics services are initialized.)
   */
   IsoAgLib::iDtc_s& operator[](uint16_t aui16_index) { return __IsoAgLib::DtcContainer_c::operator[](aui16_index); }
 
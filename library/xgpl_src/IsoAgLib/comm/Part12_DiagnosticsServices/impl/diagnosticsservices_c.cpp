@@ -49,6 +49,7 @@ DiagnosticsServices_c::DiagnosticsServices_c( IdentItem_c& arc_identItem ) :
   mb_dm1CurrentNeedsToBeSent(false),
   marr_dm1CurrentSize(0),
   m_dm1CurrentAtLeastOneDTC(false),  
+  mui16_dm1CurrentNumDtcs(0),
   ms_dm1SendingBroadcast(marr_dm1SendingBroadcast),
   ms_dm1SendingDestination(marr_dm1SendingDestination),
   ms_dm2SendingDestination(marr_dm2SendingDestination),
@@ -75,6 +76,9 @@ int DiagnosticsServices_c::getMultitonInst() const
 void
 DiagnosticsServices_c::init()
 {
+  // the DTCs may have been loaded from non-volatile in the meantime
+  mc_dtcs.reindex();
+
   // prepare initial DM1 and DM2
   marr_dm1CurrentSize                       = assembleDM1DM2(marr_dm1Current,true, &m_dm1CurrentAtLeastOneDTC);
   ms_dm2SendingDestination.marr_bufferSize  = assembleDM1DM2(ms_dm2SendingDestination.marr_buffer,false, NULL); // not required but nice to be prepared
@@ -252,16 +256,16 @@ DiagnosticsServices_c::calculateNextActionTime()
     int32_t i32_minNextAction = int32_t((mi32_dm1LastSentTime + sci32_periodDM1) - HAL::getTime());
   
     // and the need to send changes from the DTCs
-    for (uint16_t counter = 0;counter < DtcContainer_c::scui16_sizeDTCList ;++counter) // loop_all_DTCs
+    for (int active = 0; active < 2; ++active) // loop_all_DTCs (previously active and active)
     {
-      if (mc_dtcs[counter].ui32_spn == IsoAgLib::iDtc_s::spiNone)   
-        continue;
-
-      const int32_t ci32_minNextDtcAction = int32_t((mc_dtcs[counter].i32_timeLastStateChangeSent + sci32_periodDM1)
-                                              - mc_dtcs[counter].i32_timeLastStateChange);
+      for (uint16_t counter = mc_dtcs.getFirstDtcIndex(active != 0); counter < DtcContainer_c::scui16_sizeDTCList; counter = mc_dtcs.getNextDtcIndex(counter))
+      {
+        const int32_t ci32_minNextDtcAction = int32_t((mc_dtcs[counter].i32_timeLastStateChangeSent + sci32_periodDM1)
+                                                - mc_dtcs[counter].i32_timeLastStateChange);
 
-      if (ci32_minNextDtcAction < i32_minNextAction)
-        i32_minNextAction = ci32_minNextDtcAction;
+        if (ci32_minNextDtcAction < i32_minNextAction)
+          i32_minNextAction = ci32_minNextDtcAction;
+      }
     }
     if (i32_minNextAction < 0)
       i32_minNextAction = 0;
@@ -271,9 +275,11 @@ DiagnosticsServices_c::calculateNextActionTime()
 }
 
 void
-DiagnosticsServices_c::changeActiveDtcStatusAndRetrigger(IsoAgLib::iDtc_s& arc_dtcToChange, bool a_active)
+DiagnosticsServices_c::changeActiveDtcStatusAndRetrigger(uint16_t aui16_dtcIndex, bool a_active)
 {
-  arc_dtcToChange.b_active = a_active;
+  mc_dtcs.setDtcActive(aui16_dtcIndex, a_active);
+
+  IsoAgLib::iDtc_s& arc_dtcToChange = mc_dtcs[aui16_dtcIndex];
   arc_dtcToChange.i32_timeLastStateChange = HAL::getTime();
 
   m_dm1CurrentAtLeastOneDTC = true;
@@ -308,11 +314,14 @@ uint16_t DiagnosticsServices_c::dtcActivate(uint32_t SPN, IsoAgLib::FailureModeI
       if (mc_dtcs.getNumberOfDtc(true) == CONFIG_MAX_ACTIVE_DTCS)
         return 0;
 
-      changeActiveDtcStatusAndRetrigger(mc_dtcs[dtcId],true);
+      changeActiveDtcStatusAndRetrigger(dtcId,true);
 
       // increase OccurrenceCount
       if (mc_dtcs[dtcId].ui16_occurrenceCount < 0xFFFF)
         ++mc_dtcs[dtcId].ui16_occurrenceCount;
+
+      // not previously active anymore
+      ms_dm2SendingDestination.mb_bufferIsValid = false;
     }
     else // already active
     {
@@ -325,15 +334,12 @@ uint16_t DiagnosticsServices_c::dtcActivate(uint32_t SPN, IsoAgLib::FailureModeI
     if (mc_dtcs.getNumberOfDtc(true) == CONFIG_MAX_ACTIVE_DTCS)
       return 0;
     
-    // get next free slot
-    dtcId = mc_dtcs.getFreeDTCIndex();
+    // insert DTC into next free slot
+    const IsoAgLib::iDtc_s dtc(SPN,FMI); // explizit call of = operator case of weird issue with HighTec TC 1796 gcc v.3.4.6
+    dtcId = mc_dtcs.insertDtc(dtc);
 
     isoaglib_assert(DtcContainer_c::scui16_sizeDTCList != dtcId);
 
-    // insert DTC
-    const IsoAgLib::iDtc_s dtc(SPN,FMI); // explizit call of = operator case of weird issue with HighTec TC 1796 gcc v.3.4.6
-    mc_dtcs[dtcId] = dtc;
-
     // request send out immediately
     mb_dm1CurrentNeedsToBeSent = true;
 
@@ -342,11 +348,10 @@ uint16_t DiagnosticsServices_c::dtcActivate(uint32_t SPN, IsoAgLib::FailureModeI
   }
 
   // update send buffer -> "marr_dm1Current"
-  marr_dm1CurrentSize = assembleDM1DM2(marr_dm1Current,true, &m_dm1CurrentAtLeastOneDTC);
+  addToDM1Current(dtcId);
 
   ms_dm1SendingBroadcast.mb_bufferIsValid = false;
   ms_dm1SendingDestination.mb_bufferIsValid = false;
-  ms_dm2SendingDestination.mb_bufferIsValid = false;
 
   return mc_dtcs[dtcId].ui16_occurrenceCount;
 }
@@ -363,10 +368,10 @@ uint16_t DiagnosticsServices_c::dtcDeactivate(uint32_t SPN, IsoAgLib::FailureMod
       if (mc_dtcs.getNumberOfDtc(false) == CONFIG_MAX_PREVIOUSLY_ACTIVE_DTCS)
         return 0;
 
-      changeActiveDtcStatusAndRetrigger(mc_dtcs[dtcId],false);
+      changeActiveDtcStatusAndRetrigger(dtcId,false);
 
       // update send buffer -> "marr_dm1Current"
-      marr_dm1CurrentSize = assembleDM1DM2(marr_dm1Current,true, &m_dm1CurrentAtLeastOneDTC);
+      removeFromDM1Current(dtcId);
 
       ms_dm1SendingBroadcast.mb_bufferIsValid = false;
       ms_dm1SendingDestination.mb_bufferIsValid = false;
@@ -393,9 +398,9 @@ uint16_t DiagnosticsServices_c::dtcDeactivate(uint32_t SPN, IsoAgLib::FailureMod
  * This function will build the raw-data that are to be sent in the DM1 message
  * out of the "marr_dtc" structure-array.
  *
- * Only takes the valid "b_active" ones out of the array (SPI != spiNone)
- *
- * No need for further design, that's plain implementation.
+ * Only takes the ones of the active / previously active list.
+ * For DM1 it also records the DTC of each entry in "marr_dm1CurrentDtc",
+ * so add/removeFromDM1Current can patch the buffer afterwards.
  */
 uint16_t DiagnosticsServices_c::assembleDM1DM2(uint8_t* arr_send8bytes, bool ab_searchForActiveDtc, bool* atleastoneDTC)
 {
@@ -408,18 +413,16 @@ uint16_t DiagnosticsServices_c::assembleDM1DM2(uint8_t* arr_send8bytes, bool ab_
 
   uint16_t temp_size = 2;
 
-  for (uint16_t counter = 0;counter < DtcContainer_c::scui16_sizeDTCList ;++counter) // loop_all_DTCs
+  if (ab_searchForActiveDtc)
+    mui16_dm1CurrentNumDtcs = 0;
+
+  for (uint16_t counter = mc_dtcs.getFirstDtcIndex(ab_searchForActiveDtc); counter < DtcContainer_c::scui16_sizeDTCList; counter = mc_dtcs.getNextDtcIndex(counter))
   {
-    const IsoAgLib::iDtc_s& c_dtc = mc_dtcs[counter]; 
-    if ( (c_dtc.ui32_spn != IsoAgLib::iDtc_s::spiNone)
-      && (c_dtc.b_active == ab_searchForActiveDtc) )
-    {
-      arr_send8bytes[temp_size++] = static_cast<uint8_t>(c_dtc.ui32_spn);
-      arr_send8bytes[temp_size++] = static_cast<uint8_t>(c_dtc.ui32_spn >> 8);
-      arr_send8bytes[temp_size++] = static_cast<uint8_t>(((c_dtc.ui32_spn >> 11) & 0xE0) // 3 MSB in bits 8-6
-                                                         | (c_dtc.en_fmi));
-      arr_send8bytes[temp_size++] = static_cast<uint8_t>((c_dtc.ui16_occurrenceCount < 0x7F)?c_dtc.ui16_occurrenceCount:0x7F);
-    }
+    writeDtc(arr_send8bytes + temp_size, mc_dtcs[counter]);
+    temp_size += 4;
+
+    if (ab_searchForActiveDtc)
+      marr_dm1CurrentDtc[mui16_dm1CurrentNumDtcs++] = counter;
   }
 
   bool noDTC = false;
@@ -443,6 +446,72 @@ uint16_t DiagnosticsServices_c::assembleDM1DM2(uint8_t* arr_send8bytes, bool ab_
   return temp_size;
 }
 
+void
+DiagnosticsServices_c::writeDtc(uint8_t* arr_dest4bytes, const IsoAgLib::iDtc_s& arc_dtc)
+{
+  arr_dest4bytes[0] = static_cast<uint8_t>(arc_dtc.ui32_spn);
+  arr_dest4bytes[1] = static_cast<uint8_t>(arc_dtc.ui32_spn >> 8);
+  arr_dest4bytes[2] = static_cast<uint8_t>(((arc_dtc.ui32_spn >> 11) & 0xE0) // 3 MSB in bits 8-6
+                                           | (arc_dtc.en_fmi));
+  arr_dest4bytes[3] = static_cast<uint8_t>((arc_dtc.ui16_occurrenceCount < 0x7F)?arc_dtc.ui16_occurrenceCount:0x7F);
+}
+
+void
+DiagnosticsServices_c::addToDM1Current(uint16_t aui16_dtcIndex)
+{
+  isoaglib_assert(mui16_dm1CurrentNumDtcs < CONFIG_MAX_ACTIVE_DTCS);
+
+  writeDtc(marr_dm1Current + 2 + 4*mui16_dm1CurrentNumDtcs, mc_dtcs[aui16_dtcIndex]);
+  marr_dm1CurrentDtc[mui16_dm1CurrentNumDtcs++] = aui16_dtcIndex;
+
+  finishDM1Current();
+}
+
+void
+DiagnosticsServices_c::removeFromDM1Current(uint16_t aui16_dtcIndex)
+{
+  uint16_t pos = 0;
+  while (marr_dm1CurrentDtc[pos] != aui16_dtcIndex)
+  {
+    ++pos;
+    isoaglib_assert(pos < mui16_dm1CurrentNumDtcs);
+  }
+
+  // the order of the DTCs in DM1 is not relevant, so move the last one into the gap
+  const uint16_t last = uint16_t(mui16_dm1CurrentNumDtcs - 1);
+  if (pos != last)
+  {
+    CNAMESPACE::memcpy(marr_dm1Current + 2 + 4*pos, marr_dm1Current + 2 + 4*last, 4);
+    marr_dm1CurrentDtc[pos] = marr_dm1CurrentDtc[last];
+  }
+  mui16_dm1CurrentNumDtcs = last;
+
+  finishDM1Current();
+}
+
+// size and padding of "marr_dm1Current" as done by assembleDM1DM2
+void
+DiagnosticsServices_c::finishDM1Current()
+{
+  marr_dm1CurrentSize = 2 + 4*mui16_dm1CurrentNumDtcs;
+  m_dm1CurrentAtLeastOneDTC = (mui16_dm1CurrentNumDtcs > 0);
+
+  if (!m_dm1CurrentAtLeastOneDTC)
+  {
+    marr_dm1Current[2] = 0;
+    marr_dm1Current[3] = 0;
+    marr_dm1Current[4] = 0;
+    marr_dm1Current[5] = 0;
+    marr_dm1CurrentSize = 6;
+  }
+  if (6 == marr_dm1CurrentSize)
+  {
+    marr_dm1Current[6] = 0xFF;
+    marr_dm1Current[7] = 0xFF;
+    marr_dm1CurrentSize = 8;
+  }
+}
+
 void
 DiagnosticsServices_c::serviceTool_dtcClearPrevious()
 {
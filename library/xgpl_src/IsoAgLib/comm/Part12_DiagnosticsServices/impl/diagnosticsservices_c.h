@@ -185,8 +185,15 @@ private: // method
 
   uint16_t assembleDM1DM2(uint8_t* arr_send8bytes, bool ab_searchForActiveDtc, bool* atleastoneDTC);
 
+  /** patch "marr_dm1Current" for a DTC that got active / inactive */
+  void addToDM1Current(uint16_t aui16_dtcIndex);
+  void removeFromDM1Current(uint16_t aui16_dtcIndex);
+  void finishDM1Current();
+
+  static void writeDtc(uint8_t* arr_dest4bytes, const IsoAgLib::iDtc_s& arc_dtc);
+
   // do not call from this->timeEvent
-  void changeActiveDtcStatusAndRetrigger(IsoAgLib::iDtc_s& dtcToChange, bool active);
+  void changeActiveDtcStatusAndRetrigger(uint16_t aui16_dtcIndex, bool active);
 
   void sendSingleDM1DM2(uint32_t ui32_pgn, uint8_t* arr_send8bytes);
 
@@ -206,6 +213,9 @@ private: // attributes
   uint8_t marr_dm1Current [2+4*(CONFIG_MAX_ACTIVE_DTCS)];
   uint32_t marr_dm1CurrentSize;
   bool m_dm1CurrentAtLeastOneDTC;
+  /// DTC index of each DTC in "marr_dm1Current"
+  uint16_t marr_dm1CurrentDtc [CONFIG_MAX_ACTIVE_DTCS];
+  uint16_t mui16_dm1CurrentNumDtcs;
 
   uint8_t marr_dm1SendingBroadcast [2+4*(CONFIG_MAX_ACTIVE_DTCS)]; // the buffer currently being broadcast'
   BufferDescription_s ms_dm1SendingBroadcast;
@@ -22,64 +22,157 @@
 
 namespace __IsoAgLib {
 
+DtcContainer_c::DtcContainer_c()
+{
+  reindex();
+}
+
 uint16_t DtcContainer_c::getDTCIndex(uint32_t SPN, IsoAgLib::FailureModeIndicator_en FMI) const
 {
-  uint16_t counter = 0;
+  uint16_t index = marr_hash[hash(SPN,FMI)];
 
-  // search for DTC
-  for (;counter < scui16_sizeDTCList ;++counter) // loop_all_DTCs
+  // search in the hash chain
+  for (;index < scui16_sizeDTCList; index = marr_link[index].ui16_hashNext)
   {
-    if ((marr_dtc[counter].ui32_spn == SPN)
-      && (marr_dtc[counter].en_fmi == FMI))
+    if ((marr_dtc[index].ui32_spn == SPN)
+      && (marr_dtc[index].en_fmi == FMI))
       break;
   }
-  return counter;
+  return index;
 }
 
-uint16_t DtcContainer_c::getFreeDTCIndex() const
+uint16_t DtcContainer_c::insertDtc(const IsoAgLib::iDtc_s& arc_dtc)
 {
-  uint16_t counter = 0;
+  isoaglib_assert(arc_dtc.ui32_spn != IsoAgLib::iDtc_s::spiNone);
 
-  // search for DTC
-  for (;counter < scui16_sizeDTCList ;++counter) // loop_all_DTCs
+  const uint16_t index = mui16_freeFirst;
+  if (index < scui16_sizeDTCList)
   {
-    if (marr_dtc[counter].ui32_spn == IsoAgLib::iDtc_s::spiNone)
-      break;
+    mui16_freeFirst = marr_link[index].ui16_next;
+
+    marr_dtc[index] = arc_dtc;
+    linkHash(index);
+    linkList(index);
   }
-  return counter;
+  return index;
 }
 
-uint16_t DtcContainer_c::getNumberOfDtc(bool ab_searchForActiveDtc) const
+void DtcContainer_c::setDtcActive(uint16_t aui16_index, bool ab_active)
 {
-  uint16_t ui16_countActiveDtc = 0;
+  isoaglib_assert(aui16_index < scui16_sizeDTCList);
+  isoaglib_assert(marr_dtc[aui16_index].ui32_spn != IsoAgLib::iDtc_s::spiNone);
 
-  // search for active DTC
-  for (uint16_t counter = 0;counter < scui16_sizeDTCList ;++counter) // loop_all_DTCs
-  {
-    if ((marr_dtc[counter].ui32_spn != IsoAgLib::iDtc_s::spiNone)
-      && (marr_dtc[counter].b_active == ab_searchForActiveDtc))
-      ++ui16_countActiveDtc;
-  }
-  return ui16_countActiveDtc;
+  if (marr_dtc[aui16_index].b_active == ab_active)
+    return;
+
+  unlinkList(aui16_index);
+  marr_dtc[aui16_index].b_active = ab_active;
+  linkList(aui16_index);
 }
 
 void
 DtcContainer_c::dtcClearPrevious()
 {
-  for (uint16_t counter = 0;counter < scui16_sizeDTCList ;++counter) // all_DTCs_in_array
+  uint16_t index = marr_listFirst[0];
+  while (index < scui16_sizeDTCList)
+  { // inactive == previously active
+    const uint16_t next = marr_link[index].ui16_next;
+
+    // "remove it from the list".
+    unlinkHash(index);
+    marr_dtc[index].ui32_spn = IsoAgLib::iDtc_s::spiNone;
+
+    marr_link[index].ui16_next = mui16_freeFirst;
+    mui16_freeFirst = index;
+
+    index = next;
+  }
+  marr_listFirst[0] = scui16_sizeDTCList;
+  marr_listSize[0] = 0;
+}
+
+void
+DtcContainer_c::reindex()
+{
+  for (uint16_t bucket = 0; bucket < scui16_hashSize; ++bucket)
+    marr_hash[bucket] = scui16_sizeDTCList;
+
+  for (int list = 0; list < 2; ++list)
   {
-    IsoAgLib::iDtc_s& dtc = marr_dtc[counter];
-    if (dtc.ui32_spn != IsoAgLib::iDtc_s::spiNone)
-    { // valid one found
-      if (!dtc.b_active)
-      { // inactive == previously active
-        // "remove it from the list".
-        dtc.ui32_spn = IsoAgLib::iDtc_s::spiNone;
-      }
-      // else: active one, don't touch
+    marr_listFirst[list] = scui16_sizeDTCList;
+    marr_listSize[list] = 0;
+  }
+
+  // walk backwards so the free list and the lists are in ascending order
+  mui16_freeFirst = scui16_sizeDTCList;
+  for (uint16_t counter = scui16_sizeDTCList; counter-- > 0;) // loop_all_DTCs
+  {
+    if (marr_dtc[counter].ui32_spn == IsoAgLib::iDtc_s::spiNone)
+    {
+      marr_link[counter].ui16_next = mui16_freeFirst;
+      mui16_freeFirst = counter;
+    }
+    else
+    {
+      linkHash(counter);
+      linkList(counter);
     }
-    // else: empty placeholder.
   }
 }
 
+void
+DtcContainer_c::linkHash(uint16_t aui16_index)
+{
+  const IsoAgLib::iDtc_s& c_dtc = marr_dtc[aui16_index];
+
+  uint16_t& rui16_bucket = marr_hash[hash(c_dtc.ui32_spn, c_dtc.en_fmi)];
+  marr_link[aui16_index].ui16_hashNext = rui16_bucket;
+  rui16_bucket = aui16_index;
+}
+
+void
+DtcContainer_c::linkList(uint16_t aui16_index)
+{
+  Link_s& rs_link = marr_link[aui16_index];
+  const int list = marr_dtc[aui16_index].b_active ? 1 : 0;
+
+  rs_link.ui16_prev = scui16_sizeDTCList;
+  rs_link.ui16_next = marr_listFirst[list];
+  if (rs_link.ui16_next < scui16_sizeDTCList)
+    marr_link[rs_link.ui16_next].ui16_prev = aui16_index;
+  marr_listFirst[list] = aui16_index;
+  ++marr_listSize[list];
+}
+
+void
+DtcContainer_c::unlinkList(uint16_t aui16_index)
+{
+  const Link_s& rs_link = marr_link[aui16_index];
+  const int list = marr_dtc[aui16_index].b_active ? 1 : 0;
+
+  if (rs_link.ui16_prev < scui16_sizeDTCList)
+    marr_link[rs_link.ui16_prev].ui16_next = rs_link.ui16_next;
+  else
+    marr_listFirst[list] = rs_link.ui16_next;
+
+  if (rs_link.ui16_next < scui16_sizeDTCList)
+    marr_link[rs_link.ui16_next].ui16_prev = rs_link.ui16_prev;
+
+  --marr_listSize[list];
+}
+
+void
+DtcContainer_c::unlinkHash(uint16_t aui16_index)
+{
+  const IsoAgLib::iDtc_s& c_dtc = marr_dtc[aui16_index];
+
+  uint16_t* pui16_index = &marr_hash[hash(c_dtc.ui32_spn, c_dtc.en_fmi)];
+  while (*pui16_index != aui16_index)
+  {
+    isoaglib_assert(*pui16_index < scui16_sizeDTCList);
+    pui16_index = &marr_link[*pui16_index].ui16_hashNext;
+  }
+  *pui16_index = marr_link[aui16_index].ui16_hashNext;
+}
+
 } // end of namespace __IsoAgLib
@@ -30,6 +30,9 @@ namespace __IsoAgLib {
 
 /**
   This class stores and manages array of DTC elements
+  The DTCs are indexed by (SPN,FMI) and linked into an active and a
+  previously active list, so that lookups, counting and assembling the
+  DM1/DM2 payload don't have to walk the whole array.
   @author Antoine Kandera, reviewed by Martin Wodok
 */
 class DtcContainer_c
@@ -37,7 +40,7 @@ class DtcContainer_c
 public:
   static const uint16_t scui16_sizeDTCList = (CONFIG_MAX_ACTIVE_DTCS) + (CONFIG_MAX_PREVIOUSLY_ACTIVE_DTCS);
 
-  DtcContainer_c() {}
+  DtcContainer_c();
   ~DtcContainer_c() {}
 
   /**
@@ -52,21 +55,45 @@ public:
     @return index in [0..scui16_sizeDTCList-1] if found
             scui16_sizeDTCList if not found
   */
-  uint16_t getFreeDTCIndex() const;
+  uint16_t getFreeDTCIndex() const { return mui16_freeFirst; }
 
   /**
     @param ab_searchForActiveDtc : true for number of active DTC, false for number of previously active DTC
     @return number of active / previously active DTC
   */
-  uint16_t getNumberOfDtc(bool ab_searchForActiveDtc) const;
+  uint16_t getNumberOfDtc(bool ab_searchForActiveDtc) const { return marr_listSize[ab_searchForActiveDtc ? 1 : 0]; }
+
+  /**
+    Iterate the active / previously active DTCs:
+    for (i = getFirstDtcIndex(active); i < scui16_sizeDTCList; i = getNextDtcIndex(i))
+  */
+  uint16_t getFirstDtcIndex(bool ab_searchForActiveDtc) const { return marr_listFirst[ab_searchForActiveDtc ? 1 : 0]; }
+  uint16_t getNextDtcIndex(uint16_t aui16_index) const { isoaglib_header_assert(aui16_index < scui16_sizeDTCList); return marr_link[aui16_index].ui16_next; }
+
+  /**
+    Insert the DTC into a free slot
+    @return index of the inserted DTC
+            scui16_sizeDTCList if there's no free slot
+  */
+  uint16_t insertDtc(const IsoAgLib::iDtc_s& arc_dtc);
+
+  /** Set b_active of the DTC and move it to the according list */
+  void setDtcActive(uint16_t aui16_index, bool ab_active);
 
   /** Clear the Previous Active Trouble Codes */
   void dtcClearPrevious();
 
+  /**
+    Rebuild index and lists from the DTCs,
+    needed after they've been written using operator[] (loading from non-volatile)
+  */
+  void reindex();
+
   /**
     deliver an iDtc_s reference from a specific index with operator[]
     @param aui16_index index of delivered DTC [0..scui16_sizeDTCList-1]
     NOTE: no test if the index is valid !
+    NOTE: changing SPN, FMI or b_active requires a reindex() afterwards!
   */
   IsoAgLib::iDtc_s& operator[](uint16_t aui16_index) { isoaglib_header_assert(aui16_index < scui16_sizeDTCList); return marr_dtc[aui16_index];}
 
@@ -78,10 +105,38 @@ public:
   const IsoAgLib::iDtc_s& operator[](uint16_t aui16_index) const { isoaglib_header_assert(aui16_index < scui16_sizeDTCList); return marr_dtc[aui16_index];}
 
 private:
-  /// "List" of all DTCs
-  /// For the real amount of the active / prev. active DTCs,
-  /// iterate through "marr_dtc" and count all entries with "ui32_spn != spiNone"
+  // number of hash buckets, power of 2
+  static const uint16_t scui16_hashSize = 128;
+
+  struct Link_s
+  {
+    uint16_t ui16_next; // in active / previously active / free list
+    uint16_t ui16_prev; // in active / previously active list
+    uint16_t ui16_hashNext;
+  };
+
+  static uint16_t hash(uint32_t SPN, IsoAgLib::FailureModeIndicator_en FMI)
+  { return uint16_t((SPN ^ (SPN >> 7) ^ (SPN >> 14) ^ (uint32_t(FMI) << 2)) & (scui16_hashSize - 1)); }
+
+  void linkHash(uint16_t aui16_index);
+  void linkList(uint16_t aui16_index);
+  void unlinkList(uint16_t aui16_index);
+  void unlinkHash(uint16_t aui16_index);
+
+private:
+  /// "List" of all DTCs, empty entries have "ui32_spn == spiNone"
   IsoAgLib::iDtc_s marr_dtc [scui16_sizeDTCList];
+
+  /// Links of the entries in "marr_dtc",
+  /// "scui16_sizeDTCList" terminates the lists and hash chains
+  Link_s marr_link [scui16_sizeDTCList];
+  uint16_t marr_hash [scui16_hashSize];
+
+  /// [0] previously active, [1] active
+  uint16_t marr_listFirst [2];
+  uint16_t marr_listSize [2];
+
+  uint16_t mui16_freeFirst;
 };
 
 }  // __IsoAgLib
@@ -24,6 +24,8 @@
 #include "ifsserverinstance_c.h"
 #include "ifsstructs.h"
 
+#include <supplementary_driver/driver/datastreams/streaminput_c.h>
+
 namespace IsoAgLib
 {
 
@@ -99,6 +101,16 @@ class iFsClient_c
       */
 
     virtual void readFileResponse(iFsError /*ui8_errorCode*/, uint16_t /*ui16_dataLength*/, uint8_t * /*pui8_data*/) = 0;
+    /**
+      * During a streaming read (iFsClientServerCommunication_c::readFileStream) this function is called with the data of
+      * each received burst in file order. Read the ui16_dataLength bytes from rc_data right away, it is the receive stream.
+      */
+    virtual void readFileStreamData(StreamInput_c & /*rc_data*/, uint16_t /*ui16_dataLength*/) {}
+    /**
+      * Called once a streaming read ended with the total number of bytes handed over. fsSuccess if the requested count
+      * (or the whole file) was read, fsEndOfFileReached if the file ended before the requested count.
+      */
+    virtual void readFileStreamResponse(iFsError /*ui8_errorCode*/, uint32_t /*ui32_dataLength*/) {}
     /**
       * After the call to read a file, this function is used to receive the successstatus of the command if the file was a directory.
       * The content of the file is returned.
@@ -109,6 +121,16 @@ class iFsClient_c
       * written data.
       */
     virtual void writeFileResponse(iFsError /*ui8_errorCode*/, uint16_t /*ui16_dataWritten*/) = 0;
+    /**
+      * Called once all data buffered by an iFsFileWriter_c is written after its flush() or close(), or on its first
+      * write error (no more data is written then). ui32_dataWritten is the total number of bytes written since open().
+      */
+    virtual void fileWriterResponse(iFsError /*ui8_errorCode*/, uint32_t /*ui32_dataWritten*/) {}
+    /**
+      * Called once a directory prefetch (iFsClientServerCommunication_c::prefetchDirectory) ended. After fsSuccess the
+      * listing is available from iFsClientServerCommunication_c::getCachedDirectory() until it expires or is changed.
+      */
+    virtual void prefetchDirectoryResponse(iFsError /*ui8_errorCode*/, const uint8_t * /*pui8_directory*/) {}
     /**
       * After the call to close a file, this function is used to receive the successstatus of the command.
       */
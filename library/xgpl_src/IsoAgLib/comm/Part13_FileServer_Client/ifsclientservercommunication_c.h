@@ -40,6 +40,7 @@ class iFsClientServerCommunication_c : private __IsoAgLib::FsClientServerCommuni
     iFsClientServerCommunication_c();
 
     friend class __IsoAgLib::FsClientServerCommunication_c;
+    friend class iFsFileWriter_c;
 
   public :
 
@@ -116,6 +117,18 @@ class iFsClientServerCommunication_c : private __IsoAgLib::FsClientServerCommuni
     uint8_t readFile(uint8_t ui8_fileHandle, uint16_t ui16_count)
     { return __IsoAgLib::FsClientServerCommunication_c::readFile(ui8_fileHandle, ui16_count); }
 
+    /**
+      * read content of a file as a stream: blocks of up to CONFIG_FS_CLIENT_STREAM_READ_SIZE
+      * bytes are requested one after the other without waiting for the application. The data
+      * is handed over burst by burst via iFsClient_c::readFileStreamData() directly from the
+      * receive stream, the end via iFsClient_c::readFileStreamResponse().
+      * @param ui8_fileHandle filehandle of the desired file
+      * @param ui32_count number of bytes that shall be read, 0xFFFFFFFF for the rest of the file
+      * @return 0 if request was sent without problems, else an errorcode is returned.
+      */
+    uint8_t readFileStream(uint8_t ui8_fileHandle, uint32_t ui32_count)
+    { return __IsoAgLib::FsClientServerCommunication_c::readFileStream(ui8_fileHandle, ui32_count); }
+
     /**
       * read content of a file
       * @param ui8_fileHandle filehandle of the desired file
@@ -191,6 +204,28 @@ class iFsClientServerCommunication_c : private __IsoAgLib::FsClientServerCommuni
     uint8_t getFileDateTime(uint8_t *pui8_fileName)
     { return __IsoAgLib::FsClientServerCommunication_c::getFileDateTime(pui8_fileName); }
 
+    /**
+      * read all entries of a directory into the metadata cache in the background. The end is
+      * reported by iFsClient_c::prefetchDirectoryResponse(), the other iFsClient_c responses
+      * are not called for it. Get file attributes and get file date/time of the files in the
+      * directory are answered from the cache then, without asking the fileserver.
+      * @param pui8_directoryName name of the directory
+      * @param b_reportHiddenFiles read hidden files, too? Only then a file missing in the
+      *        listing is reported as not found without asking the fileserver.
+      * @return 0 if request was sent without problems, else an errorcode is returned.
+      */
+    uint8_t prefetchDirectory(uint8_t *pui8_directoryName, bool b_reportHiddenFiles)
+    { return __IsoAgLib::FsClientServerCommunication_c::prefetchDirectory(pui8_directoryName, b_reportHiddenFiles); }
+
+    /**
+      * get the complete listing of a directory from the metadata cache.
+      * DO NOT KEEP THIS POINTER, IT MAY CHANGE WITH THE NEXT COMMAND!!
+      * @param pui8_directoryName name of the directory
+      * @return NULL if the directory isn't (or no more) cached.
+      */
+    const iFsDirList *getCachedDirectory(uint8_t *pui8_directoryName)
+    { return __IsoAgLib::FsClientServerCommunication_c::getCachedDirectory(pui8_directoryName); }
+
 
     /**
       * initialize volume
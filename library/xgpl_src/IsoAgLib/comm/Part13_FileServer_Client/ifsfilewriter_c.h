@@ -0,0 +1,91 @@
+/*
+  ifsfilewriter_c.h: write-behind buffered writing of a file
+    on a file server
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef IFSFILEWRITER_C_H
+#define IFSFILEWRITER_C_H
+
+#include "impl/fsfilewriter_c.h"
+#include "ifsclientservercommunication_c.h"
+
+
+namespace IsoAgLib {
+
+  /** Buffers the writes to a file opened for writing and sends them as
+      few large (E)TP Write File requests, one in flight while the next
+      buffer fills. While open, the writer gets the write file responses
+      instead of the iFsClient_c, the end of flush()/close() and the first
+      error are reported by iFsClient_c::fileWriterResponse().
+      Don't destroy the writer while a write is in flight (see isIdle()). */
+  class iFsFileWriter_c : private __IsoAgLib::FsFileWriter_c {
+    public:
+      iFsFileWriter_c( iFsClientServerCommunication_c& rc_fsCSComm, uint16_t aui16_bufferSize = CONFIG_FS_CLIENT_WRITE_BUFFER_SIZE )
+        : FsFileWriter_c( static_cast<__IsoAgLib::FsClientServerCommunication_c&>( rc_fsCSComm ), aui16_bufferSize ) {}
+      virtual ~iFsFileWriter_c() {}
+
+      //! start writing to the already opened file
+      //! @return false if still open or another writer uses the communication
+      bool open( uint8_t aui8_fileHandle ) {
+        return FsFileWriter_c::open( aui8_fileHandle );
+      }
+      //! @return number of bytes taken, less if the buffers are busy, 0 after an error
+      uint32_t write( const uint8_t* apui8_data, uint32_t aui32_length ) {
+        return FsFileWriter_c::write( apui8_data, aui32_length );
+      }
+      //! write the buffered data now
+      void flush() {
+        FsFileWriter_c::flush();
+      }
+      //! flush and close the file, closeFileResponse() follows
+      void close() {
+        FsFileWriter_c::close();
+      }
+
+      bool isOpen() const {
+        return FsFileWriter_c::isOpen();
+      }
+      bool isIdle() const {
+        return FsFileWriter_c::isIdle();
+      }
+      uint32_t getFreeSpace() const {
+        return FsFileWriter_c::getFreeSpace();
+      }
+      iFsError getError() const {
+        return FsFileWriter_c::getError();
+      }
+
+      uint32_t getBytesWritten() const {
+        return FsFileWriter_c::getBytesWritten();
+      }
+      uint32_t getNumRoundTrips() const {
+        return FsFileWriter_c::getNumRoundTrips();
+      }
+      //! in msec
+      int32_t getAverageRoundTripTime() const {
+        return FsFileWriter_c::getAverageRoundTripTime();
+      }
+      //! in bytes per second
+      uint32_t getThroughput() const {
+        return FsFileWriter_c::getThroughput();
+      }
+  };
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include "fsclientservercommunication_c.h"
 #include "fsserverinstance_c.h"
 #include "fsmanager_c.h"
+#include "fsfilewriter_c.h"
 
 // ISOAgLib
 #include <IsoAgLib/comm/impl/isobus_c.h>
@@ -52,10 +53,20 @@ FsClientServerCommunication_c::FsClientServerCommunication_c(
   , c_identItem( rc_identItem )
   , pui8_currentDirectory( NULL )
   , pc_commandHandler( NULL )
+  , pc_fileWriter( NULL )
   , mb_finishedRequestingFsConnection( false )
 {
 }
 
+FsClientServerCommunication_c::~FsClientServerCommunication_c()
+{
+  if (pc_fileWriter)
+    pc_fileWriter->abort(IsoAgLib::fsFileserverNotResponding, false);
+
+  delete pui8_currentDirectory;
+  delete pc_commandHandler;
+}
+
 /** explicit conversion to reference of interface class type */
 IsoAgLib::iFsClientServerCommunication_c*
 FsClientServerCommunication_c::toInterfacePointer()
@@ -111,6 +122,10 @@ FsClientServerCommunication_c::notifyOnOfflineFileServer (FsServerInstance_c &rc
   delete pc_commandHandler;
   pc_commandHandler = NULL;
 
+  // the file handle of an attached file writer is gone with the FS
+  if (pc_fileWriter)
+    pc_fileWriter->abort(IsoAgLib::fsFileserverNotResponding, true);
+
   // notify the Application on lost FS
   c_fsClient.notifyOnOfflineFileServer (*(rc_fsServerInstance.toInterfacePointer()));
 }
@@ -201,6 +216,17 @@ FsClientServerCommunication_c::requestFsConnection(FsServerInstance_c &rc_fileSe
         return pc_commandHandler->readFile(ui8_fileHandle, ui16_count);
     }
 
+    IsoAgLib::iFsCommandErrors
+    FsClientServerCommunication_c::readFileStream(uint8_t ui8_fileHandle, uint32_t ui32_count)
+    {
+      if (!pc_commandHandler)
+        return IsoAgLib::fsCommandNotPressent;
+      if (pc_commandHandler->isBusy())
+        return IsoAgLib::fsCommandBusy;
+      else
+        return pc_commandHandler->readFileStream(ui8_fileHandle, ui32_count);
+    }
+
     IsoAgLib::iFsCommandErrors
     FsClientServerCommunication_c::readDirectory(uint8_t ui8_fileHandle, uint16_t ui16_count, bool b_reportHiddenFiles)
     {
@@ -223,6 +249,17 @@ FsClientServerCommunication_c::requestFsConnection(FsServerInstance_c &rc_fileSe
         return pc_commandHandler->writeFile(ui8_fileHandle, ui16_count, pui8_data);
     }
 
+    IsoAgLib::iFsCommandErrors
+    FsClientServerCommunication_c::writeFileFromBuffer(uint8_t ui8_fileHandle, uint16_t ui16_count, uint8_t *pui8_buffer)
+    {
+      if (!pc_commandHandler)
+        return IsoAgLib::fsCommandNotPressent;
+      if (pc_commandHandler->isBusy())
+        return IsoAgLib::fsCommandBusy;
+      else
+        return pc_commandHandler->writeFileFromBuffer(ui8_fileHandle, ui16_count, pui8_buffer);
+    }
+
     IsoAgLib::iFsCommandErrors
     FsClientServerCommunication_c::closeFile(uint8_t ui8_fileHandle)
     {
@@ -289,6 +326,31 @@ FsClientServerCommunication_c::requestFsConnection(FsServerInstance_c &rc_fileSe
         return pc_commandHandler->getFileDateTime(pui8_fileName);
     }
 
+    IsoAgLib::iFsCommandErrors
+    FsClientServerCommunication_c::prefetchDirectory(uint8_t *pui8_directoryName, bool b_reportHiddenFiles)
+    {
+      if (!pc_commandHandler)
+        return IsoAgLib::fsCommandNotPressent;
+      if (pc_commandHandler->isBusy())
+        return IsoAgLib::fsCommandBusy;
+      else
+        return pc_commandHandler->prefetchDirectory(pui8_directoryName, b_reportHiddenFiles);
+    }
+
+    const IsoAgLib::iFsDirList *
+    FsClientServerCommunication_c::getCachedDirectory(uint8_t *pui8_directoryName)
+    {
+      if (!pc_commandHandler)
+        return NULL;
+
+      STL_NAMESPACE::string str_path;
+      if (!FsMetadataCache_c::absolutePath(pui8_currentDirectory, pui8_directoryName, str_path))
+        return NULL;
+
+      FsDirectoryListing_c *pc_listing = getFileserver().getMetadataCache().listing(str_path, HAL::getTime());
+      return pc_listing ? &pc_listing->list() : NULL;
+    }
+
     IsoAgLib::iFsCommandErrors
     FsClientServerCommunication_c::initializeVolume(uint8_t *pui8_pathName, uint32_t ui32_space, bool b_createVolumeUsingSpace, bool b_createNewVolume)
     {
@@ -344,6 +406,11 @@ FsClientServerCommunication_c::requestFsConnection(FsServerInstance_c &rc_fileSe
     void
     FsClientServerCommunication_c::changeCurrentDirectoryResponse(IsoAgLib::iFsError ui8_errorCode, uint8_t *piu8_newCurrentDirectory)
     {
+      // keep the current directory absolute, also after a change relative to it
+      STL_NAMESPACE::string str_directory;
+      if (!ui8_errorCode && FsMetadataCache_c::absolutePath(pui8_currentDirectory, piu8_newCurrentDirectory, str_directory))
+        piu8_newCurrentDirectory = (uint8_t *)str_directory.c_str();
+
       if (!ui8_errorCode)
       {
         uint16_t ui16_length = uint16_t( CNAMESPACE::strlen((char *)piu8_newCurrentDirectory) );
@@ -383,6 +450,15 @@ FsClientServerCommunication_c::requestFsConnection(FsServerInstance_c &rc_fileSe
       c_fsClient.getFileAttributesResponse(ui8_errorCode, b_caseSensitive, b_removable, b_longFilenames, b_directory, b_volume, b_hidden, b_readOnly);
     }
 
+    void
+    FsClientServerCommunication_c::writeFileResponse(IsoAgLib::iFsError ui8_errorCode, uint16_t ui16_dataWritten)
+    {
+      if (pc_fileWriter && pc_fileWriter->writeFileResponse(ui8_errorCode, ui16_dataWritten))
+        return;
+
+      c_fsClient.writeFileResponse(ui8_errorCode, ui16_dataWritten);
+    }
+
     void
     FsClientServerCommunication_c::setFileAttributesResponse(IsoAgLib::iFsError ui8_errorCode)
     {
@@ -416,4 +492,21 @@ FsClientServerCommunication_c::requestFsConnection(FsServerInstance_c &rc_fileSe
 
     /// FileServer access response functions END
 
+bool
+FsClientServerCommunication_c::attachFileWriter(FsFileWriter_c &rc_fileWriter)
+{
+  if (pc_fileWriter && (pc_fileWriter != &rc_fileWriter))
+    return false;
+
+  pc_fileWriter = &rc_fileWriter;
+  return true;
+}
+
+void
+FsClientServerCommunication_c::detachFileWriter(FsFileWriter_c &rc_fileWriter)
+{
+  if (pc_fileWriter == &rc_fileWriter)
+    pc_fileWriter = NULL;
+}
+
 } // __IsoAgLib
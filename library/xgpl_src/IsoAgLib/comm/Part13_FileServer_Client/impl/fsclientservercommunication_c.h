@@ -37,6 +37,8 @@ namespace IsoAgLib {
 // Begin Namespace __IsoAgLib
 namespace __IsoAgLib {
 
+class FsFileWriter_c;
+
 /**
   * class FsClientServerCommunication_c, managing the communication betweent a fileserver client and
   * a fileserver. The CAN-BUS communication is done by the FsClientServerCommunication_c's FsResponse_c.
@@ -77,11 +79,7 @@ class FsClientServerCommunication_c
     /** constructor to init client-server communication without fileserver*/
     FsClientServerCommunication_c(IdentItem_c &rc_identItem, IsoAgLib::iFsClient_c &rc_fsClient, const IsoAgLib::iFsWhitelistList &v_fsWhitelist);
 
-    ~FsClientServerCommunication_c()
-    {
-      delete pui8_currentDirectory;
-      delete pc_commandHandler;
-    }
+    ~FsClientServerCommunication_c();
 
     /** explicit conversion to reference of interface class type*/
     IsoAgLib::iFsClientServerCommunication_c* toInterfacePointer();
@@ -122,8 +120,10 @@ class FsClientServerCommunication_c
     IsoAgLib::iFsCommandErrors openFile(uint8_t *pui8_fileName, bool b_openExclusive, bool b_openForAppend, bool b_createNewFile, bool b_openForReading, bool b_openForWriting, bool b_openDirectory);
     IsoAgLib::iFsCommandErrors seekFile(uint8_t ui8_fileHandle, uint8_t ui8_possitionMode, int32_t i32_offset);
     IsoAgLib::iFsCommandErrors readFile(uint8_t ui8_fileHandle, uint16_t ui16_count);
+    IsoAgLib::iFsCommandErrors readFileStream(uint8_t ui8_fileHandle, uint32_t ui32_count);
     IsoAgLib::iFsCommandErrors readDirectory(uint8_t ui8_fileHandle, uint16_t ui16_count, bool b_reportHiddenFiles);
     IsoAgLib::iFsCommandErrors writeFile(uint8_t ui8_fileHandle, uint16_t ui16_count, const uint8_t *pui8_data);
+    IsoAgLib::iFsCommandErrors writeFileFromBuffer(uint8_t ui8_fileHandle, uint16_t ui16_count, uint8_t *pui8_buffer);
     IsoAgLib::iFsCommandErrors closeFile(uint8_t ui8_fileHandle);
 
     IsoAgLib::iFsCommandErrors moveFile(uint8_t *pui8_sourceName, uint8_t *pui8_destName, bool b_recursive, bool b_force, bool b_copy);
@@ -131,6 +131,7 @@ class FsClientServerCommunication_c
     IsoAgLib::iFsCommandErrors getFileAttributes(uint8_t *pui8_fileName);
     IsoAgLib::iFsCommandErrors setFileAttributes(uint8_t *pui8_fileName, uint8_t ui8_hiddenAtt, uint8_t ui8_readOnlyAtt);
     IsoAgLib::iFsCommandErrors getFileDateTime(uint8_t *pui8_fileName);
+    IsoAgLib::iFsCommandErrors prefetchDirectory(uint8_t *pui8_directoryName, bool b_reportHiddenFiles);
 
     IsoAgLib::iFsCommandErrors initializeVolume(uint8_t *pui8_pathName, uint32_t ui32_space, bool b_createVolumeUsingSpace, bool b_createNewVolume);
 
@@ -138,6 +139,24 @@ class FsClientServerCommunication_c
     bool getKeepConnectionOpen();
     /// FileServer access functions END
 
+    /**
+      * complete listing of the directory from the metadata cache, as read by prefetchDirectory().
+      * DO NOT KEEP THIS POINTER, IT MAY CHANGE WITH THE NEXT COMMAND!!
+      * @return NULL if not (or no more) cached.
+      */
+    const IsoAgLib::iFsDirList *getCachedDirectory(uint8_t *pui8_directoryName);
+
+    /** maximum number of bytes for writeFileFromBuffer(), 0 if not connected */
+    uint16_t maxWriteSize() { return pc_commandHandler ? pc_commandHandler->maxWriteSize() : 0; }
+
+    /**
+      * The write file responses go to the attached FsFileWriter_c while it has
+      * a write in flight, all other responses to the iFsClient_c.
+      * @return false if another FsFileWriter_c is attached already.
+      */
+    bool attachFileWriter(FsFileWriter_c &rc_fileWriter);
+    void detachFileWriter(FsFileWriter_c &rc_fileWriter);
+
     /// FileServer access response functions as defined in iFsClient_c
 
     void getCurrentDirectoryResponse(IsoAgLib::iFsError ui8_errorCode, uint8_t *piu8_currentDirectory);
@@ -157,10 +176,17 @@ class FsClientServerCommunication_c
     { c_fsClient.seekFileResponse(ui8_errorCode, ui32_position); }
     void readFileResponse(IsoAgLib::iFsError ui8_errorCode, uint16_t ui16_dataLength, uint8_t *pui8_data)
     { c_fsClient.readFileResponse(ui8_errorCode, ui16_dataLength, pui8_data); }
+    void readFileStreamData(StreamInput_c &rc_data, uint16_t ui16_dataLength)
+    { c_fsClient.readFileStreamData(rc_data, ui16_dataLength); }
+    void readFileStreamResponse(IsoAgLib::iFsError ui8_errorCode, uint32_t ui32_dataLength)
+    { c_fsClient.readFileStreamResponse(ui8_errorCode, ui32_dataLength); }
     void readDirectoryResponse(IsoAgLib::iFsError ui8_errorCode, IsoAgLib::iFsDirList v_directories)
     { c_fsClient.readDirectoryResponse(ui8_errorCode, v_directories); }
-    void writeFileResponse(IsoAgLib::iFsError ui8_errorCode, uint16_t ui16_dataWritten)
-    { c_fsClient.writeFileResponse(ui8_errorCode, ui16_dataWritten); }
+    void writeFileResponse(IsoAgLib::iFsError ui8_errorCode, uint16_t ui16_dataWritten);
+    void fileWriterResponse(IsoAgLib::iFsError ui8_errorCode, uint32_t ui32_dataWritten)
+    { c_fsClient.fileWriterResponse(ui8_errorCode, ui32_dataWritten); }
+    void prefetchDirectoryResponse(IsoAgLib::iFsError ui8_errorCode, const uint8_t *pui8_directory)
+    { c_fsClient.prefetchDirectoryResponse(ui8_errorCode, pui8_directory); }
     void closeFileResponse(IsoAgLib::iFsError ui8_errorCode)
     { c_fsClient.closeFileResponse(ui8_errorCode); }
 
@@ -220,6 +246,11 @@ class FsClientServerCommunication_c
       */
     FsCommand_c *pc_commandHandler;
 
+    /**
+      * The FsFileWriter_c currently writing via this communication, NULL if none.
+      */
+    FsFileWriter_c *pc_fileWriter;
+
     /**
       * Flag indication if the registration process to a fileserver has been done successfully. This means that the current
       * directory as well as the existing volumes of the fileserver have been requested successfully.
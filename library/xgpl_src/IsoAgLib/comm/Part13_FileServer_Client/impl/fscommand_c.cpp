@@ -27,6 +27,7 @@
 #include <IsoAgLib/comm/Part13_FileServer_Client/impl/fsmanager_c.h>
 #include <IsoAgLib/comm/impl/isobus_c.h>
 #include <IsoAgLib/util/iassert.h>
+#include <supplementary_driver/driver/datastreams/volatilememorywithsize_c.h>
 
 // debug
 #if DEBUG_FILESERVER
@@ -50,6 +51,53 @@ const int gci_REQUEST_REPEAT_TIME=600; // 11783-13 Chapter 5.3.3
 /* TODO may need to create a timeout based on number of bytes being read */
 const int gci_REQUEST_REPEAT_BUSY_TIME=5000; // ISOAgLib proprietary value.
 
+// Read File response: TAN, error code, count (the command byte is the stream's first byte)
+const uint16_t gcui16_READ_RESPONSE_HEADER=4;
+// largest Read File response a TP stream can carry
+const uint16_t gcui16_MAX_TP_READ_SIZE=1785 - 1 - gcui16_READ_RESPONSE_HEADER;
+// Write File request: command, TAN, handle, count
+const uint16_t gcui16_WRITE_REQUEST_HEADER=5;
+// largest Write File request a TP stream can carry
+const uint16_t gcui16_MAX_TP_WRITE_SIZE=1785 - gcui16_WRITE_REQUEST_HEADER;
+
+
+/** Exactly the given number of bytes of the underlying stream, so the
+    application can't read into the next burst or response. */
+class LimitedStreamInput_c : public StreamInput_c
+{
+public:
+  LimitedStreamInput_c(StreamInput_c& rc_source, uint16_t ui16_length)
+    : mrc_source(rc_source), mui16_remaining(ui16_length) {}
+
+  virtual StreamInput_c& operator>>(uint8_t& ui8_data)
+  {
+    if (mui16_remaining == 0)
+      ui8_data = 0xFF;
+    else
+    {
+      mrc_source >> ui8_data;
+      --mui16_remaining;
+    }
+    return *this;
+  }
+
+  virtual bool eof() const { return mui16_remaining == 0; }
+
+  void skipRemaining()
+  {
+    uint8_t ui8_dummy;
+    while (mui16_remaining > 0)
+      *this >> ui8_dummy;
+  }
+
+private:
+  StreamInput_c& mrc_source;
+  uint16_t mui16_remaining;
+
+  LimitedStreamInput_c(const LimitedStreamInput_c&);
+  LimitedStreamInput_c& operator=(const LimitedStreamInput_c&);
+};
+
 uint8_t FsCommand_c::m_maintenanceMsgBuf[8] = {0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
 
 FsCommand_c::FsCommand_c(FsClientServerCommunication_c &FSCSComm, FsServerInstance_c &fileServerInst)
@@ -62,6 +110,7 @@ FsCommand_c::FsCommand_c(FsClientServerCommunication_c &FSCSComm, FsServerInstan
   , m_keepConnectionOpen( false )
   , m_lastAliveSentTime( -1 )
   , m_packetLength(0)
+  , m_sendData( m_sendMsgBuf )
   , m_multireceiveMsgBuf( NULL )
   , m_multireceiveMsgBufAllocSize( 0 )
   , m_multireceiveMsgBufOffset( 0 )
@@ -87,8 +136,27 @@ FsCommand_c::FsCommand_c(FsClientServerCommunication_c &FSCSComm, FsServerInstan
   , m_count( 0 )
   , m_data( NULL )
   , m_dataAllocSize( 0 )
-  , m_dirData()
+  , m_dirListing()
   , m_readDirectory( false )
+  , m_reportHiddenFiles( false )
+  , m_streamRead( false )
+  , m_streamRemaining( 0 )
+  , m_streamDelivered( 0 )
+  , m_streamResponseCount( 0 )
+  , m_streamResponseParsed( 0 )
+  , m_streamResponseDelivered( 0 )
+  , m_cachePath()
+  , m_cachePath2()
+  , m_cacheCreate( false )
+  , m_cachedResponse( false )
+  , m_cachedDate( 0 )
+  , m_cachedTime( 0 )
+  , m_openPaths()
+  , m_prefetch( false )
+  , m_prefetchFirst( false )
+  , m_prefetchHidden( false )
+  , m_prefetchError( IsoAgLib::fsSuccess )
+  , m_prefetchPath()
   , m_receiveFilterCreated( false )
   , m_initialQueryStarted( false )
   , m_initializingFileserver( mc_fileserver.isBeingInitialized() )
@@ -130,6 +198,9 @@ FsCommand_c::~FsCommand_c()
 void
 FsCommand_c::timeEvent(void)
 {
+  if (m_cachedResponse)
+    deliverCachedResponse();
+
   if (!m_FSCSComm.getClientIdentItem().isClaimedAddress())
     return;
 
@@ -208,7 +279,17 @@ FsCommand_c::timeEvent(void)
         // have the lastCommand reset before calling callback,
         // because they may trigger new commands,
         // setting the lastCommand, which would be overwritten by "noCommand" then
-        switch( finishCommand() )
+        if (m_prefetch)
+        {
+          if (finishCommand() == en_readFile)
+          { // the directory is open, close it before reporting the end
+            m_prefetchError = IsoAgLib::fsFileserverNotResponding;
+            closeFile(m_fileHandle);
+          }
+          else
+            finishPrefetch(IsoAgLib::fsFileserverNotResponding);
+        }
+        else switch( finishCommand() )
         {
           case en_noCommand:
             isoaglib_assert (!"Internal error. Shouldn't be in en_noCommand state when giveing up with the current command.");
@@ -231,9 +312,14 @@ FsCommand_c::timeEvent(void)
           case en_readFile:
             if (m_readDirectory)
             {
-              clearDirectoryList();
+              m_dirListing.clear();
 
-              m_FSCSComm.readDirectoryResponse(IsoAgLib::fsFileserverNotResponding, m_dirData);
+              m_FSCSComm.readDirectoryResponse(IsoAgLib::fsFileserverNotResponding, m_dirListing.list());
+            }
+            else if (m_streamRead)
+            {
+              m_streamRead = false;
+              m_FSCSComm.readFileStreamResponse(IsoAgLib::fsFileserverNotResponding, m_streamDelivered);
             }
             else
               m_FSCSComm.readFileResponse(IsoAgLib::fsFileserverNotResponding, 0, (uint8_t *)NULL);
@@ -303,6 +389,7 @@ FsCommand_c::finishCommand()
   const commandtype_en oldCommand = en_lastCommand;
   en_lastCommand = en_noCommand;
   m_receivedResponse = true;
+  m_sendData = m_sendMsgBuf;
   ++m_tan;
 #ifdef WORKAROUND_FSCLIENT_LIMITED_TAN_USE
   // There's a problem with TAN 0xFF, some CCI FS will always answer with the TAN 0xFE response!
@@ -333,6 +420,46 @@ FsCommand_c::processPartStreamDataChunk (Stream_c& stream, bool isFirstChunk, bo
   }
   // else: further chunks - no checks...
 
+  if (m_streamRead && (stream.getFirstByte() == en_readFile) && (en_lastCommand == en_readFile))
+  { // streaming read: hand the data over directly from the receive stream
+    if (isFirstChunk)
+    {
+      m_errorCode = stream.get();
+      m_streamResponseCount = stream.get();
+      m_streamResponseCount = uint16_t(m_streamResponseCount | (uint16_t(stream.get()) << 8));
+      m_streamResponseParsed = 0;
+    }
+
+    uint32_t ui32_length = stream.getNotParsedSize();
+    if (ui32_length > uint32_t(m_streamResponseCount - m_streamResponseParsed))
+      ui32_length = m_streamResponseCount - m_streamResponseParsed;
+
+    // skip what was already handed over from an aborted transmission of this response
+    while ((ui32_length > 0) && (m_streamResponseParsed < m_streamResponseDelivered))
+    {
+      (void)stream.get();
+      ++m_streamResponseParsed;
+      --ui32_length;
+    }
+
+    if (!isLastChunkAndACKd)
+    {
+      deliverStreamData(stream, uint16_t(ui32_length));
+      m_streamResponseParsed = uint16_t(m_streamResponseParsed + ui32_length);
+      m_streamResponseDelivered = m_streamResponseParsed;
+      return false;
+    }
+
+    // request the next block before handing over the last burst
+    finishCommand();
+    const bool cb_finished = streamResponseReceived();
+    deliverStreamData(stream, uint16_t(ui32_length));
+    if (cb_finished)
+      m_FSCSComm.readFileStreamResponse(IsoAgLib::iFsError(m_errorCode), m_streamDelivered);
+
+    return false; // don't keep the stream, we've processed it right now, so remove it
+  }
+
   uint16_t ui16_notParsedSize
     = stream.getNotParsedSize();
 
@@ -371,13 +498,7 @@ FsCommand_c::processPartStreamDataChunk (Stream_c& stream, bool isFirstChunk, bo
 
       case en_readFile:
         if ( m_readDirectory )
-        {
-          decodeReadDirectoryResponse();
-          if (m_initializingFileserver)
-            closeFile(m_fileHandle);
-          else
-            m_FSCSComm.readDirectoryResponse(IsoAgLib::iFsError(m_errorCode), m_dirData);
-        }
+          processReadDirectoryResponse();
         else
         {
           decodeReadFileResponse();
@@ -403,6 +524,9 @@ FsCommand_c::reactOnAbort (Stream_c& )
 bool
 FsCommand_c::reactOnStreamStart(const ReceiveStreamIdentifier_c& /*streamIdent*/, uint32_t totalLen)
 {
+  if (m_streamRead && (en_lastCommand == en_readFile))
+    return true; // parsed directly from the stream, no buffer needed
+
   const uint32_t newSize = totalLen - 1; // -1 for "FirstByte" that's already read.
 
   if (newSize > m_multireceiveMsgBufAllocSize)
@@ -489,6 +613,34 @@ FsCommand_c::processMsgIso( const CanPkgExt_c& pkg )
         return CommandRunning;
       }
 
+      if (m_prefetch)
+      {
+        if (m_errorCode == IsoAgLib::fsSuccess)
+        {
+          m_prefetchFirst = true;
+          readDirectory(m_fileHandle, CONFIG_FS_CLIENT_PREFETCH_COUNT, m_prefetchHidden);
+        }
+        else
+          finishPrefetch(IsoAgLib::iFsError(m_errorCode));
+        break;
+      }
+
+      if (m_errorCode == IsoAgLib::fsSuccess)
+      {
+        if (m_cacheCreate)
+          metadataCache().invalidate(m_cachePath);
+
+        OpenPath_s *ps_openPath = findOpenPath(m_fileHandle);
+        if (ps_openPath == NULL)
+        {
+          m_openPaths.push_back(OpenPath_s());
+          ps_openPath = &m_openPaths.back();
+          ps_openPath->handle = m_fileHandle;
+        }
+        ps_openPath->written = false;
+        ps_openPath->path = m_cachePath;
+      }
+
       m_FSCSComm.openFileResponse(IsoAgLib::iFsError(m_errorCode), m_fileHandle, m_attrCaseSensitive, m_attrRemovable, m_attrLongFilenames, m_attrIsDirectory,  m_attrIsVolume, m_attrHidden, m_attrReadOnly);
       break;
 
@@ -521,6 +673,26 @@ FsCommand_c::processMsgIso( const CanPkgExt_c& pkg )
       break;
 
     case en_readFile:
+      if (m_streamRead)
+      { // short response: up to 3 data bytes after the count
+        m_errorCode = pkg.getUint8Data(2);
+        m_streamResponseCount = uint16_t(pkg.getUint8Data(3) | (pkg.getUint8Data(4) << 8));
+        if (m_streamResponseCount > 3)
+          m_streamResponseCount = 3;
+
+        uint8_t pui8_data[3];
+        const uint16_t cui16_length = m_streamResponseCount;
+        for (uint8_t i = 0; i < cui16_length; ++i)
+          pui8_data[i] = pkg.getUint8Data(5 + i);
+
+        const bool cb_finished = streamResponseReceived();
+        VolatileMemoryWithSize_c c_data(pui8_data, cui16_length);
+        deliverStreamData(c_data, cui16_length);
+        if (cb_finished)
+          m_FSCSComm.readFileStreamResponse(IsoAgLib::iFsError(m_errorCode), m_streamDelivered);
+        break;
+      }
+
       if (6 > m_multireceiveMsgBufAllocSize)
       {
         if ( m_multireceiveMsgBuf != NULL )
@@ -534,13 +706,7 @@ FsCommand_c::processMsgIso( const CanPkgExt_c& pkg )
         m_multireceiveMsgBuf[i] = pkg.getUint8Data(i + 2);
 
       if ( m_readDirectory )
-      {
-        decodeReadDirectoryResponse();
-        if (m_initializingFileserver)
-          closeFile(m_fileHandle);
-        else
-          m_FSCSComm.readDirectoryResponse(IsoAgLib::iFsError(m_errorCode), m_dirData);
-      }
+        processReadDirectoryResponse();
       else
       {
         decodeReadFileResponse();
@@ -549,6 +715,16 @@ FsCommand_c::processMsgIso( const CanPkgExt_c& pkg )
       break;
 
     case en_writeFile:
+      {
+        OpenPath_s *ps_openPath = findOpenPath(m_fileHandle);
+        if (ps_openPath != NULL)
+        {
+          ps_openPath->written = true;
+          metadataCache().invalidate(ps_openPath->path);
+        }
+        else
+          metadataCache().invalidate(STL_NAMESPACE::string());
+      }
       m_FSCSComm.writeFileResponse(IsoAgLib::iFsError(pkg.getUint8Data(2)), (pkg.getUint8Data(3) | pkg.getUint8Data(4) << 0x08));
       break;
 
@@ -561,28 +737,50 @@ FsCommand_c::processMsgIso( const CanPkgExt_c& pkg )
       //init case get volumes or real external seek file?
       if (m_initializingFileserver)
       {
-        getFileserver().setVolumes(m_dirData);
+        getFileserver().setVolumes(m_dirListing.list());
         getFileserver().setState (FsServerInstance_c::usablePending);
         return CommandFinished;
       }
 
+      if (m_prefetch)
+      {
+        finishPrefetch(IsoAgLib::iFsError(m_prefetchError));
+        break;
+      }
+
+      for (STL_NAMESPACE::vector<OpenPath_s>::iterator it = m_openPaths.begin(); it != m_openPaths.end(); ++it)
+      {
+        if (it->handle == m_fileHandle)
+        {
+          if (it->written)
+            metadataCache().invalidate(it->path);
+          m_openPaths.erase(it);
+          break;
+        }
+      }
+
       m_FSCSComm.closeFileResponse(IsoAgLib::iFsError(m_errorCode));
       break;
 
     case en_moveFile:
+      metadataCache().invalidate(m_cachePath);
+      metadataCache().invalidate(m_cachePath2);
       m_FSCSComm.moveFileResponse(IsoAgLib::iFsError(pkg.getUint8Data(2)));
       break;
 
     case en_deleteFile:
+      metadataCache().invalidate(m_cachePath);
       m_FSCSComm.deleteFileResponse(IsoAgLib::iFsError(pkg.getUint8Data(2)));
       break;
 
     case en_getFileAttributes:
+      metadataCache().storeAttributes(m_cachePath, HAL::getTime(), pkg.getUint8Data(2), pkg.getUint8Data(3));
       decodeAttributes(pkg.getUint8Data(3));
       m_FSCSComm.getFileAttributesResponse(IsoAgLib::iFsError(pkg.getUint8Data(2)), m_attrCaseSensitive, m_attrRemovable, m_attrLongFilenames, m_attrIsDirectory,  m_attrIsVolume, m_attrHidden, m_attrReadOnly);
       break;
 
     case en_setFileAttributes:
+      metadataCache().invalidate(m_cachePath);
       m_FSCSComm.setFileAttributesResponse(IsoAgLib::iFsError(pkg.getUint8Data(2)));
       break;
 
@@ -591,7 +789,8 @@ FsCommand_c::processMsgIso( const CanPkgExt_c& pkg )
         uint16_t date = pkg.getUint8Data(3) | (pkg.getUint8Data(4) << 8);
         uint16_t time = pkg.getUint8Data(5) | (pkg.getUint8Data(6) << 8);
 
-        m_FSCSComm.getFileDateTimeResponse(IsoAgLib::iFsError(pkg.getUint8Data(2)), (uint16_t)(1980 + ((date >> 9) & 0x7F)), (date >> 5) & 0xF, (date) & 0x1F, (time >> 11) & 0x1F, (time >> 5) & 0x3F, 2 * ((time) & 0x1F));
+        metadataCache().storeDateTime(m_cachePath, HAL::getTime(), pkg.getUint8Data(2), date, time);
+        decodeGetFileDateTimeResponse(pkg.getUint8Data(2), date, time);
       }
       break;
 
@@ -620,7 +819,7 @@ FsCommand_c::sendRequest (RequestType_en requestType)
   }
 
 #if DEBUG_FILESERVER
-  INTERNAL_DEBUG_DEVICE << "Sending Request " << int(m_sendMsgBuf[0]) << " -> Fileserver [Try No. " << int(m_requestAttempts) << "]." << INTERNAL_DEBUG_DEVICE_ENDL;
+  INTERNAL_DEBUG_DEVICE << "Sending Request " << int(m_sendData[0]) << " -> Fileserver [Try No. " << int(m_requestAttempts) << "]." << INTERNAL_DEBUG_DEVICE_ENDL;
 #endif
 
   if (m_packetLength <= 8)
@@ -664,7 +863,7 @@ FsCommand_c::sendMultiPacketTry()
     !getMultiSendInstance4Comm().sendIsoTarget(
       m_FSCSComm.getClientIdentItem().getIsoItem()->isoName(),
       getFileserver().getIsoName(),
-      m_sendMsgBuf,
+      m_sendData,
       m_packetLength,
       CLIENT_TO_FS_PGN,
       &m_multiSendEventHandler);
@@ -765,6 +964,9 @@ FsCommand_c::openFile(uint8_t *fileName, bool openExclusive, bool openForAppend,
 {
   en_lastCommand = en_openFile;
 
+  cachePath(fileName, m_cachePath);
+  m_cacheCreate = createNewFile;
+
   uint16_t ui16_length = uint16_t( CNAMESPACE::strlen((const char*)fileName) );
   if ((ui16_length + 1) > m_fileNameAllocSize)
   {
@@ -871,6 +1073,86 @@ FsCommand_c::readFile(uint8_t fileHandle, uint16_t count)
 }
 
 
+IsoAgLib::iFsCommandErrors
+FsCommand_c::readFileStream(uint8_t fileHandle, uint32_t count)
+{
+  m_readDirectory = false;
+  m_streamRead = true;
+  m_streamRemaining = count;
+  m_streamDelivered = 0;
+  m_fileHandle = fileHandle;
+
+  if (count == 0)
+  {
+    m_streamRead = false;
+    m_FSCSComm.readFileStreamResponse(IsoAgLib::fsSuccess, 0);
+    return IsoAgLib::fsCommandNoError;
+  }
+
+  requestStreamRead();
+  return IsoAgLib::fsCommandNoError;
+}
+
+
+uint16_t
+FsCommand_c::streamReadSize()
+{
+  uint32_t ui32_size = CONFIG_FS_CLIENT_STREAM_READ_SIZE;
+  // ETP transported responses only from file servers of the IS version on
+  if ((getFileserver().getStandardVersion() < FsServerInstance_c::FsVersionIS) && (ui32_size > gcui16_MAX_TP_READ_SIZE))
+    ui32_size = gcui16_MAX_TP_READ_SIZE;
+  if (ui32_size > m_streamRemaining)
+    ui32_size = m_streamRemaining;
+  return uint16_t(ui32_size);
+}
+
+
+void
+FsCommand_c::requestStreamRead()
+{
+  m_streamResponseCount = 0;
+  m_streamResponseParsed = 0;
+  m_streamResponseDelivered = 0;
+  (void)readFile(m_fileHandle, streamReadSize(), false);
+}
+
+
+void
+FsCommand_c::deliverStreamData(StreamInput_c& data, uint16_t length)
+{
+  if (length == 0)
+    return;
+
+  LimitedStreamInput_c c_data(data, length);
+  m_FSCSComm.readFileStreamData(c_data, length);
+  c_data.skipRemaining();
+}
+
+
+bool
+FsCommand_c::streamResponseReceived()
+{
+  const uint16_t cui16_requested = m_count;
+  m_streamDelivered += m_streamResponseCount;
+  if (m_streamRemaining != 0xFFFFFFFFUL)
+    m_streamRemaining -= (m_streamResponseCount < m_streamRemaining) ? m_streamResponseCount : m_streamRemaining;
+
+  if ((m_errorCode == IsoAgLib::fsSuccess) && (m_streamResponseCount >= cui16_requested) && (m_streamRemaining > 0))
+  {
+    requestStreamRead();
+    return false;
+  }
+
+  if (((m_errorCode == IsoAgLib::fsSuccess) || (m_errorCode == IsoAgLib::fsEndOfFileReached)) && (m_streamRemaining > 0))
+  { // end of file: as requested for 0xFFFFFFFF, else before the requested count
+    m_errorCode = (m_streamRemaining == 0xFFFFFFFFUL) ? IsoAgLib::fsSuccess : IsoAgLib::fsEndOfFileReached;
+  }
+
+  m_streamRead = false;
+  return true;
+}
+
+
 IsoAgLib::iFsCommandErrors
 FsCommand_c::readDirectory(uint8_t fileHandle, uint16_t count, bool reportHiddenFiles)
 {
@@ -906,6 +1188,43 @@ FsCommand_c::writeFile(uint8_t fileHandle, uint16_t count, const uint8_t *data)
 }
 
 
+IsoAgLib::iFsCommandErrors
+FsCommand_c::writeFileFromBuffer(uint8_t fileHandle, uint16_t count, uint8_t *buffer)
+{
+  // small writes may go as single packet, which is sent from m_sendMsgBuf
+  if (count <= CONFIG_FS_CLIENT_MAX_WRITE_SIZE)
+    return writeFile(fileHandle, count, buffer + gcui16_WRITE_REQUEST_HEADER);
+
+  isoaglib_assert( count <= maxWriteSize() );
+
+  en_lastCommand = en_writeFile;
+
+  m_fileHandle = fileHandle;
+
+  buffer[0] = en_lastCommand;
+  buffer[1] = m_tan;
+  buffer[2] = m_fileHandle;
+  buffer[3] = static_cast<uint8_t>(count);
+  buffer[4] = static_cast<uint8_t>(count >> 8);
+
+  m_sendData = buffer;
+  m_packetLength = uint32_t(count) + gcui16_WRITE_REQUEST_HEADER;
+
+  sendRequest (RequestInitial);
+
+  return IsoAgLib::fsCommandNoError;
+}
+
+
+uint16_t
+FsCommand_c::maxWriteSize()
+{
+  if (getFileserver().getStandardVersion() < FsServerInstance_c::FsVersionIS)
+    return gcui16_MAX_TP_WRITE_SIZE;
+  return 0xFFFF;
+}
+
+
 IsoAgLib::iFsCommandErrors
 FsCommand_c::closeFile(uint8_t fileHandle)
 {
@@ -936,6 +1255,9 @@ FsCommand_c::moveFile(uint8_t *sourceName, uint8_t *destName, bool recursive, bo
 
   en_lastCommand = en_moveFile;
 
+  cachePath(sourceName, m_cachePath);
+  cachePath(destName, m_cachePath2);
+
   m_sendMsgBuf[ui8_bufferPosition++] = en_lastCommand;
   m_sendMsgBuf[ui8_bufferPosition++] = m_tan;
 
@@ -979,6 +1301,8 @@ FsCommand_c::deleteFile (uint8_t *sourceName, bool recursive, bool force)
 
   en_lastCommand = en_deleteFile;
 
+  cachePath(sourceName, m_cachePath);
+
   m_sendMsgBuf[ui8_bufferPosition++] = en_lastCommand;
   m_sendMsgBuf[ui8_bufferPosition++] = m_tan;
 
@@ -1009,6 +1333,10 @@ FsCommand_c::deleteFile (uint8_t *sourceName, bool recursive, bool force)
 IsoAgLib::iFsCommandErrors
 FsCommand_c::getFileAttributes(uint8_t *sourceName)
 {
+  cachePath(sourceName, m_cachePath);
+  if (respondFromCache(en_getFileAttributes))
+    return IsoAgLib::fsCommandNoError;
+
   en_lastCommand = en_getFileAttributes;
 
   m_sendMsgBuf[0] = en_lastCommand;
@@ -1034,6 +1362,8 @@ FsCommand_c::setFileAttributes(uint8_t *sourceName, uint8_t hiddenAttr, uint8_t
 {
   en_lastCommand = en_setFileAttributes;
 
+  cachePath(sourceName, m_cachePath);
+
   m_sendMsgBuf[0] = en_lastCommand;
   m_sendMsgBuf[1] = m_tan;
 
@@ -1058,6 +1388,10 @@ FsCommand_c::setFileAttributes(uint8_t *sourceName, uint8_t hiddenAttr, uint8_t
 IsoAgLib::iFsCommandErrors
 FsCommand_c::getFileDateTime(uint8_t *sourceName)
 {
+  cachePath(sourceName, m_cachePath);
+  if (respondFromCache(en_getFileDateTime))
+    return IsoAgLib::fsCommandNoError;
+
   en_lastCommand = en_getFileDateTime;
 
   m_sendMsgBuf[0] = en_lastCommand;
@@ -1171,12 +1505,10 @@ FsCommand_c::decodeReadFileResponse()
 void
 FsCommand_c::decodeReadDirectoryResponse()
 {
-  IsoAgLib::iFsDirectoryPtr ps_tmpDir;
-
   m_errorCode = m_multireceiveMsgBuf[0];
   m_count = m_multireceiveMsgBuf[1] | (m_multireceiveMsgBuf[2] << 0x08);
 
-  clearDirectoryList();
+  m_dirListing.clear();
 
   int32_t offset = 3;
 
@@ -1189,58 +1521,180 @@ FsCommand_c::decodeReadDirectoryResponse()
     if( ((uint32_t)offset + (uint32_t(filenameLength)+1+2+2+4) - 1) >= m_multireceiveMsgBufAllocSize)
       break;
 
-    ps_tmpDir = new IsoAgLib::iFsDirectory();
-    ps_tmpDir->pui8_filename = new uint8_t[ filenameLength + 1 ]; // +1 for null-termination
+    const uint8_t *filename = &m_multireceiveMsgBuf[offset];
+    offset += filenameLength;
 
-    unsigned filenameIndex = 0;
-    const int32_t offsetAttributes = offset + int32_t(filenameLength);
-    while( offset < offsetAttributes )
-      ps_tmpDir->pui8_filename[ filenameIndex++ ] = m_multireceiveMsgBuf[offset++];
-    ps_tmpDir->pui8_filename[ filenameIndex ] = 0; // null-terminate
+    const uint8_t attributes = m_multireceiveMsgBuf[offset++];
 
-    decodeAttributes(m_multireceiveMsgBuf[offset++]);
-
-    ps_tmpDir->b_caseSensitive = m_attrCaseSensitive;
-    ps_tmpDir->b_removable = m_attrRemovable;
-    ps_tmpDir->b_longFilenames = m_attrLongFilenames;
-    ps_tmpDir->b_isDirectory = m_attrIsDirectory;
-    ps_tmpDir->b_isVolume = m_attrIsVolume;
-    ps_tmpDir->b_hidden = m_attrHidden;
-    ps_tmpDir->b_readOnly = m_attrReadOnly;
-
-    ps_tmpDir->ui16_date = m_multireceiveMsgBuf[offset] | (m_multireceiveMsgBuf[offset + 1] << 0x08);
+    const uint16_t date = m_multireceiveMsgBuf[offset] | (m_multireceiveMsgBuf[offset + 1] << 0x08);
     offset += 2;
 
-    ps_tmpDir->ui16_time = m_multireceiveMsgBuf[offset] | (m_multireceiveMsgBuf[offset + 1] << 0x08);
+    const uint16_t time = m_multireceiveMsgBuf[offset] | (m_multireceiveMsgBuf[offset + 1] << 0x08);
     offset += 2;
 
-    ps_tmpDir->ui32_size =
+    const uint32_t size =
          static_cast<uint32_t>(m_multireceiveMsgBuf[offset])
-      | (static_cast<uint32_t>(m_multireceiveMsgBuf[offset + 1]) << 0x08) 
-      | (static_cast<uint32_t>(m_multireceiveMsgBuf[offset + 2]) << 0x10) 
+      | (static_cast<uint32_t>(m_multireceiveMsgBuf[offset + 1]) << 0x08)
+      | (static_cast<uint32_t>(m_multireceiveMsgBuf[offset + 2]) << 0x10)
       | (static_cast<uint32_t>(m_multireceiveMsgBuf[offset + 3]) << 0x18);
     offset += 4;
 
-    m_dirData.push_back(ps_tmpDir);
+    m_dirListing.add(filename, filenameLength, attributes, date, time, size);
   }
 }
 
 
 void
-FsCommand_c::clearDirectoryList()
+FsCommand_c::decodeGetFileDateTimeResponse(uint8_t errorCode, uint16_t date, uint16_t time)
+{
+  m_FSCSComm.getFileDateTimeResponse(IsoAgLib::iFsError(errorCode), (uint16_t)(1980 + ((date >> 9) & 0x7F)), (date >> 5) & 0xF, (date) & 0x1F, (time >> 11) & 0x1F, (time >> 5) & 0x3F, 2 * ((time) & 0x1F));
+}
+
+
+void
+FsCommand_c::processReadDirectoryResponse()
 {
-  IsoAgLib::iFsDirectoryPtr ps_tmpDir;
-  while (!m_dirData.empty())
+  decodeReadDirectoryResponse();
+
+  if (m_initializingFileserver)
+    closeFile(m_fileHandle);
+  else if (m_prefetch)
+    prefetchReadResponse();
+  else
   {
-    ps_tmpDir = m_dirData.back();
-    m_dirData.pop_back();
-    if (ps_tmpDir->pui8_filename != NULL)
-      delete [] ps_tmpDir->pui8_filename;
-    delete ps_tmpDir;
+    const IsoAgLib::iFsDirList &entries = m_dirListing.list();
+
+    // the entries may be a part of the directory only
+    OpenPath_s *ps_openPath = findOpenPath(m_fileHandle);
+    if ( (ps_openPath != NULL)
+      && ((m_errorCode == IsoAgLib::fsSuccess) || (m_errorCode == IsoAgLib::fsEndOfFileReached)) )
+      metadataCache().storeListing(ps_openPath->path, HAL::getTime(), m_reportHiddenFiles, entries, true, false);
+
+    m_FSCSComm.readDirectoryResponse(IsoAgLib::iFsError(m_errorCode), entries);
   }
 }
 
 
+void
+FsCommand_c::cachePath(const uint8_t *name, STL_NAMESPACE::string &path)
+{
+  if (!FsMetadataCache_c::absolutePath(m_FSCSComm.getCurrentDirectory(), name, path))
+    path.clear();
+}
+
+
+bool
+FsCommand_c::respondFromCache(commandtype_en command)
+{
+  FsMetadataCache_c::Info_s s_info;
+  const uint8_t cui8_valid = metadataCache().lookup(m_cachePath, HAL::getTime(), s_info);
+
+  if (command == en_getFileAttributes)
+  {
+    if ((cui8_valid & FsMetadataCache_c::ValidAttributes) == 0)
+      return false;
+    decodeAttributes(s_info.ui8_attributes);
+  }
+  else
+  {
+    if ((cui8_valid & FsMetadataCache_c::ValidDateTime) == 0)
+      return false;
+    m_cachedDate = s_info.ui16_date;
+    m_cachedTime = s_info.ui16_time;
+  }
+
+  // the response is given like one of the file server, so the
+  // application can't take it for being called from its request
+  en_lastCommand = command;
+  m_errorCode = s_info.ui8_error;
+  m_cachedResponse = true;
+  m_receivedResponse = false;
+  m_lastrequestAttemptTime = -1;
+  m_schedulerTask.trigger();
+  return true;
+}
+
+
+void
+FsCommand_c::deliverCachedResponse()
+{
+  m_cachedResponse = false;
+
+  switch (finishCommand())
+  {
+    case en_getFileAttributes:
+      m_FSCSComm.getFileAttributesResponse(IsoAgLib::iFsError(m_errorCode), m_attrCaseSensitive, m_attrRemovable, m_attrLongFilenames, m_attrIsDirectory,  m_attrIsVolume, m_attrHidden, m_attrReadOnly);
+      break;
+
+    case en_getFileDateTime:
+      decodeGetFileDateTimeResponse(m_errorCode, m_cachedDate, m_cachedTime);
+      break;
+
+    default:
+      isoaglib_assert( !"Only get file attributes and get file date/time are answered from the cache!" );
+      break;
+  }
+}
+
+
+FsCommand_c::OpenPath_s *
+FsCommand_c::findOpenPath(uint8_t fileHandle)
+{
+  for (STL_NAMESPACE::vector<OpenPath_s>::iterator it = m_openPaths.begin(); it != m_openPaths.end(); ++it)
+  {
+    if (it->handle == fileHandle)
+      return &*it;
+  }
+  return NULL;
+}
+
+
+IsoAgLib::iFsCommandErrors
+FsCommand_c::prefetchDirectory(uint8_t *directoryName, bool reportHiddenFiles)
+{
+  cachePath(directoryName, m_prefetchPath);
+  if (m_prefetchPath.empty() || (CONFIG_FS_CLIENT_METADATA_CACHE_TTL == 0))
+    return IsoAgLib::fsCommandWrongFlag;
+
+  const IsoAgLib::iFsCommandErrors ce_result = openFile(directoryName, false, false, false, true, false, true);
+  if (ce_result == IsoAgLib::fsCommandNoError)
+  {
+    m_prefetch = true;
+    m_prefetchHidden = reportHiddenFiles;
+    m_prefetchError = IsoAgLib::fsSuccess;
+  }
+  return ce_result;
+}
+
+
+void
+FsCommand_c::prefetchReadResponse()
+{
+  const bool cb_complete = (m_errorCode == IsoAgLib::fsEndOfFileReached)
+    || ((m_errorCode == IsoAgLib::fsSuccess) && (m_count < CONFIG_FS_CLIENT_PREFETCH_COUNT));
+
+  if ((m_errorCode == IsoAgLib::fsSuccess) || (m_errorCode == IsoAgLib::fsEndOfFileReached))
+    metadataCache().storeListing(m_prefetchPath, HAL::getTime(), m_prefetchHidden, m_dirListing.list(), m_prefetchFirst, cb_complete);
+  else
+    m_prefetchError = m_errorCode;
+
+  m_prefetchFirst = false;
+
+  if ((m_errorCode == IsoAgLib::fsSuccess) && !cb_complete)
+    readDirectory(m_fileHandle, CONFIG_FS_CLIENT_PREFETCH_COUNT, m_prefetchHidden);
+  else
+    closeFile(m_fileHandle);
+}
+
+
+void
+FsCommand_c::finishPrefetch(IsoAgLib::iFsError errorCode)
+{
+  m_prefetch = false;
+  m_FSCSComm.prefetchDirectoryResponse(errorCode, (const uint8_t *)m_prefetchPath.c_str());
+}
+
+
 void
 FsCommand_c::doCleanUp()
 {
@@ -1272,7 +1726,7 @@ FsCommand_c::doCleanUp()
   }
   m_dataAllocSize = 0;
 
-  clearDirectoryList();
+  m_dirListing.release();
 }
 
 
@@ -1283,6 +1737,7 @@ FsCommand_c::readFile(uint8_t fileHandle, uint16_t count, bool reportHiddenFiles
 
   m_fileHandle = fileHandle;
   m_count = count;
+  m_reportHiddenFiles = reportHiddenFiles;
   uint8_t ui8_bufferPosition = 0;
 
   m_sendMsgBuf[ui8_bufferPosition++] = en_lastCommand;
@@ -1307,6 +1762,10 @@ void
 FsCommand_c::reactOnStateChange(const SendStream_c& sendStream)
 {
   m_sendSuccessNotify = sendStream.getSendSuccess();
+
+  // start the response time-out or retry without waiting for the next period
+  if( m_waitForMultiSendFinish && m_schedulerTask.isRegistered() && ( m_sendSuccessNotify != SendStream_c::Running ) )
+    m_schedulerTask.trigger();
 }
 
 } // __IsoAgLib
@@ -84,14 +84,25 @@ class FsCommand_c : CanCustomer_c
     void decodeGetCurrentDirectoryResponse();
     void decodeReadFileResponse();
     void decodeReadDirectoryResponse();
+    void decodeGetFileDateTimeResponse(uint8_t errorCode, uint16_t date, uint16_t time);
+
+    /** forward a read directory response or continue the initialization/prefetch with it **/
+    void processReadDirectoryResponse();
 
     /** clean up when done **/
-    void clearDirectoryList();
     void doCleanUp();
 
     /** internal read file use for read file and read directory **/
     IsoAgLib::iFsCommandErrors readFile(uint8_t fileHandle, uint16_t count, bool b_reportHiddenFiles);
 
+    /** streaming read: request the next block, hand over response data **/
+    uint16_t streamReadSize();
+    void requestStreamRead();
+    void deliverStreamData(StreamInput_c& data, uint16_t length);
+    /** account a complete response and request the next block if needed
+        @return true if the streaming read is finished (m_errorCode is its result) **/
+    bool streamResponseReceived();
+
     /** which command are we sending? **/
     enum commandtype_en
     {
@@ -115,10 +126,30 @@ class FsCommand_c : CanCustomer_c
 
     commandtype_en finishCommand();
 
+    /** metadata cache: the absolute path of the name, empty if not cacheable **/
+    FsMetadataCache_c &metadataCache() { return getFileserver().getMetadataCache(); }
+    void cachePath(const uint8_t *name, STL_NAMESPACE::string &path);
+    /** answer the command from the metadata cache in the next timeEvent()
+        @return false if nothing is cached for the path **/
+    bool respondFromCache(commandtype_en command);
+    void deliverCachedResponse();
+    /** path and written flag of the open files, to invalidate the cache on writes **/
+    struct OpenPath_s
+    {
+      uint8_t handle;
+      bool written;
+      STL_NAMESPACE::string path;
+    };
+    OpenPath_s *findOpenPath(uint8_t fileHandle);
+
+    /** directory prefetch: read the next entries or close, report the end **/
+    void prefetchReadResponse();
+    void finishPrefetch(IsoAgLib::iFsError errorCode);
+
   public:
 
-    /** is the command busy, meaning waiting for a response? **/
-    bool isBusy() { return !m_receivedResponse; }
+    /** is the command busy, meaning waiting for a response or streaming a file? **/
+    bool isBusy() { return !m_receivedResponse || m_streamRead; }
 
     /** time event function. If no response received, resend request periodically. **/
     void timeEvent(void);
@@ -180,6 +211,17 @@ class FsCommand_c : CanCustomer_c
       * @return 0 if request was sent without problems, else an errorcode is returned.
       */
     IsoAgLib::iFsCommandErrors readFile(uint8_t fileHandle, uint16_t count);
+    /**
+      * read content of a file as a stream of blocks of up to
+      * CONFIG_FS_CLIENT_STREAM_READ_SIZE bytes. The next block is requested
+      * as soon as the previous response is complete, the data of each
+      * received TP/ETP burst is handed to the client directly from the
+      * receive stream via readFileStreamData().
+      * @param fileHandle filehandle of the file to be read.
+      * @param count number of bytes to be read, 0xFFFFFFFF till the end of the file.
+      * @return 0 if request was sent without problems, else an errorcode is returned.
+      */
+    IsoAgLib::iFsCommandErrors readFileStream(uint8_t fileHandle, uint32_t count);
     /**
       * read content of a directory
       * @param fileHandle directoryhandle of the directory to be read.
@@ -196,6 +238,19 @@ class FsCommand_c : CanCustomer_c
       * @return 0 if request was sent without problems, else an errorcode is returned.
       */
     IsoAgLib::iFsCommandErrors writeFile(uint8_t fileHandle, uint16_t count, const uint8_t *data);
+    /**
+      * write data to a file without copying it to the command's send buffer,
+      * so more than CONFIG_FS_CLIENT_MAX_WRITE_SIZE bytes can be written at once.
+      * @param fileHandle filehandle of the file to be written.
+      * @param count number of bytes to be written, at most maxWriteSize().
+      * @param buffer 5 bytes for the command header followed by the data. It has
+      *        to stay untouched until the write file response was forwarded.
+      * @return 0 if request was sent without problems, else an errorcode is returned.
+      */
+    IsoAgLib::iFsCommandErrors writeFileFromBuffer(uint8_t fileHandle, uint16_t count, uint8_t *buffer);
+    /** maximum number of bytes for one write file request: requests larger
+        than 1785 bytes need ETP, which file servers before the IS version don't take. **/
+    uint16_t maxWriteSize();
     /**
       * close a file
       * @param fileHandle filehandle of the file to be closed.
@@ -242,6 +297,15 @@ class FsCommand_c : CanCustomer_c
       */
     IsoAgLib::iFsCommandErrors getFileDateTime(uint8_t *fileName);
 
+    /**
+      * read all entries of a directory into the metadata cache (open, read directory, close),
+      * the end is reported by FsClientServerCommunication_c::prefetchDirectoryResponse().
+      * @param directoryName name of the directory.
+      * @param reportHiddenFiles shall hidden files of the directory be read, too?
+      * @return 0 if request was sent without problems, else an errorcode is returned.
+      */
+    IsoAgLib::iFsCommandErrors prefetchDirectory(uint8_t *directoryName, bool reportHiddenFiles);
+
     /**
       * initialize volume
       * @param pathName pathname for the directory.
@@ -297,8 +361,9 @@ class FsCommand_c : CanCustomer_c
     ecutime_t m_lastAliveSentTime;
     static uint8_t m_maintenanceMsgBuf[8];
 
-    uint8_t m_packetLength;
+    uint32_t m_packetLength;
     uint8_t m_sendMsgBuf[CONFIG_FS_CLIENT_MAX_WRITE_SIZE + 16]; // 16 for command bytes overhead in message
+    const uint8_t *m_sendData; // m_sendMsgBuf or the buffer of writeFileFromBuffer()
     uint8_t *m_multireceiveMsgBuf;
     uint32_t m_multireceiveMsgBufAllocSize;
     int32_t m_multireceiveMsgBufOffset;
@@ -340,9 +405,33 @@ class FsCommand_c : CanCustomer_c
     uint16_t m_count;
     uint8_t *m_data;
     uint16_t m_dataAllocSize;
-    IsoAgLib::iFsDirList m_dirData;
+    FsDirectoryListing_c m_dirListing;
     bool m_readDirectory;
-
+    bool m_reportHiddenFiles;
+
+    /** streaming read information */
+    bool m_streamRead;
+    uint32_t m_streamRemaining; // 0xFFFFFFFF: till the end of the file
+    uint32_t m_streamDelivered; // of all blocks
+    uint16_t m_streamResponseCount; // data bytes in the current response
+    uint16_t m_streamResponseParsed; // in this transmission of the current response
+    uint16_t m_streamResponseDelivered; // of the current response, a retransmission skips them
+
+    /** metadata cache information **/
+    STL_NAMESPACE::string m_cachePath; // of the current command, empty if not cacheable
+    STL_NAMESPACE::string m_cachePath2; // destination of move file
+    bool m_cacheCreate; // open file may create the file
+    bool m_cachedResponse; // answer from the cache in the next timeEvent()
+    uint16_t m_cachedDate;
+    uint16_t m_cachedTime;
+    STL_NAMESPACE::vector<OpenPath_s> m_openPaths;
+
+    /** directory prefetch information **/
+    bool m_prefetch;
+    bool m_prefetchFirst;
+    bool m_prefetchHidden;
+    uint8_t m_prefetchError;
+    STL_NAMESPACE::string m_prefetchPath;
 
     /** filter information **/
     bool m_receiveFilterCreated;
@@ -0,0 +1,349 @@
+/*
+  fsfilewriter_c.cpp: write-behind buffered writing of a file
+    on a file server
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "fsfilewriter_c.h"
+#include "fsclientservercommunication_c.h"
+#include <IsoAgLib/scheduler/impl/scheduler_c.h>
+#include <IsoAgLib/util/iassert.h>
+
+#include <string.h>
+
+
+namespace __IsoAgLib {
+
+  // retry period if the FS communication is busy with another command
+  static const int32_t sci32_retryPeriod = 20;
+
+
+  FsFileWriter_c::FsFileWriter_c( FsClientServerCommunication_c& rc_fsCSComm, uint16_t aui16_bufferSize )
+    : SchedulerTask_c( CONFIG_FS_CLIENT_WRITE_BEHIND_PERIOD, false )
+    , mrc_fsCSComm( rc_fsCSComm )
+    , mui16_bufferSize( aui16_bufferSize )
+    , mui8_filling( 0 )
+    , mui16_capacity( 0 )
+    , mt_firstBuffered( 0 )
+    , mui8_fileHandle( 0 )
+    , mb_open( false )
+    , mb_inFlight( false )
+    , mb_flushRequested( false )
+    , mb_closeRequested( false )
+    , mb_retry( false )
+    , m_error( IsoAgLib::fsSuccess )
+    , mt_requestSent( 0 )
+    , mui32_roundTripTime( 0 )
+    , mui32_roundTrips( 0 )
+    , mui32_bytesWritten( 0 )
+  {
+    isoaglib_assert( aui16_bufferSize > 0 );
+    for( int i = 0; i < 2; ++i )
+    {
+      mpui8_buffer[ i ] = new uint8_t[ scui16_headerSize + aui16_bufferSize ];
+      mui16_fill[ i ] = 0;
+    }
+  }
+
+
+  FsFileWriter_c::~FsFileWriter_c()
+  {
+    // the request in flight is sent from the buffer
+    isoaglib_assert( !mb_inFlight );
+
+    if( mb_open )
+      detach();
+    if( isRegistered() )
+      getSchedulerInstance().deregisterTask( *this );
+
+    delete [] mpui8_buffer[ 0 ];
+    delete [] mpui8_buffer[ 1 ];
+  }
+
+
+  bool
+  FsFileWriter_c::open( uint8_t aui8_fileHandle )
+  {
+    if( mb_open )
+      return false;
+
+    const uint16_t cui16_maxWriteSize = mrc_fsCSComm.maxWriteSize();
+    if( ( cui16_maxWriteSize == 0 ) || !mrc_fsCSComm.attachFileWriter( *this ) )
+      return false;
+
+    mui16_capacity = ( mui16_bufferSize < cui16_maxWriteSize ) ? mui16_bufferSize : cui16_maxWriteSize;
+    mui16_fill[ 0 ] = 0;
+    mui16_fill[ 1 ] = 0;
+    mui8_filling = 0;
+    mui8_fileHandle = aui8_fileHandle;
+    mb_open = true;
+    mb_inFlight = false;
+    mb_flushRequested = false;
+    mb_closeRequested = false;
+    mb_retry = false;
+    m_error = IsoAgLib::fsSuccess;
+
+    mui32_roundTripTime = 0;
+    mui32_roundTrips = 0;
+    mui32_bytesWritten = 0;
+    return true;
+  }
+
+
+  uint32_t
+  FsFileWriter_c::write( const uint8_t* apui8_data, uint32_t aui32_length )
+  {
+    if( !mb_open || mb_closeRequested || ( m_error != IsoAgLib::fsSuccess ) )
+      return 0;
+
+    const ecutime_t now = System_c::getTime();
+    uint32_t ui32_taken = 0;
+    while( ui32_taken < aui32_length )
+    {
+      uint16_t& rui16_fill = mui16_fill[ mui8_filling ];
+      if( rui16_fill >= mui16_capacity )
+      { // full: gets sent (and the buffers swapped) unless one is in flight
+        process( now );
+        if( mui16_fill[ mui8_filling ] >= mui16_capacity )
+          break;
+        continue;
+      }
+
+      if( rui16_fill == 0 )
+        mt_firstBuffered = now;
+
+      uint32_t ui32_size = uint32_t( mui16_capacity - rui16_fill );
+      if( ui32_size > aui32_length - ui32_taken )
+        ui32_size = aui32_length - ui32_taken;
+
+      memcpy( data( mui8_filling ) + rui16_fill, apui8_data + ui32_taken, ui32_size );
+      rui16_fill = uint16_t( rui16_fill + ui32_size );
+      ui32_taken += ui32_size;
+    }
+
+    process( now );
+    return ui32_taken;
+  }
+
+
+  void
+  FsFileWriter_c::flush()
+  {
+    if( !mb_open || ( m_error != IsoAgLib::fsSuccess ) )
+      return;
+
+    mb_flushRequested = true;
+    process( System_c::getTime() );
+  }
+
+
+  void
+  FsFileWriter_c::close()
+  {
+    if( !mb_open )
+      return;
+
+    mb_closeRequested = true;
+    if( m_error == IsoAgLib::fsSuccess )
+      mb_flushRequested = true;
+    process( System_c::getTime() );
+  }
+
+
+  uint32_t
+  FsFileWriter_c::getFreeSpace() const
+  {
+    if( !mb_open || mb_closeRequested || ( m_error != IsoAgLib::fsSuccess ) )
+      return 0;
+
+    return uint32_t( mui16_capacity - mui16_fill[ mui8_filling ] );
+  }
+
+
+  int32_t
+  FsFileWriter_c::getAverageRoundTripTime() const
+  {
+    return ( mui32_roundTrips > 0 ) ? int32_t( mui32_roundTripTime / mui32_roundTrips ) : 0;
+  }
+
+
+  uint32_t
+  FsFileWriter_c::getThroughput() const
+  {
+    if( mui32_roundTripTime == 0 )
+      return 0;
+
+    return uint32_t( ( uint64_t( mui32_bytesWritten ) * 1000 ) / mui32_roundTripTime );
+  }
+
+
+  bool
+  FsFileWriter_c::writeFileResponse( IsoAgLib::iFsError ae_error, uint16_t aui16_dataWritten )
+  {
+    if( !mb_inFlight )
+      return false;
+
+    const ecutime_t now = System_c::getTime();
+    const uint8_t cui8_sent = uint8_t( mui8_filling ^ 1 );
+
+    mb_inFlight = false;
+    ++mui32_roundTrips;
+    mui32_roundTripTime += uint32_t( now - mt_requestSent );
+    mui32_bytesWritten += aui16_dataWritten;
+
+    if( ( ae_error == IsoAgLib::fsSuccess ) && ( aui16_dataWritten < mui16_fill[ cui8_sent ] ) )
+      ae_error = IsoAgLib::fsFailureDuringAWriteOperation;
+    mui16_fill[ cui8_sent ] = 0;
+
+    if( ae_error == IsoAgLib::fsSuccess )
+    {
+      process( now );
+      return true;
+    }
+
+    // stop writing, the buffered data is dropped. A requested close is still done.
+    m_error = ae_error;
+    mb_flushRequested = false;
+    mui16_fill[ mui8_filling ] = 0;
+    process( now );
+
+    mrc_fsCSComm.fileWriterResponse( m_error, mui32_bytesWritten );
+    return true;
+  }
+
+
+  void
+  FsFileWriter_c::abort( IsoAgLib::iFsError ae_error, bool ab_notify )
+  {
+    if( !mb_open )
+      return;
+
+    const bool cb_notify = ab_notify && ( m_error == IsoAgLib::fsSuccess );
+
+    m_error = ae_error;
+    mb_inFlight = false;
+    mb_flushRequested = false;
+    mb_closeRequested = false;
+    mui16_fill[ 0 ] = 0;
+    mui16_fill[ 1 ] = 0;
+    detach();
+    schedule( System_c::getTime() );
+
+    if( cb_notify )
+      mrc_fsCSComm.fileWriterResponse( m_error, mui32_bytesWritten );
+  }
+
+
+  void
+  FsFileWriter_c::timeEvent()
+  {
+    process( System_c::getTime() );
+  }
+
+
+  void
+  FsFileWriter_c::process( ecutime_t now )
+  {
+    bool b_flushed = false;
+    mb_retry = false;
+
+    if( mb_open && !mb_inFlight && ( m_error == IsoAgLib::fsSuccess ) )
+    {
+      const uint16_t cui16_fill = mui16_fill[ mui8_filling ];
+      if( cui16_fill == 0 )
+      {
+        if( mb_flushRequested )
+        { // everything is written
+          mb_flushRequested = false;
+          b_flushed = true;
+        }
+      }
+      else if( ( cui16_fill >= mui16_capacity ) || mb_flushRequested
+            || ( now - mt_firstBuffered >= CONFIG_FS_CLIENT_WRITE_BEHIND_PERIOD ) )
+      {
+        mb_retry = !startWrite( now );
+      }
+    }
+
+    if( mb_open && mb_closeRequested && !mb_inFlight && !mb_flushRequested )
+    { // everything is written or it failed
+      if( mrc_fsCSComm.closeFile( mui8_fileHandle ) == IsoAgLib::fsCommandNoError )
+        detach();
+      else
+        mb_retry = true;
+    }
+
+    schedule( now );
+
+    // last, as the application may write again from the callback
+    if( b_flushed )
+      mrc_fsCSComm.fileWriterResponse( m_error, mui32_bytesWritten );
+  }
+
+
+  bool
+  FsFileWriter_c::startWrite( ecutime_t now )
+  {
+    if( mrc_fsCSComm.writeFileFromBuffer( mui8_fileHandle, mui16_fill[ mui8_filling ], mpui8_buffer[ mui8_filling ] ) != IsoAgLib::fsCommandNoError )
+      return false;
+
+    mb_inFlight = true;
+    mt_requestSent = now;
+    // the other buffer is empty, as its response was received
+    mui8_filling = uint8_t( mui8_filling ^ 1 );
+    return true;
+  }
+
+
+  void
+  FsFileWriter_c::schedule( ecutime_t now )
+  {
+    int32_t i32_delay = -1;
+    if( mb_open && !mb_inFlight )
+    {
+      if( mb_retry )
+        i32_delay = sci32_retryPeriod;
+      else if( ( m_error == IsoAgLib::fsSuccess ) && ( mui16_fill[ mui8_filling ] > 0 ) )
+      {
+        i32_delay = int32_t( mt_firstBuffered + CONFIG_FS_CLIENT_WRITE_BEHIND_PERIOD - now );
+        if( i32_delay < 0 )
+          i32_delay = 0;
+      }
+    }
+
+    if( i32_delay < 0 )
+    {
+      if( isRegistered() )
+        getSchedulerInstance().deregisterTask( *this );
+      return;
+    }
+
+    if( !isRegistered() )
+      getSchedulerInstance().registerTask( *this, i32_delay );
+    else
+      setNextTriggerTime( now + i32_delay );
+  }
+
+
+  void
+  FsFileWriter_c::detach()
+  {
+    mb_open = false;
+    mrc_fsCSComm.detachFileWriter( *this );
+  }
+
+}
@@ -0,0 +1,139 @@
+/*
+  fsfilewriter_c.h: write-behind buffered writing of a file
+    on a file server
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef FSFILEWRITER_C_H
+#define FSFILEWRITER_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <IsoAgLib/scheduler/impl/schedulertask_c.h>
+#include "../ifsstructs.h"
+
+
+namespace __IsoAgLib {
+
+class FsClientServerCommunication_c;
+
+
+/** Collects the application's writes to a file in two buffers. One is
+    written as a single (E)TP Write File request as soon as it is full,
+    on flush()/close() or at the latest CONFIG_FS_CLIENT_WRITE_BEHIND_PERIOD
+    after its first byte, while the other one is being filled. So there's
+    at most one write in flight, and write() only refuses data while both
+    buffers are busy.
+    The data of a request is sent directly from the buffer, which has room
+    for the command header in front (FsCommand_c::writeFileFromBuffer()).
+    The write file responses go to the writer instead of the iFsClient_c
+    while it is open. The first write error, a short write or a lost file
+    server stops the writer and is reported by iFsClient_c::fileWriterResponse(),
+    as is the completion of flush() and close().
+  */
+class FsFileWriter_c : public SchedulerTask_c
+{
+public:
+  FsFileWriter_c( FsClientServerCommunication_c& rc_fsCSComm, uint16_t aui16_bufferSize );
+  virtual ~FsFileWriter_c();
+
+  /** start writing to the file, which has to be opened for writing already.
+      The statistics are restarted.
+      @return false if still writing another file or if another writer
+              is open on the same FsClientServerCommunication_c */
+  bool open( uint8_t aui8_fileHandle );
+
+  /** take as much of the data as fits into the buffer being filled
+      @return number of bytes taken, 0 after an error */
+  uint32_t write( const uint8_t* apui8_data, uint32_t aui32_length );
+
+  /** write the buffered data now, fileWriterResponse() follows once it is */
+  void flush();
+
+  /** flush and close the file. After fileWriterResponse() the file is
+      closed via the FsClientServerCommunication_c, so closeFileResponse()
+      follows. After an error the file is closed right away. */
+  void close();
+
+  bool isOpen() const { return mb_open; }
+  //! nothing is buffered and no write is in flight
+  bool isIdle() const { return !mb_inFlight && ( mui16_fill[ mui8_filling ] == 0 ); }
+  //! number of bytes write() takes right now
+  uint32_t getFreeSpace() const;
+  IsoAgLib::iFsError getError() const { return m_error; }
+
+  //! statistics since open()
+  uint32_t getBytesWritten() const { return mui32_bytesWritten; }
+  uint32_t getNumRoundTrips() const { return mui32_roundTrips; }
+  //! time from sending a request till its response (incl. the transfer)
+  int32_t getAverageRoundTripTime() const;
+  //! bytes per second while a write was in flight
+  uint32_t getThroughput() const;
+
+  /** called by FsClientServerCommunication_c
+      @return false if the response isn't for a write of this writer */
+  bool writeFileResponse( IsoAgLib::iFsError ae_error, uint16_t aui16_dataWritten );
+
+  /** the file server is gone (or the communication destroyed):
+      stop and detach, optionally reporting the error to the iFsClient_c */
+  void abort( IsoAgLib::iFsError ae_error, bool ab_notify );
+
+private:
+  virtual void timeEvent();
+
+  /** start what is due, then (re)schedule and report */
+  void process( ecutime_t now );
+  bool startWrite( ecutime_t now );
+  void schedule( ecutime_t now );
+  void detach();
+
+  uint8_t* data( uint8_t aui8_buffer ) { return mpui8_buffer[ aui8_buffer ] + scui16_headerSize; }
+
+  static const uint16_t scui16_headerSize = 5;
+
+private:
+  FsClientServerCommunication_c& mrc_fsCSComm;
+
+  const uint16_t mui16_bufferSize;
+  uint8_t* mpui8_buffer[ 2 ]; // header space followed by the data
+  uint16_t mui16_fill[ 2 ];
+  uint8_t mui8_filling; // the other one is in flight if mb_inFlight
+  uint16_t mui16_capacity; // per request, limited by the file server's version
+  ecutime_t mt_firstBuffered; // of the buffer being filled
+
+  uint8_t mui8_fileHandle;
+  bool mb_open;
+  bool mb_inFlight;
+  bool mb_flushRequested;
+  bool mb_closeRequested;
+  bool mb_retry; // the FS communication was busy
+  IsoAgLib::iFsError m_error;
+
+  ecutime_t mt_requestSent;
+  uint32_t mui32_roundTripTime; // sum
+  uint32_t mui32_roundTrips;
+  uint32_t mui32_bytesWritten;
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  FsFileWriter_c( const FsFileWriter_c& );
+  /** not copyable : copy operator is only declared, never defined */
+  FsFileWriter_c& operator=( const FsFileWriter_c& );
+};
+
+}
+
+#endif
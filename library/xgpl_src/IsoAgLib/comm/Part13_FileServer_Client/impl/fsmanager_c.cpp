@@ -244,7 +244,10 @@ FsManager_c::notifyOnFileserverStateChange(FsServerInstance_c &fileserver, FsSer
       break;
 
     case FsServerInstance_c::usablePending:
-      // nothing to do here, FsServer-instance needs to change to usable in its timeEvent
+      // FsServer-instance needs to change to usable in its timeEvent,
+      // but that can be right after the current CAN processing
+      if( isRegistered() )
+        trigger();
       break;
 
     case FsServerInstance_c::usable:
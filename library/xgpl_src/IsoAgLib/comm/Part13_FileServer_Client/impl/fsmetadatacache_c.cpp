@@ -0,0 +1,518 @@
+/*
+  fsmetadatacache_c.cpp: file attributes and directory listings
+    of a file server, kept for a short time by the FS client
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "fsmetadatacache_c.h"
+
+#include <string.h>
+
+
+namespace __IsoAgLib {
+
+  static inline char toUpper( char c )
+  {
+    return ( ( c >= 'a' ) && ( c <= 'z' ) ) ? char( c - 'a' + 'A' ) : c;
+  }
+
+
+  /** split the absolute path into its directory and the name in it
+      @return false for the root "\\" */
+  static bool splitPath( const STL_NAMESPACE::string& rstr_path, STL_NAMESPACE::string& rstr_directory, STL_NAMESPACE::string& rstr_name )
+  {
+    if( rstr_path.size() <= 2 )
+      return false;
+
+    const STL_NAMESPACE::string::size_type pos = rstr_path.rfind( '\\' );
+    rstr_directory.assign( rstr_path, 0, ( pos < 2 ) ? 2 : pos );
+    rstr_name.assign( rstr_path, pos + 1, STL_NAMESPACE::string::npos );
+    return true;
+  }
+
+
+  /** file server names are not case sensitive, unless the server reports
+      that for the volume */
+  static bool samePath( const STL_NAMESPACE::string& rstr_a, const STL_NAMESPACE::string& rstr_b, bool ab_caseSensitive,
+                        STL_NAMESPACE::string::size_type a_length = STL_NAMESPACE::string::npos )
+  {
+    if( a_length == STL_NAMESPACE::string::npos )
+    {
+      if( rstr_a.size() != rstr_b.size() )
+        return false;
+      a_length = rstr_a.size();
+    }
+    else if( ( rstr_a.size() < a_length ) || ( rstr_b.size() < a_length ) )
+      return false;
+
+    if( ab_caseSensitive )
+      return rstr_a.compare( 0, a_length, rstr_b, 0, a_length ) == 0;
+
+    for( STL_NAMESPACE::string::size_type i = 0; i < a_length; ++i )
+    {
+      if( toUpper( rstr_a[ i ] ) != toUpper( rstr_b[ i ] ) )
+        return false;
+    }
+    return true;
+  }
+
+
+  // ignores the case, so invalidating forgets too much rather than too little
+  static bool isBelow( const STL_NAMESPACE::string& rstr_path, const STL_NAMESPACE::string& rstr_parent )
+  {
+    if( !samePath( rstr_path, rstr_parent, false, rstr_parent.size() ) )
+      return false;
+
+    return ( rstr_path.size() == rstr_parent.size() )
+        || ( rstr_parent.size() <= 2 ) // everything is below the root
+        || ( rstr_path[ rstr_parent.size() ] == '\\' );
+  }
+
+
+  void
+  FsDirectoryListing_c::clear()
+  {
+    mvec_entries.clear();
+    mvec_nameOffsets.clear();
+    mvec_names.clear();
+    mvec_list.clear();
+  }
+
+
+  void
+  FsDirectoryListing_c::release()
+  {
+    STL_NAMESPACE::vector<IsoAgLib::iFsDirectory>().swap( mvec_entries );
+    STL_NAMESPACE::vector<uint32_t>().swap( mvec_nameOffsets );
+    STL_NAMESPACE::vector<uint8_t>().swap( mvec_names );
+    IsoAgLib::iFsDirList().swap( mvec_list );
+  }
+
+
+  void
+  FsDirectoryListing_c::add( const uint8_t* pui8_name, uint8_t ui8_nameLength, uint8_t ui8_attributes,
+                             uint16_t ui16_date, uint16_t ui16_time, uint32_t ui32_size )
+  {
+    IsoAgLib::iFsDirectory s_entry;
+    s_entry.pui8_filename = NULL;
+    decodeAttributes( ui8_attributes, s_entry );
+    s_entry.ui16_date = ui16_date;
+    s_entry.ui16_time = ui16_time;
+    s_entry.ui32_size = ui32_size;
+    mvec_entries.push_back( s_entry );
+
+    mvec_nameOffsets.push_back( uint32_t( mvec_names.size() ) );
+    mvec_names.insert( mvec_names.end(), pui8_name, pui8_name + ui8_nameLength );
+    mvec_names.push_back( 0 );
+  }
+
+
+  void
+  FsDirectoryListing_c::add( const IsoAgLib::iFsDirList& rc_list )
+  {
+    for( IsoAgLib::iFsDirList::const_iterator it = rc_list.begin(); it != rc_list.end(); ++it )
+    {
+      const size_t len = strlen( (const char*)( *it )->pui8_filename );
+      add( ( *it )->pui8_filename, uint8_t( ( len > 0xFF ) ? 0xFF : len ), encodeAttributes( **it ),
+           ( *it )->ui16_date, ( *it )->ui16_time, ( *it )->ui32_size );
+    }
+  }
+
+
+  int
+  FsDirectoryListing_c::find( const char* pc_name, unsigned ui_nameLength ) const
+  {
+    for( unsigned i = 0; i < mvec_entries.size(); ++i )
+    {
+      const char* pc_entry = (const char*)&mvec_names[ mvec_nameOffsets[ i ] ];
+      if( strlen( pc_entry ) != ui_nameLength )
+        continue;
+
+      unsigned n = 0;
+      if( mvec_entries[ i ].b_caseSensitive )
+      {
+        while( ( n < ui_nameLength ) && ( pc_entry[ n ] == pc_name[ n ] ) )
+          ++n;
+      }
+      else
+      {
+        while( ( n < ui_nameLength ) && ( toUpper( pc_entry[ n ] ) == toUpper( pc_name[ n ] ) ) )
+          ++n;
+      }
+      if( n == ui_nameLength )
+        return int( i );
+    }
+    return -1;
+  }
+
+
+  const IsoAgLib::iFsDirectory&
+  FsDirectoryListing_c::entry( unsigned ui_index )
+  {
+    IsoAgLib::iFsDirectory& rs_entry = mvec_entries[ ui_index ];
+    rs_entry.pui8_filename = &mvec_names[ mvec_nameOffsets[ ui_index ] ];
+    return rs_entry;
+  }
+
+
+  const IsoAgLib::iFsDirList&
+  FsDirectoryListing_c::list()
+  {
+    mvec_list.clear();
+    for( unsigned i = 0; i < mvec_entries.size(); ++i )
+      mvec_list.push_back( const_cast<IsoAgLib::iFsDirectory*>( &entry( i ) ) );
+    return mvec_list;
+  }
+
+
+  uint8_t
+  FsDirectoryListing_c::encodeAttributes( const IsoAgLib::iFsDirectory& rc_entry )
+  {
+    return uint8_t( ( rc_entry.b_caseSensitive ? 0x80 : 0 )
+                  | ( rc_entry.b_removable ? 0 : 0x40 )
+                  | ( rc_entry.b_longFilenames ? 0x20 : 0 )
+                  | ( rc_entry.b_isDirectory ? 0x10 : 0 )
+                  | ( rc_entry.b_isVolume ? 0x08 : 0 )
+                  | ( rc_entry.b_hidden ? 0x02 : 0 )
+                  | ( rc_entry.b_readOnly ? 0x01 : 0 ) );
+  }
+
+
+  void
+  FsDirectoryListing_c::decodeAttributes( uint8_t ui8_attributes, IsoAgLib::iFsDirectory& rc_entry )
+  {
+    rc_entry.b_caseSensitive = ( ( ui8_attributes & 0x80 ) != 0 );
+    rc_entry.b_removable = ( ( ui8_attributes & 0x40 ) == 0 );
+    rc_entry.b_longFilenames = ( ( ui8_attributes & 0x20 ) != 0 );
+    rc_entry.b_isDirectory = ( ( ui8_attributes & 0x10 ) != 0 );
+    rc_entry.b_isVolume = ( ( ui8_attributes & 0x08 ) != 0 );
+    rc_entry.b_hidden = ( ( ui8_attributes & 0x02 ) != 0 );
+    rc_entry.b_readOnly = ( ( ui8_attributes & 0x01 ) != 0 );
+  }
+
+
+  bool
+  FsMetadataCache_c::absolutePath( const uint8_t* pui8_currentDirectory, const uint8_t* pui8_name, STL_NAMESPACE::string& rstr_path )
+  {
+    const char* pc_name = (const char*)pui8_name;
+    const char* pc_current = (const char*)pui8_currentDirectory;
+    rstr_path.clear();
+
+    if( pc_name == NULL )
+      return false;
+
+    if( ( pc_name[ 0 ] == '\\' ) && ( pc_name[ 1 ] == '\\' ) )
+    {
+      rstr_path = "\\\\";
+      pc_name += 2;
+    }
+    else
+    {
+      if( ( pc_current == NULL ) || ( pc_current[ 0 ] != '\\' ) || ( pc_current[ 1 ] != '\\' ) || ( pc_name[ 0 ] == '~' ) )
+        return false;
+
+      if( pc_name[ 0 ] == '\\' )
+      { // on the volume of the current directory
+        const char* pc_volumeEnd = strchr( pc_current + 2, '\\' );
+        rstr_path.assign( pc_current, pc_volumeEnd ? size_t( pc_volumeEnd - pc_current ) : strlen( pc_current ) );
+        ++pc_name;
+      }
+      else
+        rstr_path = pc_current;
+
+      if( ( rstr_path.size() > 2 ) && ( rstr_path[ rstr_path.size() - 1 ] == '\\' ) )
+        rstr_path.erase( rstr_path.size() - 1 );
+    }
+
+    while( *pc_name != 0 )
+    {
+      const char* pc_end = strchr( pc_name, '\\' );
+      const size_t len = pc_end ? size_t( pc_end - pc_name ) : strlen( pc_name );
+
+      if( ( len == 0 ) || ( ( len == 1 ) && ( pc_name[ 0 ] == '.' ) ) )
+        ; // nothing to add
+      else if( ( len == 2 ) && ( pc_name[ 0 ] == '.' ) && ( pc_name[ 1 ] == '.' ) )
+      {
+        if( rstr_path.size() <= 2 )
+          return false;
+        const STL_NAMESPACE::string::size_type pos = rstr_path.rfind( '\\' );
+        rstr_path.erase( ( pos < 2 ) ? 2 : pos );
+      }
+      else
+      {
+        if( rstr_path.size() > 2 )
+          rstr_path += '\\';
+        rstr_path.append( pc_name, len );
+      }
+
+      pc_name += len;
+      if( *pc_name != 0 )
+        ++pc_name;
+    }
+
+    // neither the removable media volume nor wildcards name a fixed file
+    if( ( rstr_path.size() > 2 ) && ( rstr_path[ 2 ] == '~' ) )
+      return false;
+    if( rstr_path.find_first_of( "*?" ) != STL_NAMESPACE::string::npos )
+      return false;
+
+    return true;
+  }
+
+
+  uint8_t
+  FsMetadataCache_c::lookup( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, Info_s& rs_info )
+  {
+    rs_info.ui8_valid = 0;
+    if( rstr_path.empty() )
+      return 0;
+
+    for( STL_NAMESPACE::vector<File_s>::const_iterator it = mvec_files.begin(); it != mvec_files.end(); ++it )
+    {
+      if( samePath( it->str_path, rstr_path, isCaseSensitive( *it ) ) && isFresh( it->t_time, at_now ) )
+      {
+        rs_info = it->s_info;
+        break;
+      }
+    }
+    if( rs_info.ui8_valid == ( ValidAttributes | ValidDateTime ) )
+      return rs_info.ui8_valid;
+
+    // else look into the listing of its directory
+    STL_NAMESPACE::string str_directory, str_name;
+    if( !splitPath( rstr_path, str_directory, str_name ) )
+      return rs_info.ui8_valid;
+
+    for( STL_NAMESPACE::vector<Directory_s>::iterator it = mvec_directories.begin(); it != mvec_directories.end(); ++it )
+    {
+      if( !samePath( it->str_path, str_directory, isCaseSensitive( *it ) ) || !isFresh( it->t_time, at_now ) )
+        continue;
+
+      const int index = it->c_listing.find( str_name.c_str(), unsigned( str_name.size() ) );
+      if( index >= 0 )
+      {
+        const IsoAgLib::iFsDirectory& rc_entry = it->c_listing.entry( unsigned( index ) );
+        rs_info.ui8_error = IsoAgLib::fsSuccess;
+        rs_info.ui8_attributes = FsDirectoryListing_c::encodeAttributes( rc_entry );
+        rs_info.ui16_date = rc_entry.ui16_date;
+        rs_info.ui16_time = rc_entry.ui16_time;
+        rs_info.ui8_valid = ValidAttributes | ValidDateTime;
+      }
+      else if( it->b_complete && it->b_hidden && ( rs_info.ui8_valid == 0 ) )
+      {
+        rs_info.ui8_error = IsoAgLib::fsFileOrPathNotFound;
+        rs_info.ui8_attributes = 0;
+        rs_info.ui16_date = 0;
+        rs_info.ui16_time = 0;
+        rs_info.ui8_valid = ValidAttributes | ValidDateTime;
+      }
+      break;
+    }
+    return rs_info.ui8_valid;
+  }
+
+
+  void
+  FsMetadataCache_c::storeAttributes( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, uint8_t ui8_error, uint8_t ui8_attributes )
+  {
+    if( ( CONFIG_FS_CLIENT_METADATA_CACHE_TTL == 0 ) || rstr_path.empty() )
+      return;
+    if( ( ui8_error != IsoAgLib::fsSuccess ) && ( ui8_error != IsoAgLib::fsFileOrPathNotFound ) )
+      return;
+
+    File_s& rs_file = *fileSlot( rstr_path, at_now );
+    if( rs_file.s_info.ui8_error != ui8_error )
+      rs_file.s_info.ui8_valid = 0;
+    rs_file.s_info.ui8_error = ui8_error;
+    rs_file.s_info.ui8_attributes = ui8_attributes;
+    rs_file.s_info.ui8_valid |= ValidAttributes;
+  }
+
+
+  void
+  FsMetadataCache_c::storeDateTime( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, uint8_t ui8_error, uint16_t ui16_date, uint16_t ui16_time )
+  {
+    if( ( CONFIG_FS_CLIENT_METADATA_CACHE_TTL == 0 ) || rstr_path.empty() )
+      return;
+    if( ( ui8_error != IsoAgLib::fsSuccess ) && ( ui8_error != IsoAgLib::fsFileOrPathNotFound ) )
+      return;
+
+    File_s& rs_file = *fileSlot( rstr_path, at_now );
+    if( rs_file.s_info.ui8_error != ui8_error )
+      rs_file.s_info.ui8_valid = 0;
+    rs_file.s_info.ui8_error = ui8_error;
+    rs_file.s_info.ui16_date = ui16_date;
+    rs_file.s_info.ui16_time = ui16_time;
+    rs_file.s_info.ui8_valid |= ValidDateTime;
+  }
+
+
+  void
+  FsMetadataCache_c::storeListing( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, bool ab_hidden,
+                                   const IsoAgLib::iFsDirList& rc_entries, bool ab_restart, bool ab_complete )
+  {
+    if( ( CONFIG_FS_CLIENT_METADATA_CACHE_TTL == 0 ) || rstr_path.empty() )
+      return;
+
+    bool b_new;
+    Directory_s& rs_directory = *directorySlot( rstr_path, at_now, b_new );
+    if( ab_restart || b_new || ( rs_directory.b_hidden != ab_hidden ) || !isFresh( rs_directory.t_time, at_now ) )
+    {
+      // only a listing read from the start can become complete
+      if( !ab_restart )
+        ab_complete = false;
+      rs_directory.c_listing.clear();
+      rs_directory.t_time = at_now;
+      rs_directory.b_hidden = ab_hidden;
+    }
+    rs_directory.c_listing.add( rc_entries );
+    rs_directory.b_complete = ab_complete;
+  }
+
+
+  FsDirectoryListing_c*
+  FsMetadataCache_c::listing( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now )
+  {
+    for( STL_NAMESPACE::vector<Directory_s>::iterator it = mvec_directories.begin(); it != mvec_directories.end(); ++it )
+    {
+      if( samePath( it->str_path, rstr_path, isCaseSensitive( *it ) ) )
+        return ( it->b_complete && isFresh( it->t_time, at_now ) ) ? &it->c_listing : NULL;
+    }
+    return NULL;
+  }
+
+
+  void
+  FsMetadataCache_c::invalidate( const STL_NAMESPACE::string& rstr_path )
+  {
+    STL_NAMESPACE::string str_directory, str_name;
+    if( !splitPath( rstr_path, str_directory, str_name ) )
+    { // not cacheable or the root: anything may have changed
+      clear();
+      return;
+    }
+
+    for( unsigned i = 0; i < mvec_files.size(); )
+    {
+      if( isBelow( mvec_files[ i ].str_path, rstr_path ) )
+      {
+        mvec_files[ i ] = mvec_files.back();
+        mvec_files.pop_back();
+      }
+      else
+        ++i;
+    }
+
+    for( unsigned i = 0; i < mvec_directories.size(); )
+    {
+      if( isBelow( mvec_directories[ i ].str_path, rstr_path ) || samePath( mvec_directories[ i ].str_path, str_directory, false ) )
+      {
+        mvec_directories[ i ] = mvec_directories.back();
+        mvec_directories.pop_back();
+      }
+      else
+        ++i;
+    }
+  }
+
+
+  bool
+  FsMetadataCache_c::isCaseSensitive( const File_s& rs_file )
+  {
+    return ( rs_file.s_info.ui8_valid & ValidAttributes )
+        && ( rs_file.s_info.ui8_error == IsoAgLib::fsSuccess )
+        && ( rs_file.s_info.ui8_attributes & 0x80 );
+  }
+
+
+  bool
+  FsMetadataCache_c::isCaseSensitive( const Directory_s& rs_directory )
+  {
+    return rs_directory.c_listing.caseSensitive();
+  }
+
+
+  void
+  FsMetadataCache_c::clear()
+  {
+    mvec_files.clear();
+    mvec_directories.clear();
+  }
+
+
+  FsMetadataCache_c::File_s*
+  FsMetadataCache_c::fileSlot( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now )
+  {
+    File_s* ps_oldest = NULL;
+    for( STL_NAMESPACE::vector<File_s>::iterator it = mvec_files.begin(); it != mvec_files.end(); ++it )
+    {
+      if( samePath( it->str_path, rstr_path, isCaseSensitive( *it ) ) )
+      {
+        if( !isFresh( it->t_time, at_now ) )
+        {
+          it->t_time = at_now;
+          it->s_info.ui8_valid = 0;
+        }
+        return &*it;
+      }
+      if( ( ps_oldest == NULL ) || ( ( at_now - it->t_time ) > ( at_now - ps_oldest->t_time ) ) )
+        ps_oldest = &*it;
+    }
+
+    if( mvec_files.size() < CONFIG_FS_CLIENT_METADATA_CACHE_FILES )
+    {
+      mvec_files.push_back( File_s() );
+      ps_oldest = &mvec_files.back();
+    }
+
+    ps_oldest->str_path = rstr_path;
+    ps_oldest->t_time = at_now;
+    ps_oldest->s_info.ui8_error = IsoAgLib::fsSuccess;
+    ps_oldest->s_info.ui8_valid = 0;
+    return ps_oldest;
+  }
+
+
+  FsMetadataCache_c::Directory_s*
+  FsMetadataCache_c::directorySlot( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, bool& rb_new )
+  {
+    rb_new = false;
+    Directory_s* ps_oldest = NULL;
+    for( STL_NAMESPACE::vector<Directory_s>::iterator it = mvec_directories.begin(); it != mvec_directories.end(); ++it )
+    {
+      if( samePath( it->str_path, rstr_path, isCaseSensitive( *it ) ) )
+        return &*it;
+      if( ( ps_oldest == NULL ) || ( ( at_now - it->t_time ) > ( at_now - ps_oldest->t_time ) ) )
+        ps_oldest = &*it;
+    }
+
+    if( mvec_directories.size() < CONFIG_FS_CLIENT_METADATA_CACHE_DIRECTORIES )
+    {
+      mvec_directories.push_back( Directory_s() );
+      ps_oldest = &mvec_directories.back();
+    }
+
+    rb_new = true;
+    ps_oldest->str_path = rstr_path;
+    ps_oldest->t_time = at_now;
+    ps_oldest->b_hidden = false;
+    ps_oldest->b_complete = false;
+    ps_oldest->c_listing.clear();
+    return ps_oldest;
+  }
+
+} // __IsoAgLib
@@ -0,0 +1,170 @@
+/*
+  fsmetadatacache_c.h: file attributes and directory listings
+    of a file server, kept for a short time by the FS client
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef FSMETADATACACHE_C_H
+#define FSMETADATACACHE_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include "../ifsstructs.h"
+
+#include <string>
+#include <vector>
+
+
+namespace __IsoAgLib {
+
+/** Directory entries as read from a file server: the entries by value and
+    all names in one buffer, so reading a directory again reuses the memory
+    instead of allocating every entry and name anew.
+  */
+class FsDirectoryListing_c
+{
+public:
+  FsDirectoryListing_c() : mvec_entries(), mvec_nameOffsets(), mvec_names(), mvec_list() {}
+
+  /** remove the entries, keeping the memory */
+  void clear();
+  /** remove the entries and free the memory */
+  void release();
+
+  /** append an entry, the attributes as in the file server responses */
+  void add( const uint8_t* pui8_name, uint8_t ui8_nameLength, uint8_t ui8_attributes,
+            uint16_t ui16_date, uint16_t ui16_time, uint32_t ui32_size );
+  /** append entries of another list */
+  void add( const IsoAgLib::iFsDirList& rc_list );
+
+  unsigned size() const { return unsigned( mvec_entries.size() ); }
+  bool empty() const { return mvec_entries.empty(); }
+  /** @return the entries are on a case sensitive volume, false if empty */
+  bool caseSensitive() const { return !mvec_entries.empty() && mvec_entries.front().b_caseSensitive; }
+
+  /** @return index of the entry with the name, -1 if none. Names of not
+              case sensitive entries are compared ignoring the case. */
+  int find( const char* pc_name, unsigned ui_nameLength ) const;
+
+  /** entry with its file name, valid until this listing is changed */
+  const IsoAgLib::iFsDirectory& entry( unsigned ui_index );
+
+  /** the entries as needed for the iFsClient_c callbacks, valid until this
+      listing is changed */
+  const IsoAgLib::iFsDirList& list();
+
+  static uint8_t encodeAttributes( const IsoAgLib::iFsDirectory& rc_entry );
+  static void decodeAttributes( uint8_t ui8_attributes, IsoAgLib::iFsDirectory& rc_entry );
+
+private:
+  STL_NAMESPACE::vector<IsoAgLib::iFsDirectory> mvec_entries; // pui8_filename set by entry()/list()
+  STL_NAMESPACE::vector<uint32_t> mvec_nameOffsets;
+  STL_NAMESPACE::vector<uint8_t> mvec_names; // NUL-terminated
+  IsoAgLib::iFsDirList mvec_list;
+};
+
+
+/** Attributes, date/time and directory listings of one file server,
+    answered instead of the file server for CONFIG_FS_CLIENT_METADATA_CACHE_TTL.
+    The keys are absolute paths ("\\VOLUME\DIR\FILE") as made by absolutePath(),
+    compared ignoring the case unless the server reports a case sensitive volume.
+    A file that isn't cached itself is looked up in the listing of its
+    directory; a complete listing also tells that a file doesn't exist.
+    The FS clients invalidate what they change themselves, changes by other
+    clients of the file server are only noticed after the TTL.
+  */
+class FsMetadataCache_c
+{
+public:
+  enum Valid_en
+  {
+    ValidAttributes = 0x01,
+    ValidDateTime = 0x02
+  };
+
+  struct Info_s
+  {
+    uint8_t ui8_error; // IsoAgLib::iFsError
+    uint8_t ui8_attributes; // as in the file server responses
+    uint16_t ui16_date;
+    uint16_t ui16_time;
+    uint8_t ui8_valid; // Valid_en
+  };
+
+  FsMetadataCache_c() : mvec_files(), mvec_directories() {}
+
+  /** absolute path of the name (relative to the current directory or the
+      volume of it, if not absolute itself) with "." and ".." resolved.
+      @return false if that's not possible, e.g. for names on the removable
+              media volume ("~") or without an absolute current directory */
+  static bool absolutePath( const uint8_t* pui8_currentDirectory, const uint8_t* pui8_name, STL_NAMESPACE::string& rstr_path );
+
+  /** @return Valid_en of what's known about the path, 0 if nothing */
+  uint8_t lookup( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, Info_s& rs_info );
+
+  void storeAttributes( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, uint8_t ui8_error, uint8_t ui8_attributes );
+  void storeDateTime( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, uint8_t ui8_error, uint16_t ui16_date, uint16_t ui16_time );
+
+  /** store entries read from the directory
+      @param ab_restart start a new listing instead of appending to it
+      @param ab_complete all entries of the directory have been read */
+  void storeListing( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, bool ab_hidden,
+                     const IsoAgLib::iFsDirList& rc_entries, bool ab_restart, bool ab_complete );
+
+  /** complete listing of the directory, NULL if none */
+  FsDirectoryListing_c* listing( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now );
+
+  /** forget the path, all below it and the listing of its directory.
+      An empty path (not cacheable) forgets everything. */
+  void invalidate( const STL_NAMESPACE::string& rstr_path );
+
+  void clear();
+
+private:
+  struct File_s
+  {
+    STL_NAMESPACE::string str_path;
+    ecutime_t t_time;
+    Info_s s_info;
+  };
+
+  struct Directory_s
+  {
+    STL_NAMESPACE::string str_path;
+    ecutime_t t_time;
+    bool b_hidden;
+    bool b_complete;
+    FsDirectoryListing_c c_listing;
+  };
+
+  static bool isFresh( ecutime_t at_time, ecutime_t at_now )
+  { return ( at_now - at_time ) < CONFIG_FS_CLIENT_METADATA_CACHE_TTL; }
+
+  // paths are compared ignoring the case unless the server reported the
+  // volume to be case sensitive
+  static bool isCaseSensitive( const File_s& rs_file );
+  static bool isCaseSensitive( const Directory_s& rs_directory );
+
+  File_s* fileSlot( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now );
+  Directory_s* directorySlot( const STL_NAMESPACE::string& rstr_path, ecutime_t at_now, bool& rb_new );
+
+  STL_NAMESPACE::vector<File_s> mvec_files;
+  STL_NAMESPACE::vector<Directory_s> mvec_directories;
+};
+
+} // __IsoAgLib
+
+#endif
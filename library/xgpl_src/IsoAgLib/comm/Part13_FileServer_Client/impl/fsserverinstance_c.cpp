@@ -45,6 +45,7 @@ FsServerInstance_c::FsServerInstance_c(const IsoItem_c &pref_newItem, FsManager_
   , ui8_capabilities(0)
   , v_volumes()
   , men_state(offline)
+  , mc_metadataCache()
 {
 #if DEBUG_FILESERVER
   INTERNAL_DEBUG_DEVICE << "Fileserver created offline (received Address Claim)." << INTERNAL_DEBUG_DEVICE_ENDL;
@@ -177,6 +178,10 @@ FsServerInstance_c::setState (FsState_en aen_newState)
   // Set new state
   men_state = aen_newState;
 
+  // nothing known about the files is reliable after a loss of the fileserver
+  if (aen_newState == offline)
+    mc_metadataCache.clear();
+
 #if DEBUG_FILESERVER
   switch (en_oldState)
   {
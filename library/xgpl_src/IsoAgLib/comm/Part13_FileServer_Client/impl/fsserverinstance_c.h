@@ -23,6 +23,7 @@
 #include <IsoAgLib/isoaglib_config.h>
 
 #include "../ifsstructs.h"
+#include "fsmetadatacache_c.h"
 
 #include <IsoAgLib/driver/can/impl/cancustomer_c.h>
 #include <IsoAgLib/comm/Part5_NetworkManagement/impl/isoname_c.h>
@@ -102,6 +103,9 @@ class FsServerInstance_c
     /** initialization state of the fileserver, as described at the enum */
     FsState_en men_state;
 
+    /** attributes and directory listings, shared by all clients of this fileserver */
+    FsMetadataCache_c mc_metadataCache;
+
   public:
     /**
       * Get the fileserver's state. The values are described in the corresponding enum.
@@ -176,6 +180,11 @@ class FsServerInstance_c
       */
    FsBusy_en getBusy() { return en_busy; }
 
+    /**
+      * get the fileserver's metadata cache, cleared when it goes offline.
+      */
+   FsMetadataCache_c &getMetadataCache() { return mc_metadataCache; }
+
    void processFsToGlobal( const CanPkgExt_c& arc_data );
 
    /** time-triggered operations */
@@ -0,0 +1,70 @@
+/*
+  ifsserver_c.h: ISO 11783-13 file server serving directories of
+    the local file system
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef IFSSERVER_C_H
+#define IFSSERVER_C_H
+
+#include "impl/fsserver_c.h"
+#include <IsoAgLib/comm/Part5_NetworkManagement/iidentitem_c.h>
+
+
+namespace IsoAgLib {
+
+  /** File server on the address claimed by the given iIdentItem_c, whose
+      NAME needs the function "file server / printer" to be found by the
+      clients. Each volume is a local directory, so it runs on the PC HAL.
+      Add the volumes, then init() it after the iIdentItem_c. */
+  class iFsServer_c : private __IsoAgLib::FsServer_c {
+    public:
+      iFsServer_c( iIdentItem_c& rc_identItem )
+        : FsServer_c( static_cast<__IsoAgLib::IdentItem_c&>( rc_identItem ) ) {}
+      virtual ~iFsServer_c() {}
+
+      //! @param name volume name without backslashes, the first volume is the default
+      //! @param localPath existing local directory served as volume
+      void addVolume( const char* name, const char* localPath ) {
+        FsServer_c::addVolume( name, localPath );
+      }
+
+      void init() {
+        FsServer_c::init();
+      }
+      //! closes the files of all clients
+      void close() {
+        FsServer_c::close();
+      }
+
+      unsigned getNumClients() const {
+        return FsServer_c::getNumClients();
+      }
+      unsigned getNumOpenFiles() const {
+        return FsServer_c::getNumOpenFiles();
+      }
+      uint64_t getBytesRead() const {
+        return FsServer_c::getBytesRead();
+      }
+      uint64_t getBytesWritten() const {
+        return FsServer_c::getBytesWritten();
+      }
+  };
+
+}
+
+#endif
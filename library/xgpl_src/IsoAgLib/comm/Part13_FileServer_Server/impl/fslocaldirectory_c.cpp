@@ -0,0 +1,774 @@
+/*
+  fslocaldirectory_c.cpp: volumes of the file server mapped to
+    directories of the local file system
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "fslocaldirectory_c.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef WIN32
+  #include <direct.h>
+  #include <io.h>
+#else
+  #include <dirent.h>
+  #include <unistd.h>
+  #include <sys/statvfs.h>
+#endif
+
+
+namespace __IsoAgLib {
+
+#ifdef WIN32
+  static const char scc_separator = '\\';
+  static const uint8_t scui8_caseSensitive = 0;
+#else
+  static const char scc_separator = '/';
+  static const uint8_t scui8_caseSensitive = FsLocalDirectory_c::AttrCaseSensitive;
+#endif
+
+
+static IsoAgLib::iFsError
+errnoToFsError( int error )
+{
+  switch( error )
+  {
+    case ENOENT:
+    case ENOTDIR: return IsoAgLib::fsFileOrPathNotFound;
+    case EACCES:
+    case EPERM:
+    case EROFS:
+    case EEXIST:
+    case ENOTEMPTY: return IsoAgLib::fsAccessDenied;
+    case ENOSPC: return IsoAgLib::fsVolumeOutOfFreeSpace;
+    case EMFILE:
+    case ENFILE: return IsoAgLib::fsTooManyFilesOpen;
+    case ENOMEM: return IsoAgLib::fsOutOfMemory;
+    default: return IsoAgLib::fsAnyOtherError;
+  }
+}
+
+
+static bool
+equalsIgnoreCase( const STL_NAMESPACE::string& a, const STL_NAMESPACE::string& b )
+{
+  if( a.size() != b.size() )
+    return false;
+  for( size_t i = 0; i < a.size(); ++i )
+  {
+    if( CNAMESPACE::toupper( (unsigned char)a[ i ] ) != CNAMESPACE::toupper( (unsigned char)b[ i ] ) )
+      return false;
+  }
+  return true;
+}
+
+
+static bool
+entryLess( const FsLocalDirectory_c::Entry_s& a, const FsLocalDirectory_c::Entry_s& b )
+{
+  return a.name < b.name;
+}
+
+
+static bool
+isDirectory( const STL_NAMESPACE::string& localPath )
+{
+  struct stat info;
+  return ( ::stat( localPath.c_str(), &info ) == 0 ) && S_ISDIR( info.st_mode );
+}
+
+
+static bool
+makeDirectory( const STL_NAMESPACE::string& localPath )
+{
+#ifdef WIN32
+  return _mkdir( localPath.c_str() ) == 0;
+#else
+  return mkdir( localPath.c_str(), 0777 ) == 0;
+#endif
+}
+
+
+/** names of the directory without "." and "..", false if it can't be read */
+static bool
+directoryNames( const STL_NAMESPACE::string& localPath, STL_NAMESPACE::vector<STL_NAMESPACE::string>& names )
+{
+#ifdef WIN32
+  WIN32_FIND_DATAA wfd;
+  HANDLE h = FindFirstFileA( ( localPath + "\\*" ).c_str(), &wfd );
+  if( h == INVALID_HANDLE_VALUE )
+    return false;
+  do
+  {
+    if( ( CNAMESPACE::strcmp( wfd.cFileName, "." ) != 0 ) && ( CNAMESPACE::strcmp( wfd.cFileName, ".." ) != 0 ) )
+      names.push_back( wfd.cFileName );
+  } while( FindNextFileA( h, &wfd ) );
+  FindClose( h );
+#else
+  DIR* dir = opendir( localPath.c_str() );
+  if( dir == NULL )
+    return false;
+  for( struct dirent* entry = readdir( dir ); entry != NULL; entry = readdir( dir ) )
+  {
+    if( ( CNAMESPACE::strcmp( entry->d_name, "." ) != 0 ) && ( CNAMESPACE::strcmp( entry->d_name, ".." ) != 0 ) )
+      names.push_back( entry->d_name );
+  }
+  closedir( dir );
+#endif
+  return true;
+}
+
+
+void
+FsLocalDirectory_c::addVolume( const char* name, const char* localPath )
+{
+  Volume_s volume;
+  volume.name = name;
+  volume.localPath = localPath;
+  while( ( volume.localPath.size() > 1 ) && ( ( *volume.localPath.rbegin() == '/' ) || ( *volume.localPath.rbegin() == '\\' ) ) )
+    volume.localPath.erase( volume.localPath.size() - 1 );
+  mvec_volumes.push_back( volume );
+}
+
+
+int
+FsLocalDirectory_c::volume( const STL_NAMESPACE::string& name ) const
+{
+  for( unsigned i = 0; i < mvec_volumes.size(); ++i )
+  {
+    if( equalsIgnoreCase( mvec_volumes[ i ].name, name ) )
+      return int( i );
+  }
+  return -1;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::resolve( const Path_t& current, const uint8_t* name, uint16_t length,
+                             uint16_t manufacturer, Path_t& result ) const
+{
+  uint16_t pos = 0;
+  if( ( length >= 2 ) && ( name[ 0 ] == '\\' ) && ( name[ 1 ] == '\\' ) )
+  {
+    result.clear();
+    pos = 2;
+  }
+  else if( ( length >= 1 ) && ( name[ 0 ] == '\\' ) )
+  {
+    result.assign( current.begin(), current.begin() + ( current.empty() ? 0 : 1 ) );
+    pos = 1;
+  }
+  else if( ( length >= 1 ) && ( name[ 0 ] == '~' ) )
+  {
+    char mcmc[ 9 ];
+    CNAMESPACE::sprintf( mcmc, "MCMC%04u", unsigned( manufacturer % 10000 ) );
+    if( current.empty() && mvec_volumes.empty() )
+      return IsoAgLib::fsFileOrPathNotFound;
+    result.assign( 1, current.empty() ? mvec_volumes[ 0 ].name : current[ 0 ] );
+    result.push_back( mcmc );
+    pos = 1;
+  }
+  else
+    result = current;
+
+  STL_NAMESPACE::string component;
+  for( ; pos <= length; ++pos )
+  {
+    const uint8_t c = ( pos < length ) ? name[ pos ] : '\\';
+    if( c != '\\' )
+    {
+      if( ( c < 0x20 ) || ( CNAMESPACE::strchr( "/:*?<>|\"", c ) != NULL ) )
+        return IsoAgLib::fsInvalidGivenSourceName;
+      component += char( c );
+      continue;
+    }
+
+    if( component.empty() || ( component == "." ) )
+      ;
+    else if( component == ".." )
+    {
+      if( result.empty() )
+        return IsoAgLib::fsFileOrPathNotFound;
+      result.pop_back();
+    }
+    else if( result.empty() )
+    { // volume names are matched case-insensitive
+      const int index = volume( component );
+      if( index < 0 )
+        return IsoAgLib::fsFileOrPathNotFound;
+      result.push_back( mvec_volumes[ index ].name );
+    }
+    else
+      result.push_back( component );
+    component.clear();
+  }
+  return IsoAgLib::fsSuccess;
+}
+
+
+STL_NAMESPACE::string
+FsLocalDirectory_c::toString( const Path_t& path )
+{
+  STL_NAMESPACE::string result( "\\\\" );
+  for( unsigned i = 0; i < path.size(); ++i )
+  {
+    if( i > 0 )
+      result += '\\';
+    result += path[ i ];
+  }
+  return result;
+}
+
+
+bool
+FsLocalDirectory_c::localPath( const Path_t& path, STL_NAMESPACE::string& result ) const
+{
+  if( path.empty() )
+    return false;
+
+  const int index = volume( path[ 0 ] );
+  if( index < 0 )
+    return false;
+
+  result = mvec_volumes[ index ].localPath;
+  for( unsigned i = 1; i < path.size(); ++i )
+  {
+    result += scc_separator;
+    result += path[ i ];
+  }
+  return true;
+}
+
+
+void
+FsLocalDirectory_c::space( const Path_t& path, uint32_t& total, uint32_t& free ) const
+{
+  total = free = 0;
+
+  Path_t volumePath( path.begin(), path.begin() + ( path.empty() ? 0 : 1 ) );
+  if( volumePath.empty() && !mvec_volumes.empty() )
+    volumePath.push_back( mvec_volumes[ 0 ].name );
+
+  STL_NAMESPACE::string local;
+  if( !localPath( volumePath, local ) )
+    return;
+
+  uint64_t totalBytes = 0, freeBytes = 0;
+#ifdef WIN32
+  ULARGE_INTEGER available, size;
+  if( !GetDiskFreeSpaceExA( local.c_str(), &available, &size, NULL ) )
+    return;
+  totalBytes = size.QuadPart;
+  freeBytes = available.QuadPart;
+#else
+  struct statvfs info;
+  if( statvfs( local.c_str(), &info ) != 0 )
+    return;
+  totalBytes = uint64_t( info.f_blocks ) * info.f_frsize;
+  freeBytes = uint64_t( info.f_bavail ) * info.f_frsize;
+#endif
+  total = uint32_t( STL_NAMESPACE::min<uint64_t>( totalBytes / 512, 0xFFFFFFFFUL ) );
+  free = uint32_t( STL_NAMESPACE::min<uint64_t>( freeBytes / 512, 0xFFFFFFFFUL ) );
+}
+
+
+bool
+FsLocalDirectory_c::stat( const STL_NAMESPACE::string& localPath, const STL_NAMESPACE::string& name, Entry_s& entry )
+{
+  struct stat info;
+  if( ::stat( localPath.c_str(), &info ) != 0 )
+    return false;
+
+  entry.name = name;
+  entry.attributes = uint8_t( AttrLongFilenames | scui8_caseSensitive );
+  if( S_ISDIR( info.st_mode ) )
+    entry.attributes |= AttrDirectory;
+  if( ( info.st_mode & S_IWUSR ) == 0 )
+    entry.attributes |= AttrReadOnly;
+#ifdef WIN32
+  const DWORD winAttributes = GetFileAttributesA( localPath.c_str() );
+  if( ( winAttributes != INVALID_FILE_ATTRIBUTES ) && ( winAttributes & FILE_ATTRIBUTE_HIDDEN ) )
+    entry.attributes |= AttrHidden;
+#else
+  if( !name.empty() && ( name[ 0 ] == '.' ) )
+    entry.attributes |= AttrHidden;
+#endif
+
+  const time_t modified = info.st_mtime;
+  const struct tm* local = CNAMESPACE::localtime( &modified );
+  if( ( local != NULL ) && ( local->tm_year >= 80 ) )
+  {
+    entry.date = uint16_t( ( ( local->tm_year - 80 ) << 9 ) | ( ( local->tm_mon + 1 ) << 5 ) | local->tm_mday );
+    entry.time = uint16_t( ( local->tm_hour << 11 ) | ( local->tm_min << 5 ) | ( local->tm_sec / 2 ) );
+  }
+  else
+  {
+    entry.date = ( 1 << 5 ) | 1; // 1980-01-01
+    entry.time = 0;
+  }
+
+  entry.size = S_ISDIR( info.st_mode ) ? 0 : uint32_t( STL_NAMESPACE::min<uint64_t>( uint64_t( info.st_size ), 0xFFFFFFFFUL ) );
+  return true;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::list( const Path_t& path, bool reportHidden, STL_NAMESPACE::vector<Entry_s>& entries ) const
+{
+  entries.clear();
+
+  if( path.empty() )
+  { // the root lists the volumes
+    for( unsigned i = 0; i < mvec_volumes.size(); ++i )
+    {
+      Entry_s entry;
+      if( !stat( mvec_volumes[ i ].localPath, mvec_volumes[ i ].name, entry ) )
+        continue;
+      entry.attributes = uint8_t( ( entry.attributes & ~AttrHidden ) | AttrVolume | AttrDirectory | AttrNotRemovable );
+      entries.push_back( entry );
+    }
+    return IsoAgLib::fsSuccess;
+  }
+
+  STL_NAMESPACE::string local;
+  if( !localPath( path, local ) )
+    return IsoAgLib::fsFileOrPathNotFound;
+
+  STL_NAMESPACE::vector<STL_NAMESPACE::string> names;
+  if( !directoryNames( local, names ) )
+    return errnoToFsError( errno );
+
+  entries.reserve( names.size() );
+  for( unsigned i = 0; i < names.size(); ++i )
+  {
+    Entry_s entry;
+    if( !stat( local + scc_separator + names[ i ], names[ i ], entry ) )
+      continue;
+    if( ( entry.attributes & AttrHidden ) && !reportHidden )
+      continue;
+    entries.push_back( entry );
+  }
+  STL_NAMESPACE::sort( entries.begin(), entries.end(), entryLess );
+  return IsoAgLib::fsSuccess;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::open( const Path_t& path, uint8_t flags, OpenFile_s& file ) const
+{
+  file = OpenFile_s();
+  file.path = path;
+  file.flags = flags;
+
+  const uint8_t access = uint8_t( flags & OpenAccessMask );
+  if( path.empty() )
+  { // the root with the volumes
+    if( access != OpenDirectory )
+      return IsoAgLib::fsAccessDenied;
+    file.attributes = AttrDirectory | AttrNotRemovable;
+    return IsoAgLib::fsSuccess;
+  }
+
+  STL_NAMESPACE::string local;
+  if( !localPath( path, local ) )
+    return IsoAgLib::fsFileOrPathNotFound;
+
+  Entry_s entry;
+  bool exists = stat( local, path.back(), entry );
+
+  if( access == OpenDirectory )
+  {
+    if( !exists )
+    {
+      if( ( ( flags & OpenCreate ) == 0 ) || !makeDirectory( local ) )
+        return ( flags & OpenCreate ) ? errnoToFsError( errno ) : IsoAgLib::fsFileOrPathNotFound;
+      exists = stat( local, path.back(), entry );
+    }
+    if( !exists || ( ( entry.attributes & AttrDirectory ) == 0 ) )
+      return IsoAgLib::fsInvalidAccess;
+    file.attributes = entry.attributes;
+    return IsoAgLib::fsSuccess;
+  }
+
+  if( exists && ( entry.attributes & AttrDirectory ) )
+    return IsoAgLib::fsInvalidAccess;
+  if( !exists && ( ( access == OpenRead ) || ( ( flags & OpenCreate ) == 0 ) ) )
+    return IsoAgLib::fsFileOrPathNotFound;
+  if( exists && ( access != OpenRead ) && ( entry.attributes & AttrReadOnly ) )
+    return IsoAgLib::fsAccessDenied;
+
+  // an existing file is never truncated, the client seeks and overwrites
+  const char* mode = ( access == OpenRead ) ? "rb" : ( exists ? "r+b" : "w+b" );
+  file.file = CNAMESPACE::fopen( local.c_str(), mode );
+  if( file.file == NULL )
+    return errnoToFsError( errno );
+
+  if( !exists )
+    (void)stat( local, path.back(), entry );
+  file.attributes = entry.attributes;
+  if( flags & OpenAppend )
+    file.position = exists ? entry.size : 0;
+  return IsoAgLib::fsSuccess;
+}
+
+
+void
+FsLocalDirectory_c::close( OpenFile_s& file ) const
+{
+  if( file.file != NULL )
+    (void)CNAMESPACE::fclose( file.file ); // flushes what's still buffered
+  file = OpenFile_s();
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::seek( OpenFile_s& file, uint8_t mode, int32_t offset ) const
+{
+  int64_t size;
+  if( file.isDirectory() )
+  { // the position is the index of the entry, hidden ones are counted
+    const IsoAgLib::iFsError error = list( file.path, true, file.listing );
+    file.listed = ( error == IsoAgLib::fsSuccess );
+    file.listedHidden = true;
+    if( error != IsoAgLib::fsSuccess )
+      return error;
+    size = int64_t( file.listing.size() );
+  }
+  else
+  {
+    if( file.writing && ( CNAMESPACE::fflush( file.file ) != 0 ) )
+    {
+      CNAMESPACE::clearerr( file.file );
+      return IsoAgLib::fsFailureDuringAWriteOperation;
+    }
+    if( CNAMESPACE::fseek( file.file, 0, SEEK_END ) != 0 )
+      return IsoAgLib::fsAnyOtherError;
+    size = CNAMESPACE::ftell( file.file );
+    file.writing = false;
+  }
+
+  int64_t position;
+  switch( mode )
+  {
+    case 0: position = offset; break;
+    case 1: position = int64_t( file.position ) + offset; break;
+    case 2: position = size + offset; break;
+    default: return IsoAgLib::fsInvalidAccess;
+  }
+  if( ( position < 0 ) || ( position > 0xFFFFFFFFLL ) )
+    return IsoAgLib::fsInvalidAccess;
+
+  file.position = uint32_t( position );
+  return IsoAgLib::fsSuccess;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::read( OpenFile_s& file, uint8_t* data, uint16_t count, uint16_t& done ) const
+{
+  done = 0;
+  if( file.isDirectory() || ( ( file.flags & OpenAccessMask ) == OpenWrite ) )
+    return IsoAgLib::fsInvalidAccess;
+
+  if( CNAMESPACE::fseek( file.file, long( file.position ), SEEK_SET ) != 0 )
+    return IsoAgLib::fsFailureDuringAReadOperation;
+  file.writing = false;
+
+  done = uint16_t( CNAMESPACE::fread( data, 1, count, file.file ) );
+  file.position += done;
+  if( done < count )
+  {
+    if( CNAMESPACE::ferror( file.file ) )
+    {
+      CNAMESPACE::clearerr( file.file );
+      return IsoAgLib::fsFailureDuringAReadOperation;
+    }
+    if( done == 0 )
+      return IsoAgLib::fsEndOfFileReached;
+  }
+  return IsoAgLib::fsSuccess;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::write( OpenFile_s& file, const uint8_t* data, uint16_t count, uint16_t& done ) const
+{
+  done = 0;
+  if( file.isDirectory() || ( ( file.flags & OpenAccessMask ) == OpenRead ) )
+    return IsoAgLib::fsInvalidAccess;
+
+  if( file.flags & OpenAppend )
+  {
+    if( CNAMESPACE::fseek( file.file, 0, SEEK_END ) != 0 )
+      return IsoAgLib::fsFailureDuringAWriteOperation;
+    file.position = uint32_t( CNAMESPACE::ftell( file.file ) );
+  }
+  else if( !file.writing && ( CNAMESPACE::fseek( file.file, long( file.position ), SEEK_SET ) != 0 ) )
+    return IsoAgLib::fsFailureDuringAWriteOperation;
+  file.writing = true;
+
+  done = uint16_t( CNAMESPACE::fwrite( data, 1, count, file.file ) );
+  file.position += done;
+#ifdef CONFIG_FS_SERVER_FLUSH_EACH_WRITE
+  if( ( done < count ) || ( CNAMESPACE::fflush( file.file ) != 0 ) )
+#else
+  if( done < count )
+#endif
+  {
+    const IsoAgLib::iFsError error = ( errno == ENOSPC ) ? IsoAgLib::fsVolumeOutOfFreeSpace : IsoAgLib::fsFailureDuringAWriteOperation;
+    CNAMESPACE::clearerr( file.file );
+    return error;
+  }
+  return IsoAgLib::fsSuccess;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::readDirectory( OpenFile_s& file, uint16_t count, bool reportHidden, uint32_t maxSize,
+                                   uint32_t& first, uint32_t& num ) const
+{
+  first = file.position;
+  num = 0;
+  if( !file.isDirectory() )
+    return IsoAgLib::fsInvalidAccess;
+
+  if( !file.listed || ( file.listedHidden != reportHidden ) )
+  {
+    const IsoAgLib::iFsError error = list( file.path, reportHidden, file.listing );
+    if( error != IsoAgLib::fsSuccess )
+      return error;
+    file.listed = true;
+    file.listedHidden = reportHidden;
+  }
+
+  if( ( count > 0 ) && ( first >= file.listing.size() ) )
+    return IsoAgLib::fsEndOfFileReached;
+
+  uint32_t size = 0;
+  while( ( num < count ) && ( first + num < file.listing.size() ) )
+  {
+    size += entrySize( file.listing[ first + num ] );
+    if( size > maxSize )
+      break;
+    ++num;
+  }
+  file.position += num;
+  return IsoAgLib::fsSuccess;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::getAttributes( const Path_t& path, Entry_s& entry ) const
+{
+  if( path.empty() )
+  {
+    entry = Entry_s();
+    entry.attributes = AttrDirectory | AttrNotRemovable;
+    entry.date = ( 1 << 5 ) | 1;
+    entry.time = 0;
+    entry.size = 0;
+    return IsoAgLib::fsSuccess;
+  }
+
+  STL_NAMESPACE::string local;
+  if( !localPath( path, local ) || !stat( local, path.back(), entry ) )
+    return IsoAgLib::fsFileOrPathNotFound;
+  if( path.size() == 1 )
+    entry.attributes = uint8_t( ( entry.attributes & ~AttrHidden ) | AttrVolume | AttrNotRemovable );
+  return IsoAgLib::fsSuccess;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::setAttributes( const Path_t& path, uint8_t hidden, uint8_t readOnly ) const
+{
+  Entry_s entry;
+  STL_NAMESPACE::string local;
+  if( ( path.size() < 2 ) || !localPath( path, local ) || !stat( local, path.back(), entry ) )
+    return ( path.size() < 2 ) ? IsoAgLib::fsAccessDenied : IsoAgLib::fsFileOrPathNotFound;
+
+#ifdef WIN32
+  DWORD winAttributes = GetFileAttributesA( local.c_str() );
+  if( winAttributes == INVALID_FILE_ATTRIBUTES )
+    return IsoAgLib::fsFileOrPathNotFound;
+  if( hidden < 2 )
+    winAttributes = hidden ? ( winAttributes | FILE_ATTRIBUTE_HIDDEN ) : ( winAttributes & ~FILE_ATTRIBUTE_HIDDEN );
+  if( readOnly < 2 )
+    winAttributes = readOnly ? ( winAttributes | FILE_ATTRIBUTE_READONLY ) : ( winAttributes & ~FILE_ATTRIBUTE_READONLY );
+  if( !SetFileAttributesA( local.c_str(), winAttributes ) )
+    return IsoAgLib::fsAccessDenied;
+#else
+  // hidden are the names starting with a dot, that can't be changed
+  if( ( hidden < 2 ) && ( ( hidden != 0 ) != ( ( entry.attributes & AttrHidden ) != 0 ) ) )
+    return IsoAgLib::fsAccessDenied;
+  if( readOnly < 2 )
+  {
+    struct stat info;
+    if( ::stat( local.c_str(), &info ) != 0 )
+      return errnoToFsError( errno );
+    const mode_t mode = readOnly ? ( info.st_mode & ~( S_IWUSR | S_IWGRP | S_IWOTH ) ) : ( info.st_mode | S_IWUSR );
+    if( chmod( local.c_str(), mode & 07777 ) != 0 )
+      return errnoToFsError( errno );
+  }
+#endif
+  return IsoAgLib::fsSuccess;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::copyLocal( const STL_NAMESPACE::string& source, const STL_NAMESPACE::string& dest )
+{
+  if( isDirectory( source ) )
+  {
+    STL_NAMESPACE::vector<STL_NAMESPACE::string> names;
+    if( !directoryNames( source, names ) || ( !isDirectory( dest ) && !makeDirectory( dest ) ) )
+      return errnoToFsError( errno );
+    for( unsigned i = 0; i < names.size(); ++i )
+    {
+      const IsoAgLib::iFsError error = copyLocal( source + scc_separator + names[ i ], dest + scc_separator + names[ i ] );
+      if( error != IsoAgLib::fsSuccess )
+        return error;
+    }
+    return IsoAgLib::fsSuccess;
+  }
+
+  CNAMESPACE::FILE* in = CNAMESPACE::fopen( source.c_str(), "rb" );
+  if( in == NULL )
+    return errnoToFsError( errno );
+  CNAMESPACE::FILE* out = CNAMESPACE::fopen( dest.c_str(), "wb" );
+  if( out == NULL )
+  {
+    const IsoAgLib::iFsError error = errnoToFsError( errno );
+    (void)CNAMESPACE::fclose( in );
+    return error;
+  }
+
+  IsoAgLib::iFsError error = IsoAgLib::fsSuccess;
+  uint8_t buffer[ 4096 ];
+  for( size_t n = CNAMESPACE::fread( buffer, 1, sizeof( buffer ), in ); n > 0; n = CNAMESPACE::fread( buffer, 1, sizeof( buffer ), in ) )
+  {
+    if( CNAMESPACE::fwrite( buffer, 1, n, out ) != n )
+    {
+      error = ( errno == ENOSPC ) ? IsoAgLib::fsVolumeOutOfFreeSpace : IsoAgLib::fsFailureDuringAWriteOperation;
+      break;
+    }
+  }
+  if( CNAMESPACE::ferror( in ) )
+    error = IsoAgLib::fsFailureDuringAReadOperation;
+  (void)CNAMESPACE::fclose( in );
+  if( ( CNAMESPACE::fclose( out ) != 0 ) && ( error == IsoAgLib::fsSuccess ) )
+    error = IsoAgLib::fsFailureDuringAWriteOperation;
+  return error;
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::removeLocal( const STL_NAMESPACE::string& localPath, bool recursive )
+{
+  if( isDirectory( localPath ) )
+  {
+    STL_NAMESPACE::vector<STL_NAMESPACE::string> names;
+    if( !directoryNames( localPath, names ) )
+      return errnoToFsError( errno );
+    if( !names.empty() && !recursive )
+      return IsoAgLib::fsAccessDenied;
+    for( unsigned i = 0; i < names.size(); ++i )
+    {
+      const IsoAgLib::iFsError error = removeLocal( localPath + scc_separator + names[ i ], true );
+      if( error != IsoAgLib::fsSuccess )
+        return error;
+    }
+#ifdef WIN32
+    return ( _rmdir( localPath.c_str() ) == 0 ) ? IsoAgLib::fsSuccess : errnoToFsError( errno );
+#else
+    return ( rmdir( localPath.c_str() ) == 0 ) ? IsoAgLib::fsSuccess : errnoToFsError( errno );
+#endif
+  }
+  return ( CNAMESPACE::remove( localPath.c_str() ) == 0 ) ? IsoAgLib::fsSuccess : errnoToFsError( errno );
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::remove( const Path_t& path, bool force, bool recursive ) const
+{
+  // neither the root nor a volume can be deleted
+  if( path.size() < 2 )
+    return IsoAgLib::fsAccessDenied;
+
+  Entry_s entry;
+  STL_NAMESPACE::string local;
+  if( !localPath( path, local ) || !stat( local, path.back(), entry ) )
+    return IsoAgLib::fsFileOrPathNotFound;
+  if( ( entry.attributes & AttrReadOnly ) && !force )
+    return IsoAgLib::fsAccessDenied;
+  if( ( entry.attributes & AttrReadOnly ) && ( setAttributes( path, 3, 0 ) != IsoAgLib::fsSuccess ) )
+    return IsoAgLib::fsAccessDenied;
+
+  return removeLocal( local, recursive );
+}
+
+
+IsoAgLib::iFsError
+FsLocalDirectory_c::move( const Path_t& source, const Path_t& dest, bool copy, bool force, bool recursive ) const
+{
+  if( source.size() < 2 )
+    return IsoAgLib::fsInvalidGivenSourceName;
+  if( dest.size() < 2 )
+    return IsoAgLib::fsInvalidGivenDestinationName;
+
+  Entry_s entry;
+  STL_NAMESPACE::string localSource, localDest;
+  if( !localPath( source, localSource ) || !stat( localSource, source.back(), entry ) )
+    return IsoAgLib::fsFileOrPathNotFound;
+  if( !localPath( dest, localDest ) )
+    return IsoAgLib::fsInvalidGivenDestinationName;
+
+  // a directory can't go into itself
+  if( ( dest.size() > source.size() ) && STL_NAMESPACE::equal( source.begin(), source.end(), dest.begin() ) )
+    return IsoAgLib::fsInvalidGivenDestinationName;
+  if( ( entry.attributes & AttrDirectory ) && copy && !recursive )
+    return IsoAgLib::fsAccessDenied;
+
+  Entry_s destEntry;
+  if( stat( localDest, dest.back(), destEntry ) )
+  {
+    if( !force )
+      return IsoAgLib::fsAccessDenied;
+    // a non-empty directory is only replaced with the recursive flag
+    const IsoAgLib::iFsError error = remove( dest, true, recursive );
+    if( error != IsoAgLib::fsSuccess )
+      return error;
+  }
+
+  if( !copy && ( CNAMESPACE::rename( localSource.c_str(), localDest.c_str() ) == 0 ) )
+    return IsoAgLib::fsSuccess;
+  if( !copy && ( errno != EXDEV ) )
+    return errnoToFsError( errno );
+
+  // copy, or move between volumes on different file systems
+  const IsoAgLib::iFsError error = copyLocal( localSource, localDest );
+  if( ( error != IsoAgLib::fsSuccess ) || copy )
+    return error;
+  return removeLocal( localSource, true );
+}
+
+}
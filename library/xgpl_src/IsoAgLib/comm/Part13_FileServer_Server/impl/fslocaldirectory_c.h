@@ -0,0 +1,149 @@
+/*
+  fslocaldirectory_c.h: volumes of the file server mapped to
+    directories of the local file system
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef FSLOCALDIRECTORY_C_H
+#define FSLOCALDIRECTORY_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <IsoAgLib/comm/Part13_FileServer_Client/ifsstructs.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace __IsoAgLib {
+
+/** The file access of FsServer_c. Each volume is a directory of the local
+    file system, the root directory "\\\\" lists the volumes. A path is kept
+    as its components (volume first), resolved against the client's current
+    directory with "." and ".." already applied, so it can't leave the
+    volume's directory.
+    Uses stdio and the POSIX (or WIN32) directory functions, so it is
+    meant for the PC HAL.
+  */
+class FsLocalDirectory_c
+{
+public:
+  typedef STL_NAMESPACE::vector<STL_NAMESPACE::string> Path_t;
+
+  /** attribute byte of ISO 11783-13 */
+  enum Attribute_en {
+    AttrReadOnly = 0x01,
+    AttrHidden = 0x02,
+    AttrVolume = 0x08,
+    AttrDirectory = 0x10,
+    AttrLongFilenames = 0x20,
+    AttrNotRemovable = 0x40,
+    AttrCaseSensitive = 0x80
+  };
+
+  /** Open File flags of ISO 11783-13 */
+  enum OpenFlags_en {
+    OpenAccessMask = 0x03,
+    OpenRead = 0x00,
+    OpenWrite = 0x01,
+    OpenReadWrite = 0x02,
+    OpenDirectory = 0x03,
+    OpenCreate = 0x04,
+    OpenAppend = 0x08,
+    OpenExclusive = 0x10
+  };
+
+  struct Entry_s {
+    STL_NAMESPACE::string name;
+    uint8_t attributes;
+    uint16_t date; // FAT format
+    uint16_t time;
+    uint32_t size;
+  };
+
+  struct OpenFile_s {
+    OpenFile_s() : file( NULL ), path(), position( 0 ), flags( 0 ), attributes( 0 ), writing( false ), listed( false ), listedHidden( false ), listing() {}
+    bool isDirectory() const { return ( flags & OpenAccessMask ) == OpenDirectory; }
+
+    CNAMESPACE::FILE* file; // NULL for a directory
+    Path_t path;
+    uint32_t position; // entry index for a directory
+    uint8_t flags;
+    uint8_t attributes;
+    bool writing; // last access was a write, a read needs a seek in between
+    // a directory is listed once and paged through by position
+    bool listed;
+    bool listedHidden;
+    STL_NAMESPACE::vector<Entry_s> listing;
+  };
+
+  FsLocalDirectory_c() : mvec_volumes() {}
+
+  void addVolume( const char* name, const char* localPath );
+  unsigned numVolumes() const { return unsigned( mvec_volumes.size() ); }
+  /** root of the first volume, the current directory of a new client */
+  Path_t defaultDirectory() const { return mvec_volumes.empty() ? Path_t() : Path_t( 1, mvec_volumes[ 0 ].name ); }
+
+  /** resolve a path of a request, "~" is the manufacturer specific
+      directory "MCMCnnnn" on the current volume */
+  IsoAgLib::iFsError resolve( const Path_t& current, const uint8_t* name, uint16_t length,
+                              uint16_t manufacturer, Path_t& result ) const;
+
+  /** "\\\\VOLUME\\dir" notation of the path */
+  static STL_NAMESPACE::string toString( const Path_t& path );
+
+  /** @return total and free space of the path's volume in 512 byte units */
+  void space( const Path_t& path, uint32_t& total, uint32_t& free ) const;
+
+  IsoAgLib::iFsError open( const Path_t& path, uint8_t flags, OpenFile_s& file ) const;
+  void close( OpenFile_s& file ) const;
+  IsoAgLib::iFsError seek( OpenFile_s& file, uint8_t mode, int32_t offset ) const;
+  IsoAgLib::iFsError read( OpenFile_s& file, uint8_t* data, uint16_t count, uint16_t& done ) const;
+  IsoAgLib::iFsError write( OpenFile_s& file, const uint8_t* data, uint16_t count, uint16_t& done ) const;
+  /** entries from the position on, at most count and as many as fit in maxSize bytes
+      @param first index of the first entry in file.listing
+      @param num number of entries */
+  IsoAgLib::iFsError readDirectory( OpenFile_s& file, uint16_t count, bool reportHidden, uint32_t maxSize,
+                                    uint32_t& first, uint32_t& num ) const;
+
+  IsoAgLib::iFsError getAttributes( const Path_t& path, Entry_s& entry ) const;
+  /** @param hidden, readOnly 0 clear, 1 set, 3 leave as is */
+  IsoAgLib::iFsError setAttributes( const Path_t& path, uint8_t hidden, uint8_t readOnly ) const;
+  IsoAgLib::iFsError move( const Path_t& source, const Path_t& dest, bool copy, bool force, bool recursive ) const;
+  IsoAgLib::iFsError remove( const Path_t& path, bool force, bool recursive ) const;
+
+  static uint32_t entrySize( const Entry_s& entry ) { return 1 + uint32_t( entry.name.size() ) + 1 + 2 + 2 + 4; }
+
+private:
+  struct Volume_s {
+    STL_NAMESPACE::string name;
+    STL_NAMESPACE::string localPath;
+  };
+
+  bool localPath( const Path_t& path, STL_NAMESPACE::string& result ) const;
+  IsoAgLib::iFsError list( const Path_t& path, bool reportHidden, STL_NAMESPACE::vector<Entry_s>& entries ) const;
+  int volume( const STL_NAMESPACE::string& name ) const;
+  static bool stat( const STL_NAMESPACE::string& localPath, const STL_NAMESPACE::string& name, Entry_s& entry );
+  static IsoAgLib::iFsError removeLocal( const STL_NAMESPACE::string& localPath, bool recursive );
+  static IsoAgLib::iFsError copyLocal( const STL_NAMESPACE::string& source, const STL_NAMESPACE::string& dest );
+
+  STL_NAMESPACE::vector<Volume_s> mvec_volumes;
+};
+
+}
+
+#endif
@@ -0,0 +1,631 @@
+/*
+  fsserver_c.cpp: ISO 11783-13 file server serving directories of
+    the local file system
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "fsserver_c.h"
+#include "fsserverclient_c.h"
+
+#include <IsoAgLib/comm/impl/isobus_c.h>
+#include <IsoAgLib/comm/Part3_DataLink/impl/canpkgext_c.h>
+#include <IsoAgLib/comm/Part3_DataLink/impl/multireceive_c.h>
+#include <IsoAgLib/comm/Part5_NetworkManagement/impl/identitem_c.h>
+#include <IsoAgLib/driver/system/impl/system_c.h>
+#include <IsoAgLib/scheduler/impl/scheduler_c.h>
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#pragma warning( disable : 4355 )
+#endif
+
+
+namespace __IsoAgLib {
+
+  static const int32_t sci32_period = 100;
+  static const int32_t sci32_statusPeriod = 2000;
+  static const int32_t sci32_statusPeriodBusy = 200;
+  // a client without maintenance message for that long is disconnected
+  static const int32_t sci32_clientTimeout = 6000;
+  static const uint8_t scui8_versionIS = 2;
+  static const uint32_t scui32_maxRequestSize = 5 + 0xFFFFUL;
+  static const uint8_t scui8_busyReading = 0x01;
+  static const uint8_t scui8_busyWriting = 0x02;
+
+
+  static void
+  push16( STL_NAMESPACE::vector<uint8_t>& buffer, uint16_t value )
+  {
+    buffer.push_back( uint8_t( value ) );
+    buffer.push_back( uint8_t( value >> 8 ) );
+  }
+
+
+  static void
+  push32( STL_NAMESPACE::vector<uint8_t>& buffer, uint32_t value )
+  {
+    push16( buffer, uint16_t( value ) );
+    push16( buffer, uint16_t( value >> 16 ) );
+  }
+
+
+  static uint16_t
+  read16( const uint8_t* data )
+  {
+    return uint16_t( data[ 0 ] | ( uint16_t( data[ 1 ] ) << 8 ) );
+  }
+
+
+  /** @return false if the request is too short for the name's length */
+  static bool
+  readName( const uint8_t* data, uint32_t length, uint32_t lengthPos, const uint8_t*& name, uint16_t& nameLength )
+  {
+    if( length < lengthPos + 2 )
+      return false;
+    nameLength = read16( data + lengthPos );
+    name = data + lengthPos + 2;
+    return ( lengthPos + 2 + uint32_t( nameLength ) ) <= length;
+  }
+
+
+  FsServer_c::FsServer_c( IdentItem_c& identItem )
+    : CanCustomer_c()
+    , mrc_identItem( identItem )
+    , m_schedulerTask( *this, sci32_period, false )
+    , mc_directory()
+    , mvec_clients()
+    , mvec_handles( CONFIG_FS_SERVER_MAX_OPEN_FILES )
+    , mui32_numOpenFiles( 0 )
+    , mui64_bytesRead( 0 )
+    , mui64_bytesWritten( 0 )
+    , mi32_lastStatusSent( 0 )
+    , mui8_busy( 0 )
+    , mb_receiveRegistered( false )
+  {
+  }
+
+
+  FsServer_c::~FsServer_c()
+  {
+    for( unsigned i = 0; i < mvec_handles.size(); ++i )
+      mc_directory.close( mvec_handles[ i ].file );
+    for( unsigned i = 0; i < mvec_clients.size(); ++i )
+      delete mvec_clients[ i ];
+  }
+
+
+  int
+  FsServer_c::getMultitonInst() const
+  {
+    return mrc_identItem.getMultitonInst();
+  }
+
+
+  void
+  FsServer_c::addVolume( const char* name, const char* localPath )
+  {
+    mc_directory.addVolume( name, localPath );
+  }
+
+
+  void
+  FsServer_c::init()
+  {
+    getIsoBusInstance4Comm().insertFilter( *this, IsoAgLib::iMaskFilterType_c( 0x3FF0000, CLIENT_TO_FS_PGN << 8, Ident_c::ExtendedIdent ), 8 );
+    getSchedulerInstance().registerTask( m_schedulerTask, 0 );
+  }
+
+
+  void
+  FsServer_c::close()
+  {
+    getSchedulerInstance().deregisterTask( m_schedulerTask );
+    getIsoBusInstance4Comm().deleteFilter( *this, IsoAgLib::iMaskFilterType_c( 0x3FF0000, CLIENT_TO_FS_PGN << 8, Ident_c::ExtendedIdent ) );
+    if( mb_receiveRegistered )
+    {
+      getMultiReceiveInstance4Comm().deregisterClient( *this, mrc_identItem.isoName(), CLIENT_TO_FS_PGN, 0x3FFFFLU );
+      mb_receiveRegistered = false;
+    }
+
+    for( unsigned i = 0; i < mvec_clients.size(); ++i )
+    {
+      closeFiles( *mvec_clients[ i ] );
+      delete mvec_clients[ i ];
+    }
+    mvec_clients.clear();
+  }
+
+
+  void
+  FsServer_c::timeEvent()
+  {
+    if( !mrc_identItem.isClaimedAddress() )
+      return;
+
+    const ecutime_t now = System_c::getTime();
+    if( !mb_receiveRegistered )
+    { // requests to our NAME from any client
+      getMultiReceiveInstance4Comm().registerClientIso( *this, mrc_identItem.isoName(), CLIENT_TO_FS_PGN, 0x3FFFFLU, false, false );
+      mb_receiveRegistered = true;
+      sendStatus( now );
+    }
+
+    for( STL_NAMESPACE::vector<FsServerClient_c*>::iterator it = mvec_clients.begin(); it != mvec_clients.end(); )
+    {
+      if( now - (*it)->lastSeen() > sci32_clientTimeout )
+      {
+        closeFiles( **it );
+        delete *it;
+        it = mvec_clients.erase( it );
+      }
+      else
+      {
+        (*it)->retrySend();
+        ++it;
+      }
+    }
+
+    if( now - mi32_lastStatusSent >= ( mui8_busy ? sci32_statusPeriodBusy : sci32_statusPeriod ) )
+      sendStatus( now );
+  }
+
+
+  void
+  FsServer_c::sendStatus( ecutime_t now )
+  {
+    CanPkgExt_c pkg;
+    pkg.setExtCanPkg8( 0x07, 0x00, FS_TO_GLOBAL_PGN >> 8, 0xFF, mrc_identItem.getIsoItem()->nr(),
+                       0x00, mui8_busy, uint8_t( STL_NAMESPACE::min<uint32_t>( mui32_numOpenFiles, 0xFF ) ),
+                       0xFF, 0xFF, 0xFF, 0xFF, 0xFF );
+    getIsoBusInstance4Comm() << pkg;
+
+    mi32_lastStatusSent = now;
+    mui8_busy = 0;
+  }
+
+
+  FsServerClient_c*
+  FsServer_c::client( const IsoName_c& isoName )
+  {
+    for( unsigned i = 0; i < mvec_clients.size(); ++i )
+    {
+      if( mvec_clients[ i ]->isoName() == isoName )
+        return mvec_clients[ i ];
+    }
+    mvec_clients.push_back( new FsServerClient_c( *this, isoName, mc_directory.defaultDirectory() ) );
+    return mvec_clients.back();
+  }
+
+
+  void
+  FsServer_c::closeFiles( const FsServerClient_c& client )
+  {
+    for( unsigned i = 0; i < mvec_handles.size(); ++i )
+    {
+      if( mvec_handles[ i ].owner != &client )
+        continue;
+      mc_directory.close( mvec_handles[ i ].file );
+      mvec_handles[ i ].owner = NULL;
+      --mui32_numOpenFiles;
+    }
+  }
+
+
+  bool
+  FsServer_c::isOpen( const FsLocalDirectory_c::Path_t& path ) const
+  {
+    for( unsigned i = 0; i < mvec_handles.size(); ++i )
+    {
+      const FsLocalDirectory_c::Path_t& openPath = mvec_handles[ i ].file.path;
+      if( ( mvec_handles[ i ].owner != NULL ) && ( openPath.size() >= path.size() )
+       && STL_NAMESPACE::equal( path.begin(), path.end(), openPath.begin() ) )
+        return true;
+    }
+    return false;
+  }
+
+
+  FsServer_c::OpenHandle_s*
+  FsServer_c::openHandle( const FsServerClient_c& client, uint8_t handle )
+  {
+    if( ( handle < mvec_handles.size() ) && ( mvec_handles[ handle ].owner == &client ) )
+      return &mvec_handles[ handle ];
+    return NULL;
+  }
+
+
+  void
+  FsServer_c::processMsg( const CanPkg_c& data )
+  {
+    CanPkgExt_c pkg( data, getMultitonInst() );
+    if( !pkg.isValid() || ( pkg.getMonitorItemForSA() == NULL ) )
+      return;
+    if( ( mrc_identItem.getIsoItem() == NULL ) || ( pkg.getMonitorItemForDA() != mrc_identItem.getIsoItem() ) )
+      return;
+
+    uint8_t request[ 8 ];
+    for( uint8_t i = 0; i < 8; ++i )
+      request[ i ] = pkg.getUint8Data( i );
+
+    processRequest( *client( pkg.getMonitorItemForSA()->isoName() ), request, 8 );
+  }
+
+
+  bool
+  FsServer_c::reactOnStreamStart( const ReceiveStreamIdentifier_c&, uint32_t totalLen )
+  {
+    return totalLen <= scui32_maxRequestSize;
+  }
+
+
+  bool
+  FsServer_c::processPartStreamDataChunk( Stream_c& stream, bool isFirstChunk, bool isLastChunk )
+  {
+    if( stream.getStreamInvalid() )
+      return false;
+
+    FsServerClient_c& sender = *client( stream.getIdent().getSaIsoName() );
+    STL_NAMESPACE::vector<uint8_t>& request = sender.request();
+    if( isFirstChunk )
+    {
+      request.clear();
+      request.reserve( stream.getByteTotalSize() );
+      request.push_back( stream.getFirstByte() );
+    }
+
+    while( stream.getNotParsedSize() > 0 )
+      request.push_back( stream.get() );
+
+    if( isLastChunk )
+      processRequest( sender, &request[ 0 ], uint32_t( request.size() ) );
+    return false;
+  }
+
+
+  void
+  FsServer_c::processRequest( FsServerClient_c& client, const uint8_t* data, uint32_t length )
+  {
+    client.seen( System_c::getTime() );
+
+    const uint8_t command = data[ 0 ];
+    if( command == 0x00 )
+      return; // client connection maintenance
+
+    // one request per client at a time, it is repeated after the time-out
+    if( client.isSending() || ( length < 2 ) )
+      return;
+
+    if( command == 0x01 )
+    { // the only request without TAN
+      processProperties( client );
+      client.sendResponse();
+      return;
+    }
+
+    const uint8_t tan = data[ 1 ];
+    if( client.isRepetition( command, tan ) )
+    { // the response got lost
+      client.sendResponse();
+      return;
+    }
+
+    switch( command )
+    {
+      case 0x10: processCurrentDirectory( client, tan ); break;
+      case 0x11: processChangeDirectory( client, tan, data, length ); break;
+      case 0x20: processOpen( client, tan, data, length ); break;
+      case 0x21: processSeek( client, tan, data, length ); break;
+      case 0x22: processRead( client, tan, data, length ); break;
+      case 0x23: processWrite( client, tan, data, length ); break;
+      case 0x24: processClose( client, tan, data, length ); break;
+      case 0x30: processMove( client, tan, data, length ); break;
+      case 0x31: processDelete( client, tan, data, length ); break;
+      case 0x32:
+      case 0x33:
+      case 0x34: processAttributes( client, command, tan, data, length ); break;
+      default:
+      { // including Initialize Volume, the volumes are local directories
+        STL_NAMESPACE::vector<uint8_t>& response = client.response( command, tan );
+        response.push_back( tan );
+        response.push_back( IsoAgLib::fsFunctionNotSupported );
+      }
+    }
+    client.sendResponse();
+  }
+
+
+  void
+  FsServer_c::processProperties( FsServerClient_c& client )
+  {
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x01, 0xFF );
+    response.push_back( scui8_versionIS );
+    response.push_back( uint8_t( CONFIG_FS_SERVER_MAX_OPEN_FILES ) );
+    response.push_back( ( mc_directory.numVolumes() > 1 ) ? 0x01 : 0x00 ); // multiple volumes
+  }
+
+
+  void
+  FsServer_c::processCurrentDirectory( FsServerClient_c& client, uint8_t tan )
+  {
+    uint32_t total, free;
+    mc_directory.space( client.currentDirectory(), total, free );
+    const STL_NAMESPACE::string name = FsLocalDirectory_c::toString( client.currentDirectory() );
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x10, tan );
+    response.push_back( tan );
+    response.push_back( IsoAgLib::fsSuccess );
+    push32( response, total );
+    push32( response, free );
+    push16( response, uint16_t( name.size() ) );
+    response.insert( response.end(), name.begin(), name.end() );
+  }
+
+
+  void
+  FsServer_c::processChangeDirectory( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    const uint8_t* name;
+    uint16_t nameLength;
+    IsoAgLib::iFsError error = IsoAgLib::fsInvalidRequestLength;
+    FsLocalDirectory_c::Path_t path;
+    if( readName( data, length, 2, name, nameLength ) )
+      error = mc_directory.resolve( client.currentDirectory(), name, nameLength, client.isoName().manufCode(), path );
+
+    FsLocalDirectory_c::Entry_s entry;
+    if( error == IsoAgLib::fsSuccess )
+      error = mc_directory.getAttributes( path, entry );
+    if( ( error == IsoAgLib::fsSuccess ) && ( ( entry.attributes & FsLocalDirectory_c::AttrDirectory ) == 0 ) )
+      error = IsoAgLib::fsFileOrPathNotFound;
+    if( error == IsoAgLib::fsSuccess )
+      client.currentDirectory() = path;
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x11, tan );
+    response.push_back( tan );
+    response.push_back( error );
+  }
+
+
+  void
+  FsServer_c::processOpen( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    const uint8_t flags = data[ 2 ];
+    const uint8_t* name;
+    uint16_t nameLength;
+    IsoAgLib::iFsError error = IsoAgLib::fsInvalidRequestLength;
+    FsLocalDirectory_c::Path_t path;
+    if( readName( data, length, 3, name, nameLength ) )
+      error = mc_directory.resolve( client.currentDirectory(), name, nameLength, client.isoName().manufCode(), path );
+
+    for( unsigned i = 0; ( error == IsoAgLib::fsSuccess ) && ( i < mvec_handles.size() ); ++i )
+    {
+      if( ( mvec_handles[ i ].owner != NULL ) && ( mvec_handles[ i ].file.path == path )
+       && ( ( flags & FsLocalDirectory_c::OpenExclusive ) || ( mvec_handles[ i ].file.flags & FsLocalDirectory_c::OpenExclusive ) ) )
+        error = IsoAgLib::fsAccessDenied;
+    }
+
+    unsigned handle = 0;
+    while( ( handle < mvec_handles.size() ) && ( mvec_handles[ handle ].owner != NULL ) )
+      ++handle;
+    if( ( error == IsoAgLib::fsSuccess ) && ( handle == mvec_handles.size() ) )
+      error = IsoAgLib::fsTooManyFilesOpen;
+
+    if( error == IsoAgLib::fsSuccess )
+      error = mc_directory.open( path, flags, mvec_handles[ handle ].file );
+    if( error == IsoAgLib::fsSuccess )
+    {
+      mvec_handles[ handle ].owner = &client;
+      ++mui32_numOpenFiles;
+    }
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x20, tan );
+    response.push_back( tan );
+    response.push_back( error );
+    response.push_back( ( error == IsoAgLib::fsSuccess ) ? uint8_t( handle ) : 0xFF );
+    response.push_back( ( error == IsoAgLib::fsSuccess ) ? mvec_handles[ handle ].file.attributes : 0xFF );
+  }
+
+
+  void
+  FsServer_c::processSeek( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    OpenHandle_s* handle = ( length >= 8 ) ? openHandle( client, data[ 2 ] ) : NULL;
+    IsoAgLib::iFsError error = ( length >= 8 ) ? IsoAgLib::fsInvalidHandle : IsoAgLib::fsInvalidRequestLength;
+    if( handle != NULL )
+    {
+      const int32_t offset = int32_t( uint32_t( read16( data + 4 ) ) | ( uint32_t( read16( data + 6 ) ) << 16 ) );
+      error = mc_directory.seek( handle->file, data[ 3 ], offset );
+    }
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x21, tan );
+    response.push_back( tan );
+    response.push_back( error );
+    response.push_back( 0xFF );
+    push32( response, ( handle != NULL ) ? handle->file.position : 0xFFFFFFFFUL );
+  }
+
+
+  void
+  FsServer_c::processRead( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    OpenHandle_s* handle = ( length >= 6 ) ? openHandle( client, data[ 2 ] ) : NULL;
+    const uint16_t count = ( length >= 6 ) ? read16( data + 3 ) : 0;
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x22, tan );
+    response.push_back( tan );
+    response.push_back( ( length >= 6 ) ? IsoAgLib::fsInvalidHandle : IsoAgLib::fsInvalidRequestLength );
+    push16( response, 0 );
+    if( handle == NULL )
+      return;
+
+    if( handle->file.isDirectory() )
+    {
+      uint32_t first, num;
+      response[ 2 ] = mc_directory.readDirectory( handle->file, count, data[ 5 ] == 0x01, 0xFFFFUL - 5, first, num ); // the entries follow the 5 header bytes
+      response[ 3 ] = uint8_t( num );
+      response[ 4 ] = uint8_t( num >> 8 );
+      for( uint32_t i = first; i < first + num; ++i )
+      {
+        const FsLocalDirectory_c::Entry_s& entry = handle->file.listing[ i ];
+        response.push_back( uint8_t( entry.name.size() ) );
+        response.insert( response.end(), entry.name.begin(), entry.name.end() );
+        response.push_back( entry.attributes );
+        push16( response, entry.date );
+        push16( response, entry.time );
+        push32( response, entry.size );
+      }
+      return;
+    }
+
+    uint16_t done = 0;
+    response.resize( 5 + count );
+    response[ 2 ] = mc_directory.read( handle->file, &response[ 5 ], count, done );
+    response.resize( 5 + done );
+    response[ 3 ] = uint8_t( done );
+    response[ 4 ] = uint8_t( done >> 8 );
+    mui64_bytesRead += done;
+    mui8_busy |= scui8_busyReading;
+  }
+
+
+  void
+  FsServer_c::processWrite( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    const uint16_t count = ( length >= 5 ) ? read16( data + 3 ) : 0;
+    OpenHandle_s* handle = ( length >= 5 ) ? openHandle( client, data[ 2 ] ) : NULL;
+    IsoAgLib::iFsError error = IsoAgLib::fsInvalidHandle;
+    uint16_t done = 0;
+    if( ( length < 5 ) || ( 5 + uint32_t( count ) > length ) )
+      error = IsoAgLib::fsInvalidRequestLength;
+    else if( handle != NULL )
+      error = mc_directory.write( handle->file, data + 5, count, done );
+    mui64_bytesWritten += done;
+    mui8_busy |= scui8_busyWriting;
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x23, tan );
+    response.push_back( tan );
+    response.push_back( error );
+    push16( response, done );
+  }
+
+
+  void
+  FsServer_c::processClose( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    OpenHandle_s* handle = ( length >= 3 ) ? openHandle( client, data[ 2 ] ) : NULL;
+    if( handle != NULL )
+    {
+      mc_directory.close( handle->file );
+      handle->owner = NULL;
+      --mui32_numOpenFiles;
+    }
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x24, tan );
+    response.push_back( tan );
+    response.push_back( ( handle != NULL ) ? IsoAgLib::fsSuccess : IsoAgLib::fsInvalidHandle );
+  }
+
+
+  void
+  FsServer_c::processMove( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    IsoAgLib::iFsError error = IsoAgLib::fsInvalidRequestLength;
+    if( length >= 7 )
+    {
+      const uint16_t sourceLength = read16( data + 3 );
+      const uint16_t destLength = read16( data + 5 );
+      if( 7 + uint32_t( sourceLength ) + destLength <= length )
+      {
+        FsLocalDirectory_c::Path_t source, dest;
+        const uint16_t manufacturer = client.isoName().manufCode();
+        error = mc_directory.resolve( client.currentDirectory(), data + 7, sourceLength, manufacturer, source );
+        if( error == IsoAgLib::fsSuccess )
+        {
+          error = mc_directory.resolve( client.currentDirectory(), data + 7 + sourceLength, destLength, manufacturer, dest );
+          if( error == IsoAgLib::fsInvalidGivenSourceName )
+            error = IsoAgLib::fsInvalidGivenDestinationName;
+        }
+        if( ( error == IsoAgLib::fsSuccess ) && ( isOpen( source ) || isOpen( dest ) ) )
+          error = IsoAgLib::fsAccessDenied;
+        if( error == IsoAgLib::fsSuccess )
+          error = mc_directory.move( source, dest, ( data[ 2 ] & 0x01 ) != 0, ( data[ 2 ] & 0x02 ) != 0, ( data[ 2 ] & 0x04 ) != 0 );
+      }
+    }
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x30, tan );
+    response.push_back( tan );
+    response.push_back( error );
+  }
+
+
+  void
+  FsServer_c::processDelete( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    const uint8_t* name;
+    uint16_t nameLength;
+    IsoAgLib::iFsError error = IsoAgLib::fsInvalidRequestLength;
+    FsLocalDirectory_c::Path_t path;
+    if( readName( data, length, 3, name, nameLength ) )
+      error = mc_directory.resolve( client.currentDirectory(), name, nameLength, client.isoName().manufCode(), path );
+    if( ( error == IsoAgLib::fsSuccess ) && isOpen( path ) )
+      error = IsoAgLib::fsAccessDenied;
+    if( error == IsoAgLib::fsSuccess )
+      error = mc_directory.remove( path, ( data[ 2 ] & 0x02 ) != 0, ( data[ 2 ] & 0x04 ) != 0 );
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( 0x31, tan );
+    response.push_back( tan );
+    response.push_back( error );
+  }
+
+
+  void
+  FsServer_c::processAttributes( FsServerClient_c& client, uint8_t command, uint8_t tan, const uint8_t* data, uint32_t length )
+  {
+    // Set File Attributes has the attributes before the name
+    const uint32_t lengthPos = ( command == 0x33 ) ? 3 : 2;
+    const uint8_t* name;
+    uint16_t nameLength;
+    IsoAgLib::iFsError error = IsoAgLib::fsInvalidRequestLength;
+    FsLocalDirectory_c::Path_t path;
+    if( readName( data, length, lengthPos, name, nameLength ) )
+      error = mc_directory.resolve( client.currentDirectory(), name, nameLength, client.isoName().manufCode(), path );
+
+    FsLocalDirectory_c::Entry_s entry;
+    if( error == IsoAgLib::fsSuccess )
+    {
+      if( command == 0x33 )
+        error = mc_directory.setAttributes( path, uint8_t( ( data[ 2 ] >> 2 ) & 0x03 ), uint8_t( data[ 2 ] & 0x03 ) );
+      else
+        error = mc_directory.getAttributes( path, entry );
+    }
+
+    STL_NAMESPACE::vector<uint8_t>& response = client.response( command, tan );
+    response.push_back( tan );
+    response.push_back( error );
+    if( command == 0x32 )
+    {
+      response.push_back( ( error == IsoAgLib::fsSuccess ) ? entry.attributes : 0xFF );
+      push32( response, ( error == IsoAgLib::fsSuccess ) ? entry.size : 0xFFFFFFFFUL );
+    }
+    else if( command == 0x34 )
+    {
+      push16( response, ( error == IsoAgLib::fsSuccess ) ? entry.date : 0xFFFF );
+      push16( response, ( error == IsoAgLib::fsSuccess ) ? entry.time : 0xFFFF );
+    }
+  }
+
+}
@@ -0,0 +1,124 @@
+/*
+  fsserver_c.h: ISO 11783-13 file server serving directories of
+    the local file system
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef FSSERVER_C_H
+#define FSSERVER_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <IsoAgLib/scheduler/impl/schedulertask_c.h>
+#include <IsoAgLib/driver/can/impl/cancustomer_c.h>
+#include "fslocaldirectory_c.h"
+
+#include <vector>
+
+
+namespace __IsoAgLib {
+
+class IdentItem_c;
+class FsServerClient_c;
+
+/** File server on the claimed address of an IdentItem_c. Its volumes are
+    directories of the local file system (see FsLocalDirectory_c), so it
+    can stand in for a file server when testing the FS client and serve
+    as the logging file server of a PC based ECU.
+    The requests are answered right when they are received. The clients
+    are told apart by their NAME, they lose their open files when they
+    stop sending their maintenance message.
+  */
+class FsServer_c : public CanCustomer_c
+{
+public:
+  FsServer_c( IdentItem_c& identItem );
+  virtual ~FsServer_c();
+
+  /** add a volume before init(), the first one is the default volume
+      @param name volume name without backslashes
+      @param localPath existing local directory */
+  void addVolume( const char* name, const char* localPath );
+
+  void init();
+  void close();
+
+  unsigned getNumClients() const { return unsigned( mvec_clients.size() ); }
+  unsigned getNumOpenFiles() const { return mui32_numOpenFiles; }
+  uint64_t getBytesRead() const { return mui64_bytesRead; }
+  uint64_t getBytesWritten() const { return mui64_bytesWritten; }
+
+  void timeEvent();
+
+  int getMultitonInst() const;
+  IdentItem_c& identItem() const { return mrc_identItem; }
+
+private:
+  virtual void processMsg( const CanPkg_c& data );
+  virtual bool reactOnStreamStart( const ReceiveStreamIdentifier_c& ident, uint32_t totalLen );
+  virtual bool processPartStreamDataChunk( Stream_c& stream, bool isFirstChunk, bool isLastChunk );
+
+  struct OpenHandle_s {
+    OpenHandle_s() : owner( NULL ), file() {}
+    FsServerClient_c* owner; // NULL if the handle is free
+    FsLocalDirectory_c::OpenFile_s file;
+  };
+
+  FsServerClient_c* client( const IsoName_c& isoName );
+  void closeFiles( const FsServerClient_c& client );
+  /** @return true if the path or something inside it is open */
+  bool isOpen( const FsLocalDirectory_c::Path_t& path ) const;
+  OpenHandle_s* openHandle( const FsServerClient_c& client, uint8_t handle );
+  void sendStatus( ecutime_t now );
+
+  void processRequest( FsServerClient_c& client, const uint8_t* data, uint32_t length );
+  void processProperties( FsServerClient_c& client );
+  void processCurrentDirectory( FsServerClient_c& client, uint8_t tan );
+  void processChangeDirectory( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processOpen( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processSeek( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processRead( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processWrite( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processClose( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processMove( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processDelete( FsServerClient_c& client, uint8_t tan, const uint8_t* data, uint32_t length );
+  void processAttributes( FsServerClient_c& client, uint8_t command, uint8_t tan, const uint8_t* data, uint32_t length );
+
+  CLASS_SCHEDULER_TASK_PROXY(FsServer_c)
+
+  IdentItem_c& mrc_identItem;
+  SchedulerTaskProxy_c m_schedulerTask;
+  FsLocalDirectory_c mc_directory;
+  STL_NAMESPACE::vector<FsServerClient_c*> mvec_clients;
+  STL_NAMESPACE::vector<OpenHandle_s> mvec_handles; // index is the file handle
+  uint32_t mui32_numOpenFiles;
+  uint64_t mui64_bytesRead;
+  uint64_t mui64_bytesWritten;
+
+  ecutime_t mi32_lastStatusSent;
+  uint8_t mui8_busy; // reading/writing since the last status
+  bool mb_receiveRegistered;
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  FsServer_c( const FsServer_c& );
+  /** not copyable : copy operator is only declared, never defined */
+  FsServer_c& operator=( const FsServer_c& );
+};
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+  fsserverclient_c.cpp: session of one file server client
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "fsserverclient_c.h"
+#include "fsserver_c.h"
+
+#include <IsoAgLib/comm/impl/isobus_c.h>
+#include <IsoAgLib/comm/Part3_DataLink/impl/canpkgext_c.h>
+#include <IsoAgLib/comm/Part3_DataLink/impl/multisend_c.h>
+#include <IsoAgLib/comm/Part5_NetworkManagement/impl/identitem_c.h>
+#include <IsoAgLib/comm/Part5_NetworkManagement/impl/isomonitor_c.h>
+
+
+namespace __IsoAgLib {
+
+FsServerClient_c::FsServerClient_c( FsServer_c& server, const IsoName_c& isoName, const FsLocalDirectory_c::Path_t& currentDirectory )
+  : MultiSendEventHandler_c()
+  , mrc_server( server )
+  , mc_isoName( isoName )
+  , mi32_lastSeen( 0 )
+  , m_currentDirectory( currentDirectory )
+  , mvec_request()
+  , mvec_response()
+  , mui8_command( 0 )
+  , mui8_tan( 0 )
+  , mb_responseValid( false )
+  , mb_sending( false )
+  , mb_retrySend( false )
+{
+}
+
+
+FsServerClient_c::~FsServerClient_c()
+{
+  abortSend();
+}
+
+
+STL_NAMESPACE::vector<uint8_t>&
+FsServerClient_c::response( uint8_t command, uint8_t tan )
+{
+  mui8_command = command;
+  mui8_tan = tan;
+  mb_responseValid = true;
+  mvec_response.clear();
+  mvec_response.push_back( command );
+  return mvec_response;
+}
+
+
+void
+FsServerClient_c::sendResponse()
+{
+  IdentItem_c& identItem = mrc_server.identItem();
+  if( !identItem.isClaimedAddress() )
+    return;
+
+  mb_retrySend = false;
+  if( mvec_response.size() <= 8 )
+  {
+    IsoItem_c* item = getIsoMonitorInstance( mrc_server.getMultitonInst() ).item( mc_isoName, true );
+    if( item == NULL )
+      return;
+
+    uint8_t data[ 8 ] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    for( unsigned i = 0; i < mvec_response.size(); ++i )
+      data[ i ] = mvec_response[ i ];
+
+    CanPkgExt_c pkg;
+    pkg.setExtCanPkg8( 0x07, 0x00, FS_TO_CLIENT_PGN >> 8, item->nr(), identItem.getIsoItem()->nr(),
+                       data[ 0 ], data[ 1 ], data[ 2 ], data[ 3 ], data[ 4 ], data[ 5 ], data[ 6 ], data[ 7 ] );
+    getIsoBusInstance( mrc_server.getMultitonInst() ) << pkg;
+    return;
+  }
+
+  mb_sending = getMultiSendInstance( mrc_server.getMultitonInst() ).sendIsoTarget(
+    identItem.isoName(), mc_isoName, &mvec_response[ 0 ], uint32_t( mvec_response.size() ), FS_TO_CLIENT_PGN, this );
+  mb_retrySend = !mb_sending;
+}
+
+
+void
+FsServerClient_c::retrySend()
+{
+  if( mb_retrySend )
+    sendResponse();
+}
+
+
+void
+FsServerClient_c::abortSend()
+{
+  if( mb_sending )
+    getMultiSendInstance( mrc_server.getMultitonInst() ).abortSend( *this );
+  mb_sending = false;
+  mb_retrySend = false;
+}
+
+
+void
+FsServerClient_c::reactOnStateChange( const SendStream_c& sendStream )
+{
+  // an aborted response is sent again when the client repeats its request
+  if( sendStream.getSendSuccess() != SendStream_c::Running )
+    mb_sending = false;
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+  fsserverclient_c.h: session of one file server client
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef FSSERVERCLIENT_C_H
+#define FSSERVERCLIENT_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+#include <IsoAgLib/comm/Part3_DataLink/impl/multisendeventhandler_c.h>
+#include <IsoAgLib/comm/Part5_NetworkManagement/impl/isoname_c.h>
+#include "fslocaldirectory_c.h"
+
+#include <vector>
+
+
+namespace __IsoAgLib {
+
+class FsServer_c;
+
+/** What FsServer_c keeps of a client: its current directory, the request
+    being received and the response of its last request. A client has one
+    request outstanding at a time, a repeated request (same command and
+    TAN) gets the stored response again. Responses of up to 8 bytes are
+    sent as single packet, longer ones by (E)TP, so the sessions of
+    different clients are transferred concurrently.
+  */
+class FsServerClient_c : public MultiSendEventHandler_c
+{
+public:
+  FsServerClient_c( FsServer_c& server, const IsoName_c& isoName, const FsLocalDirectory_c::Path_t& currentDirectory );
+  virtual ~FsServerClient_c();
+
+  const IsoName_c& isoName() const { return mc_isoName; }
+
+  void seen( ecutime_t now ) { mi32_lastSeen = now; }
+  ecutime_t lastSeen() const { return mi32_lastSeen; }
+
+  /** the response is still being sent, no new request is taken */
+  bool isSending() const { return mb_sending || mb_retrySend; }
+
+  bool isRepetition( uint8_t command, uint8_t tan ) const { return mb_responseValid && ( command == mui8_command ) && ( tan == mui8_tan ); }
+
+  STL_NAMESPACE::vector<uint8_t>& request() { return mvec_request; }
+
+  /** start the response to the request */
+  STL_NAMESPACE::vector<uint8_t>& response( uint8_t command, uint8_t tan );
+  void sendResponse();
+  /** start the send again if MultiSend_c was busy */
+  void retrySend();
+  void abortSend();
+
+  FsLocalDirectory_c::Path_t& currentDirectory() { return m_currentDirectory; }
+
+private:
+  virtual void reactOnStateChange( const SendStream_c& sendStream );
+
+  FsServer_c& mrc_server;
+  IsoName_c mc_isoName;
+  ecutime_t mi32_lastSeen;
+  FsLocalDirectory_c::Path_t m_currentDirectory;
+
+  STL_NAMESPACE::vector<uint8_t> mvec_request;
+  STL_NAMESPACE::vector<uint8_t> mvec_response;
+  uint8_t mui8_command;
+  uint8_t mui8_tan;
+  bool mb_responseValid;
+  bool mb_sending;
+  bool mb_retrySend;
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  FsServerClient_c( const FsServerClient_c& );
+  /** not copyable : copy operator is only declared, never defined */
+  FsServerClient_c& operator=( const FsServerClient_c& );
+};
+
+}
+
+#endif
@@ -347,7 +347,11 @@ MultiSend_c::processMsg( const CanPkg_c& arc_data )
   if( runningStream )
   {
     (void)runningStream->processMsg( pkg );
-    calcAndSetNextTriggerTime();
+    if( runningStream->timeHasCome() )
+      // e.g. CTS: send the requested packets right after this batch of CAN messages
+      trigger();
+    else
+      calcAndSetNextTriggerTime();
   }
 }
 
@@ -226,6 +226,7 @@ private:
   friend class __IsoAgLib::TcClientConnection_c;
   friend class iDevPropertyHandler_c;
   friend class iFsManager_c;
+  friend class iFsServer_c;
   friend class iIsoMonitor_c;
   friend class iProcData_c;
   friend class iProprietaryMessageA_c;
@@ -25,6 +25,8 @@
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/ivtclient_c.h>
 #include <IsoAgLib/comm/Part5_NetworkManagement/impl/isomonitor_c.h>
 
+#include <algorithm>
+
 
 namespace __IsoAgLib {
 
@@ -57,6 +59,11 @@ Aux2Functions_c::Aux2Functions_c(VtClientConnection_c& vtClientConnection )
   , m_vtConnection( vtClientConnection )
   , m_state(State_WaitForPoolUploadSuccessfully)
   , mb_learnMode(false)
+  , mvec_dispatch()
+  , mb_dispatchOutdated(true)
+  , mui32_dispatchCount(0)
+  , mui32_maxLatency(0)
+  , mui32_latencySum(0)
 {
 }
 
@@ -148,31 +155,42 @@ Aux2Functions_c::notifyOnAux2InputStatus(
   if (mb_learnMode || ((arc_data.getUint8Data(8-1) & 0x3) != 0))
     return; // do not respond to input status messages in learn mode or learn mode bits are set in received message
 
-  const IsoName_c& c_inputIsoName = arc_data.getISONameForSA();
-  uint16_t const cui16_inputObjectId = arc_data.getUint16Data(2-1);
+  if (mb_dispatchOutdated)
+    buildDispatchTable();
 
-  IsoAgLib::iIsoName_c c_assignedIsoName;
-  uint16_t ui16_assignedInputUid = 0xFFFF;
+  Dispatch_s key;
+  key.inputUid = arc_data.getUint16Data(2-1);
+  STL_NAMESPACE::vector<Dispatch_s>::const_iterator iter = STL_NAMESPACE::lower_bound (mvec_dispatch.begin(), mvec_dispatch.end(), key);
+  if ((iter == mvec_dispatch.end()) || (iter->inputUid != key.inputUid))
+    return; // not assigned to any of our functions
 
-  for (STL_NAMESPACE::map<uint16_t, vtObjectAuxiliaryFunction2_c*>::iterator iter = m_aux2Function.begin(); iter != m_aux2Function.end(); ++iter)
-  {
-    iter->second->getAssignedInput(c_assignedIsoName, ui16_assignedInputUid);
+  const IsoName_c& c_inputIsoName = arc_data.getISONameForSA();
+  const uint16_t cui16_value1 = arc_data.getUint16Data (4-1);
+  const uint16_t cui16_value2 = arc_data.getUint16Data (6-1);
+  const uint8_t cui8_operatingState = arc_data.getUint8Data (8-1);
 
-    if ( (0xFFFF != ui16_assignedInputUid) &&
-         (IsoAgLib::iIsoName_c::iIsoNameUnspecified() != c_assignedIsoName) &&
-         (cui16_inputObjectId == ui16_assignedInputUid) &&
-         (c_inputIsoName == c_assignedIsoName) )
+  bool b_dispatched = false;
+  for (; (iter != mvec_dispatch.end()) && (iter->inputUid == key.inputUid); ++iter)
+  {
+    if (c_inputIsoName == iter->inputIsoName)
     { // notify application on this new Input Status!
-      const uint16_t cui16_value1 = arc_data.getUint16Data (4-1);
-      const uint16_t cui16_value2 = arc_data.getUint16Data (6-1);
-      const uint8_t cui8_operatingState = arc_data.getUint8Data (8-1);
-
-      // skip any (wrong) messages that indicate LEARN mode. (should only have been sent to the VT, not the implement!)
-      if( ( cui8_operatingState & 0x3 ) != 0 )
-        continue;
+      arc_pool.eventAuxFunction2Value (iter->functionUid, cui16_value1, cui16_value2, cui8_operatingState);
+      b_dispatched = true;
+    }
+  }
 
-      arc_pool.eventAuxFunction2Value (iter->first, cui16_value1, cui16_value2, cui8_operatingState);
+  if (b_dispatched)
+  {
+    const uint32_t latency = uint32_t( HAL::getTime() - arc_data.time() );
+    if( ( mui32_latencySum > 0xFFFFFFFFUL - latency ) || ( mui32_dispatchCount == 0xFFFFFFFFUL ) )
+    { // halve both instead of overflowing, the average stays about the same
+      mui32_latencySum /= 2;
+      mui32_dispatchCount /= 2;
     }
+    ++mui32_dispatchCount;
+    mui32_latencySum += latency;
+    if (latency > mui32_maxLatency)
+      mui32_maxLatency = latency;
   }
 #else
   (void)arc_data;
@@ -180,6 +198,29 @@ Aux2Functions_c::notifyOnAux2InputStatus(
 #endif
 }
 
+void
+Aux2Functions_c::buildDispatchTable()
+{
+  mvec_dispatch.clear();
+#ifdef USE_VTOBJECT_auxiliaryfunction2
+  for (STL_NAMESPACE::map<uint16_t, vtObjectAuxiliaryFunction2_c*>::const_iterator iter = m_aux2Function.begin(); iter != m_aux2Function.end(); ++iter)
+  {
+    Dispatch_s entry;
+    iter->second->getAssignedInput(entry.inputIsoName, entry.inputUid);
+
+    if ( (0xFFFF != entry.inputUid) &&
+         (IsoAgLib::iIsoName_c::iIsoNameUnspecified() != entry.inputIsoName) )
+    {
+      entry.functionUid = iter->first;
+      mvec_dispatch.push_back (entry);
+    }
+  }
+  STL_NAMESPACE::stable_sort (mvec_dispatch.begin(), mvec_dispatch.end());
+#endif
+  mb_dispatchOutdated = false;
+}
+
+
 void
 Aux2Functions_c::notifyOnAux2InputMaintenance( const CanPkgExt_c& arc_data )
 {
@@ -304,6 +345,8 @@ Aux2Functions_c::storeAux2Assignment(
   // set reference of function object ID (is needed for response in caller)
   rui16_functionObjId = (c_buffer[13-2] | (c_buffer[14-2] << 8));
 
+  invalidateDispatchTable();
+
   if (0xFFFF == rui16_functionObjId)
   { // unassign ALL functions
     for (STL_NAMESPACE::map<uint16_t, vtObjectAuxiliaryFunction2_c*>::iterator iter = m_aux2Function.begin(); iter != m_aux2Function.end(); ++iter)
@@ -394,8 +437,11 @@ Aux2Functions_c::timeEvent()
       for (STL_NAMESPACE::map<uint16_t, vtObjectAuxiliaryFunction2_c*>::const_iterator iter_function = m_aux2Function.begin();
           iter_function != m_aux2Function.end(); ++iter_function)
       {
-        if( iter_function->second->unassignAfterTimeout(iter_map->first.toConstIisoName_c()) )            
+        if( iter_function->second->unassignAfterTimeout(iter_map->first.toConstIisoName_c()) )
+        {
+          invalidateDispatchTable();
           m_vtConnection.getPool().aux2AssignmentChanged( *( static_cast<IsoAgLib::iVtObjectAuxiliaryFunction2_c*>( iter_function->second ) ) );
+        }
       }
       mmap_receivedInputMaintenanceData.erase(iter_map++);
     } else {
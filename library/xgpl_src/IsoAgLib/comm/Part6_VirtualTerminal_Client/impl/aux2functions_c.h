@@ -29,6 +29,7 @@
 #include "../ivtobjectauxiliaryfunction2_c.h"
 
 #include <map>
+#include <vector>
 
 
 namespace __IsoAgLib {
@@ -60,7 +61,7 @@ public:
   bool setUserPreset( bool firstClearAllPAs, const IsoAgLib::iAux2Assignment_c &assigment );
 
 #ifdef USE_VTOBJECT_auxiliaryfunction2
-  STL_NAMESPACE::map<uint16_t, vtObjectAuxiliaryFunction2_c*>& getObjects() { return m_aux2Function; }
+  STL_NAMESPACE::map<uint16_t, vtObjectAuxiliaryFunction2_c*>& getObjects() { invalidateDispatchTable(); return m_aux2Function; }
 #endif
 
   void notifyOnAux2InputStatus( const CanPkgExt_c& arc_data, IsoAgLib::iVtClientObjectPool_c& arc_pool);
@@ -91,7 +92,27 @@ public:
 
   void setLearnMode(bool a_learnMode) { mb_learnMode = a_learnMode; }
 
+  /** time from the reception of an Input Status message to the return of the
+      application's eventAuxFunction2Value() call(s) in [msec.] */
+  uint32_t getInputStatusMaxLatency() const { return mui32_maxLatency; }
+  uint32_t getInputStatusAverageLatency() const { return ( mui32_dispatchCount > 0 ) ? ( mui32_latencySum / mui32_dispatchCount ) : 0; }
+  void resetInputStatusLatency() { mui32_dispatchCount = 0; mui32_maxLatency = 0; mui32_latencySum = 0; }
+
 private:
+  // assigned input -> function, sorted by input object ID (stable, so functions stay ordered by ID)
+  struct Dispatch_s
+  {
+    bool operator<(const Dispatch_s& ref) const { return inputUid < ref.inputUid; }
+
+    uint16_t inputUid;
+    IsoAgLib::iIsoName_c inputIsoName;
+    uint16_t functionUid;
+  };
+
+  /// (re)build mvec_dispatch from the functions' assignments
+  void buildDispatchTable();
+  void invalidateDispatchTable() { mb_dispatchOutdated = true; }
+
 
   // use this structure to store received data from input maintenance message in map with isoname as key
   struct InputMaintenanceDataForIsoName_s
@@ -127,6 +148,13 @@ private:
 
   bool mb_learnMode;
 
+  STL_NAMESPACE::vector<Dispatch_s> mvec_dispatch;
+  bool mb_dispatchOutdated;
+
+  uint32_t mui32_dispatchCount;
+  uint32_t mui32_maxLatency;
+  uint32_t mui32_latencySum;
+
 private:
   /** not copyable : copy constructor is only declared, never defined */
   Aux2Functions_c(const Aux2Functions_c&);
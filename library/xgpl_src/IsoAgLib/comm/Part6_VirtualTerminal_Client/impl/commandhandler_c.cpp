@@ -33,6 +33,8 @@
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtclientconnection_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtserverinstance_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtobjectstring_c.h>
+#include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/objectpoolimage_c.h>
+#include <IsoAgLib/util/impl/util_funcs.h>
 #include <supplementary_driver/driver/datastreams/volatilememorywithsize_c.h>
 
 
@@ -101,6 +103,75 @@ static const uint8_t scpui8_cmdCompareTable[(scui8_cmdCompareTableMax-scui8_cmdC
 /* 0xBD */ (1<<0) //NEVER OVERRIDE THIS COMMAND (Lock/Unlock Mask)
 };
 
+/// @return key of the bytes that decide if a queued command is replaced by this one,
+///         0 if it never replaces (or gets replaced by) another command
+static SendUploadQueue_c::Key_t
+replaceKey( const SendUpload_c& ar_sendUpload )
+{
+  if( ar_sendUpload.mc_streamer != NULL )
+  { // same key as the buffer variant of the command: byte 0 and the object ID
+    const uint16_t id = ar_sendUpload.mc_streamer->getID();
+    return SendUploadQueue_c::Key_t( ar_sendUpload.mc_streamer->getFirstByte() )
+      | ( SendUploadQueue_c::Key_t( id & 0xFF ) << 8 )
+      | ( SendUploadQueue_c::Key_t( id >> 8 ) << 16 );
+  }
+
+  if( ar_sendUpload.vec_uploadBuffer.size() < 8 )
+    return 0;
+
+  const uint8_t ui8_offset = ar_sendUpload.vec_uploadBuffer[0];
+  if( ui8_offset == 0x22 )
+    return 0x22; // Preferred Assignment: a newer one always replaces the queued one
+
+  // e.g. 0x11, 0x12 or Proprietary commands (we don't need the replace-feature here!)
+  if( (ui8_offset < scui8_cmdCompareTableMin) || (ui8_offset > scui8_cmdCompareTableMax) )
+    return 0;
+
+  const uint8_t ui8_bitmask = scpui8_cmdCompareTable [ui8_offset-scui8_cmdCompareTableMin];
+  isoaglib_assert( ui8_bitmask != 0 ); // unused/reserved commands must not be in the queue!
+  if( (ui8_bitmask == 0) || (ui8_bitmask & (1 << 0)) )
+    return 0;
+
+  SendUploadQueue_c::Key_t key = ui8_offset;
+  for( unsigned i = 1; i <= 7; ++i )
+  {
+    if( ui8_bitmask & (1 << i) )
+      key |= SendUploadQueue_c::Key_t( ar_sendUpload.vec_uploadBuffer[i] ) << ( 8 * i );
+  }
+  return key;
+}
+
+/// @return true for the commands the VT state is shadowed for, giving the object and the value
+static bool
+shadowValue( const SendUpload_c& ar_sendUpload, uint16_t& rui16_objId, uint32_t& rui32_value )
+{
+  // string values sent by reference may still change until they're streamed
+  if( ( ar_sendUpload.mc_streamer != NULL ) || ( ar_sendUpload.vec_uploadBuffer.size() < 8 ) )
+    return false;
+
+  const STL_NAMESPACE::vector<uint8_t>& buffer = ar_sendUpload.vec_uploadBuffer;
+  rui16_objId = uint16_t( buffer[1] | ( buffer[2] << 8 ) );
+  switch( buffer[0] )
+  {
+  case 0xA0: // Hide/Show Object
+    rui32_value = buffer[3];
+    return true;
+
+  case 0xA8: // Change Numeric Value
+    rui32_value = convertLittleEndianStringUi32( &buffer[4] );
+    return true;
+
+  case 0xB3: // Change String Value: length and characters
+    // only a hash is kept to have fixed size entries: a new string colliding
+    // with the one shown (chance 2^-32) isn't sent, see enableShadowStateCheck()
+    rui32_value = ObjectPoolImage_c::hash( &buffer[3], uint32_t( buffer.size() - 3 ) );
+    return true;
+
+  default:
+    return false;
+  }
+}
+
 CommandHandler_c::~CommandHandler_c()
 {
   men_uploadCommandState = UploadCommandDestructing;
@@ -205,7 +276,7 @@ CommandHandler_c::sendCommandDeleteObjectPool()
     if( (UploadCommandIdle != men_uploadCommandState) && ( priority == mu_sendPriorityOfLastCommand ))
     {
       isoaglib_assert( ! mq_sendUpload[ priority ].empty() );
-      mq_sendUpload[ priority ].erase( ++(mq_sendUpload[ priority ].begin()), mq_sendUpload[ priority ].end() );
+      mq_sendUpload[ priority ].clearAllButFront();
     }
     else
     {
@@ -213,8 +284,16 @@ CommandHandler_c::sendCommandDeleteObjectPool()
     }
   }
 
-  return sendCommand (178 /* Command: Command --- Parameter: Delete Object Pool */,
+  // collected commands are obsolete, too. Don't collect the Delete itself.
+  mc_transaction.clear();
+  const unsigned transactionDepth = mui_transactionDepth;
+  mui_transactionDepth = 0;
+
+  const bool retval = sendCommand (178 /* Command: Command --- Parameter: Delete Object Pool */,
                       0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, true); // don't care for enableReplaceOfCommand parameter actually
+
+  mui_transactionDepth = transactionDepth;
+  return retval;
 }
 
 
@@ -791,135 +870,39 @@ CommandHandler_c::queueOrReplace (SendUpload_c& ar_sendUpload, bool b_enableRepl
   if( !m_connection.poolSuccessfullyUploaded() )
     return false;
 
-#ifdef OPTIMIZE_HEAPSIZE_IN_FAVOR_OF_SPEED
-  STL_NAMESPACE::list<SendUpload_c,MALLOC_TEMPLATE(SendUpload_c) >::iterator i_sendUpload;
-#else
-  STL_NAMESPACE::list<SendUpload_c>::iterator i_sendUpload;
-#endif
+  const SendUploadQueue_c::Key_t key = replaceKey( ar_sendUpload );
 
-  if( mb_checkSameCommand && b_enableReplaceOfCmd )
+  if( mui_transactionDepth > 0 )
+  { // collect until commit, superseded values get collapsed right here
+    const SendUploadQueue_c::Key_t batchKey = ( mb_checkSameCommand && b_enableReplaceOfCmd ) ? key : 0;
+    if( ( batchKey == 0 ) || !mc_transaction.replace( batchKey, &ar_sendUpload, false ) )
+      mc_transaction.push_back( ar_sendUpload, batchKey );
+    return true;
+  }
+
+  if( mb_checkShadowState && ( key != 0 ) )
+  {
+    uint16_t objId;
+    uint32_t value;
+    if( shadowValue( ar_sendUpload, objId, value )
+        && mc_shadowState.matches( ar_sendUpload.vec_uploadBuffer[0], objId, value )
+        && !isQueued( key ) )
+      return true; // the VT already shows this value
+  }
+
+  if( mb_checkSameCommand && b_enableReplaceOfCmd && ( key != 0 ) )
   {
     bool alreadyReplacedFirstMatchingCommand = false;
 
     for( unsigned prio = mu_sendPriority; prio < CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES; ++prio )
     {
-      STL_NAMESPACE::list<SendUpload_c>& q_sendUpload = mq_sendUpload[prio];
-
-      if( !q_sendUpload.empty() )
-      { //get first equal command in queue
-        i_sendUpload = q_sendUpload.begin();
-        if( (men_uploadCommandState != UploadCommandIdle) && (mu_sendPriorityOfLastCommand == prio) )		// Need to check that we're looking at the correct queue, before skipping the first item!
-        { // the first item in the queue is currently in upload process - so do NOT use this for replacement, as the next action
-          // after receive of the awaited ACK is simple erase of the first command
-          ++i_sendUpload;
-        }
-        while( i_sendUpload != q_sendUpload.end() )
-        {
-          bool thisCommandMatched = false;
-
-          //first check if multisendstreamer is used!
-          /* four cases:
-          1. both use buffer
-          2. buffer is queued and could be replaced by mssObjectString
-          3. mss is queued and could be replaced by buffer
-          4. both use mssObjectString
-            */
-          if (i_sendUpload->mc_streamer == NULL)
-          {
-            if (ar_sendUpload.mc_streamer == NULL)
-            {
-               // 1. both use buffer
-              if (i_sendUpload->vec_uploadBuffer[0] == ar_sendUpload.vec_uploadBuffer[0])
-              {
-                uint8_t ui8_offset = (ar_sendUpload.vec_uploadBuffer[0]);
-                if( ui8_offset == 0x22 )
-                { // Preferred Assignment
-                  thisCommandMatched = true;
-                }
-                else
-                {
-                  if ( (ui8_offset<scui8_cmdCompareTableMin) || (ui8_offset > scui8_cmdCompareTableMax))
-                  { // only 0x12 is possible, but no need to override, it shouldn't occur anyway!
-                    if ((ui8_offset == 0x11) || (ui8_offset == 0x12) ||
-                        ((ui8_offset >= 0x60) && (ui8_offset <= 0x7F)) ) /// no checking for Proprietary commands (we don't need the replace-feature here!)
-                      break;
-
-                    isoaglib_assert( !"Shouldn't reach here. Check which command it was!" );
-                    return false;
-                  }
-                  // get bitmask for the corresponding command
-                  uint8_t ui8_bitmask = scpui8_cmdCompareTable [ui8_offset-scui8_cmdCompareTableMin];
-                  isoaglib_assert( ui8_bitmask != 0 ); // unused/reserved commands must not be in the queue!
-                  if( !(ui8_bitmask & (1 << 0)) )
-                  { // go Check for overwrite...
-                    uint8_t i;
-                    for (i=1;i<=7;i++)
-                    {
-                      if (((ui8_bitmask & 1<<i) !=0) && !(i_sendUpload->vec_uploadBuffer[i] == ar_sendUpload.vec_uploadBuffer[i]))
-                        break;
-                    }
-                    if (!(i<=7))
-                    { // loop ran through, all to-compare-bytes matched!
-                      thisCommandMatched = true;
-                    }
-                  }
-                }
-              }
-            }
-            else
-            {
-              // 2. buffer is queued and could be replaced by mssObjectString
-              if ((*i_sendUpload).vec_uploadBuffer[0] == ar_sendUpload.mc_streamer->getFirstByte())
-              {
-                if (((*i_sendUpload).vec_uploadBuffer[1] | (*i_sendUpload).vec_uploadBuffer[2]<<8) == ar_sendUpload.mc_streamer->getID())
-                  thisCommandMatched = true;
-              }
-            }
-          }
-          else
-          {
-            // i_sendUpload->mssObjectString != NULL
-            if (ar_sendUpload.mc_streamer == NULL)
-            {
-              // 3. mss is queued and could be replaced by buffer
-              if ((*i_sendUpload).mc_streamer->getFirstByte() == ar_sendUpload.vec_uploadBuffer[0])
-              {
-                if ((*i_sendUpload).mc_streamer->getID() == (ar_sendUpload.vec_uploadBuffer[1] | (ar_sendUpload.vec_uploadBuffer[2]<<8)))
-                  thisCommandMatched = true;
-              }
-            }
-            else
-            {
-              // 4. both use mssObjectString
-              if ((*i_sendUpload).mc_streamer->getFirstByte() == ar_sendUpload.mc_streamer->getFirstByte())
-              {
-                if ((*i_sendUpload).mc_streamer->getID() == ar_sendUpload.mc_streamer->getID())
-                  thisCommandMatched = true;
-              }
-            }
-          } // if
+      // the first item in the queue may currently be in upload process - so do NOT use this for replacement, as the next action
+      // after receive of the awaited ACK is simple erase of the first command
+      const bool skipFront = (men_uploadCommandState != UploadCommandIdle) && (mu_sendPriorityOfLastCommand == prio);
 
-          if( thisCommandMatched )
-          {
-            if( alreadyReplacedFirstMatchingCommand )
-            {
-		          // Further instances of this command have been found, so delete them from the queue!
-		          i_sendUpload = q_sendUpload.erase( i_sendUpload );
-	          }
-	          else
-	          {
-		          *i_sendUpload = ar_sendUpload; // overloaded "operator=", so overwrite this SendUpload_c with the new value one
-		          ++i_sendUpload;
-
-              alreadyReplacedFirstMatchingCommand = true;
-	          }
-          }
-          else
-          {
-	          ++i_sendUpload;
-          }
-        } // for
-      }
+      // Further instances of this command are deleted from the queue!
+      if( mq_sendUpload[ prio ].replace( key, alreadyReplacedFirstMatchingCommand ? NULL : &ar_sendUpload, skipFront ) )
+        alreadyReplacedFirstMatchingCommand = true;
     }
 
     if( alreadyReplacedFirstMatchingCommand )
@@ -928,7 +911,7 @@ CommandHandler_c::queueOrReplace (SendUpload_c& ar_sendUpload, bool b_enableRepl
 
   const bool wasFilledBefore = queueFilled();
 
-  mq_sendUpload[ mu_sendPriority ].push_back( ar_sendUpload );
+  mq_sendUpload[ mu_sendPriority ].push_back( ar_sendUpload, key );
 
   // call after push(_back), so it's already available at call-time!
   if( !wasFilledBefore )
@@ -938,21 +921,72 @@ CommandHandler_c::queueOrReplace (SendUpload_c& ar_sendUpload, bool b_enableRepl
 }
 
 
+void
+CommandHandler_c::commitTransaction()
+{
+  isoaglib_assert( mui_transactionDepth > 0 );
+  if( ( mui_transactionDepth == 0 ) || ( --mui_transactionDepth > 0 ) )
+    return;
+
+  // queue in the order of the first change, each with its latest value
+  while( !mc_transaction.empty() )
+  {
+    SendUpload_c& batched = mc_transaction.front();
+    // a streamer is owned by the send queue if queued (which is always the case when accepted)
+    if( queueOrReplace( batched, mc_transaction.frontKey() != 0 ) )
+      batched.unsetStreamer();
+    mc_transaction.pop_front();
+  }
+}
+
+
+bool
+CommandHandler_c::isQueued( SendUploadQueue_c::Key_t key ) const
+{
+  for( unsigned prio = 0; prio < CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES; ++prio )
+  {
+    if( mq_sendUpload[ prio ].contains( key ) )
+      return true;
+  }
+  return false;
+}
+
+
+void
+CommandHandler_c::updateShadowState( bool ab_success )
+{
+  const SendUpload_c& actSend = mq_sendUpload[ mu_sendPriorityOfLastCommand ].front();
+
+  uint16_t objId;
+  uint32_t value;
+  if( shadowValue( actSend, objId, value ) )
+  {
+    if( ab_success )
+      mc_shadowState.set( actSend.vec_uploadBuffer[0], objId, value );
+    else
+      mc_shadowState.invalidate( actSend.vec_uploadBuffer[0], objId );
+  }
+  else if( actSend.mc_streamer != NULL )
+  { // value is unknown now
+    mc_shadowState.invalidate( actSend.mc_streamer->getFirstByte(), actSend.mc_streamer->getID() );
+  }
+}
+
+
 void
 CommandHandler_c::dumpQueue()
 {
 #if DEBUG_VTCOMM
-#ifdef OPTIMIZE_HEAPSIZE_IN_FAVOR_OF_SPEED
-  STL_NAMESPACE::list<SendUpload_c,MALLOC_TEMPLATE(SendUpload_c) >::iterator i_sendUpload;
-#else
-  STL_NAMESPACE::list<SendUpload_c>::iterator i_sendUpload;
-#endif
   for (unsigned prio=0; prio < CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES; ++prio)
   {
     INTERNAL_DEBUG_DEVICE << "Queue with Priority " << prio << ": ";
 
-    for (i_sendUpload = mq_sendUpload[ prio ].begin(); i_sendUpload != mq_sendUpload[ prio ].end(); ++i_sendUpload)
+    for (unsigned pos = 0; pos < mq_sendUpload[ prio ].slots(); ++pos)
     {
+      const SendUpload_c* i_sendUpload = mq_sendUpload[ prio ].slot( pos );
+      if (i_sendUpload == NULL)
+        continue; // removed by replacement
+
       if (i_sendUpload->mc_streamer == NULL)
       {
         for (uint8_t i=0; i<=7; i++)
@@ -985,7 +1019,7 @@ CommandHandler_c::tryToStart()
   {
     if( queueFilled( priority ) )
     {
-      STL_NAMESPACE::list<SendUpload_c>& q_sendUpload = mq_sendUpload[ priority ];
+      SendUploadQueue_c& q_sendUpload = mq_sendUpload[ priority ];
 
 
       men_uploadCommandState = UploadCommandWithAwaitingResponse;
@@ -1012,6 +1046,8 @@ CommandHandler_c::tryToStart()
             m_connection.uploadPoolState().initObjectPoolUploadingPhases(
               UploadPoolState_c::UploadPoolTypeLanguageUpdate );
           }
+          // the objects get (re-)uploaded with their current values
+          mc_shadowState.clear();
           m_connection.uploadPoolState().startCurrentUploadPhase();
 
           men_uploadCommandState = UploadCommandPartialPoolUpdate; // There's NO response for command 0x11! And there may be multiple parts!
@@ -1092,7 +1128,7 @@ CommandHandler_c::tryToStart()
 void
 CommandHandler_c::finishUploadCommand()
 {
-  STL_NAMESPACE::list<SendUpload_c>& q_sendUpload = mq_sendUpload[ mu_sendPriorityOfLastCommand ];
+  SendUploadQueue_c& q_sendUpload = mq_sendUpload[ mu_sendPriorityOfLastCommand ];
 
   isoaglib_assert( !q_sendUpload.empty() );
   isoaglib_assert( men_uploadCommandState != UploadCommandIdle );
@@ -1202,9 +1238,14 @@ CommandHandler_c::processMsgVtToEcuActivations( const CanPkgExt_c& pkg )
         pkg.getUint8Data( 4 ) /* 1 byte value */,
         (uint32_t(pkg.getUint8Data( 4 ))      ) | (uint32_t(pkg.getUint8Data( 5 )) << 8) |
         (uint32_t(pkg.getUint8Data( 6 )) << 16) | (uint32_t(pkg.getUint8Data( 7 )) << 24) /* 4 byte value */);
+    if( mb_checkShadowState )
+      mc_shadowState.set( 0xA8, uint16_t(pkg.getUint8Data( 1 )) | (uint16_t(pkg.getUint8Data( 2 )) << 8),
+                          convertLittleEndianStringUi32( pkg.getUint8DataConstPointer( 4 ) ) );
     break;
 
   case 0x08:  // Command: "Control Element Function", parameter "VT Input String Value"
+    if( mb_checkShadowState )
+      mc_shadowState.invalidate( 0xB3, uint16_t(pkg.getUint8Data( 1 )) | (uint16_t(pkg.getUint8Data( 2 )) << 8) );
     if (pkg.getUint8Data( 3 ) <= 4) //within a 8 byte long cmd can be only a 4 char long string
     {
       VolatileMemoryWithSize_c c_vmString (pkg.getUint8DataConstPointer( 4 ), pkg.getUint8Data( 3 ));
@@ -1279,6 +1320,8 @@ CommandHandler_c::processMsgVtToEcuActivations( Stream_c &stream )
       const uint8_t thirdByte = stream.getNextNotParsed();
       const uint16_t inputStringId = uint16_t( secondByte ) | ( uint16_t( thirdByte ) << 8 );
       const unsigned inputStringLength = stream.getNextNotParsed();
+      if( mb_checkShadowState )
+        mc_shadowState.invalidate( 0xB3, inputStringId );
 
       const uint16_t ui16_totalstreamsize = stream.getByteTotalSize();
       if( ui16_totalstreamsize >= (inputStringLength + 4) )
@@ -1522,6 +1565,9 @@ CommandHandler_c::finalizeCommand( unsigned errByte, const uint8_t *dataBytes )
       const uint8_t ui8_uploadCommandError = ((mui8_commandParameter == 0xB9) && ((uint16_t(dataBytes[ 2-1 ]) | uint16_t(dataBytes[ 3-1 ])<<8) != 0xFFFF))
                                                ? 0 : dataBytes[ errByte-1 ];
 
+      if( mb_checkShadowState )
+        updateShadowState( ui8_uploadCommandError == 0 );
+
       m_connection.getPool().eventCommandResponse( ui8_uploadCommandError, dataBytes ); // pass "ui8_uploadCommandError" in case it's only important if it's an error or not. get Cmd and all databytes from "arc_data.name()"
       finishUploadCommand();
     }
@@ -1540,6 +1586,9 @@ CommandHandler_c::doStop()
   {
     mq_sendUpload[ priority ].clear();
   }
+  // pool gets uploaded again, maybe to another VT
+  mc_shadowState.clear();
+  mc_transaction.clear();
 
   men_uploadCommandState = UploadCommandIdle;
 }
@@ -21,9 +21,9 @@
 #define COMMANDHANDLER_H
 
 #include <IsoAgLib/isoaglib_config.h>
-#include "sendupload_c.h"
+#include "senduploadqueue_c.h"
+#include "vtshadowstate_c.h"
 
-#include <list>
 
 #ifdef USE_ISO_TERMINAL_GRAPHICCONTEXT
 namespace IsoAgLib { class iVtObjectLineAttributes_c; }
@@ -175,8 +175,26 @@ public:
   void enableSameCommandCheck() { mb_checkSameCommand = true; }
   void disableSameCommandCheck() { mb_checkSameCommand = false; }
 
+  /** drop Change Numeric Value, Change String Value and Hide/Show Object
+      commands if the VT acknowledged exactly this value before and no
+      other command for the object is pending.
+      Don't enable this if macros on the VT change these values! */
+  void enableShadowStateCheck() { mb_checkShadowState = true; }
+  void disableShadowStateCheck() { mb_checkShadowState = false; mc_shadowState.clear(); }
+
+  /** collect all following commands until the matching commitTransaction().
+      Superseded values of the same object/attribute get collapsed before
+      anything is queued for sending. Transactions can be nested. */
+  void beginTransaction() { ++mui_transactionDepth; }
+  void commitTransaction();
+  /// discard all collected commands, also of outer transactions
+  void abortTransaction() { mc_transaction.clear(); mui_transactionDepth = 0; }
+  bool inTransaction() const { return mui_transactionDepth > 0; }
+
 private:
   void dumpQueue();
+  bool isQueued( SendUploadQueue_c::Key_t key ) const;
+  void updateShadowState( bool ab_success );
   void finalizeCommand( unsigned errByte, const uint8_t *dataBytes );
 
   // MultiSendEventHandler_c
@@ -191,11 +209,7 @@ private:
   ecutime_t mi32_commandTimestamp;
   int32_t mi32_commandTimeout;
 
-  #ifdef OPTIMIZE_HEAPSIZE_IN_FAVOR_OF_SPEED
-  STL_NAMESPACE::list<SendUpload_c,MALLOC_TEMPLATE(SendUpload_c) >  mq_sendUpload[ CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES ];
-  #else
-  STL_NAMESPACE::list<SendUpload_c> mq_sendUpload[ CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES ];
-  #endif
+  SendUploadQueue_c mq_sendUpload[ CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES ];
 
   unsigned mu_sendPriority;
   unsigned mu_sendPriorityOfLastCommand;
@@ -204,6 +218,12 @@ private:
 
   bool mb_checkSameCommand;
   bool mb_commandsToBus;
+
+  VtShadowState_c mc_shadowState;
+  bool mb_checkShadowState;
+
+  SendUploadQueue_c mc_transaction;
+  unsigned mui_transactionDepth;
 };
 
 
@@ -218,6 +238,10 @@ CommandHandler_c::CommandHandler_c( VtClientConnection_c &connection )
   , mu_sendPriorityOfLastCommand( 0 )
   , mb_checkSameCommand( true )
   , mb_commandsToBus( true )
+  , mc_shadowState()
+  , mb_checkShadowState( false )
+  , mc_transaction()
+  , mui_transactionDepth( 0 )
 {
 }
 
@@ -0,0 +1,92 @@
+/*
+  languagedelta_c.cpp: objects of a language part which serialize
+    differently than those of another language part
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "languagedelta_c.h"
+#include "vtobject_c.h"
+
+#include <IsoAgLib/comm/Part6_VirtualTerminal_Client/ivtclientobjectpool_c.h>
+#include <IsoAgLib/util/iassert.h>
+
+
+namespace __IsoAgLib {
+
+
+LanguageDelta_c::LanguageDelta_c()
+  : ms_properties()
+  , mvec_hashes()
+  , m_hashedLanguages()
+  , mvec_objects()
+{
+}
+
+
+uint32_t
+LanguageDelta_c::objectHash(
+  uint8_t aui8_language, uint16_t aui16_index,
+  const IsoAgLib::iVtClientObjectPool_c& arc_pool, const UploadPoolState_c& arc_uploadPoolState )
+{
+  IsoAgLib::iVtObject_c* const HUGE_MEM* objects = arc_pool.getIVtObjects()[ aui8_language + 1 ];
+
+  // changed objects may change again, so they're hashed every time
+  if( static_cast<const vtObject_c*>( objects[ aui16_index ] )->isChangedInRam() )
+    return ObjectPoolImage_c::hashObjects( &objects[ aui16_index ], 1, arc_uploadPoolState );
+
+  const uint32_t numObjects = arc_pool.getNumObjectsLang();
+  if( !m_hashedLanguages.isBitSet( aui8_language ) )
+  {
+    for( uint16_t i = 0; i < numObjects; ++i )
+      mvec_hashes[ aui8_language * numObjects + i ] = ObjectPoolImage_c::hashObjects( &objects[ i ], 1, arc_uploadPoolState );
+    m_hashedLanguages.setBit( aui8_language );
+  }
+  return mvec_hashes[ aui8_language * numObjects + aui16_index ];
+}
+
+
+uint16_t
+LanguageDelta_c::collect(
+  const PoolImageProperties_s& arc_properties, uint8_t aui8_source, uint8_t aui8_target,
+  const IsoAgLib::iVtClientObjectPool_c& arc_pool, const UploadPoolState_c& arc_uploadPoolState )
+{
+  isoaglib_assert( ( aui8_source < arc_pool.getNumLang() ) && ( aui8_target < arc_pool.getNumLang() ) );
+
+  PoolImageProperties_s properties = arc_properties;
+  properties.language = -1;
+  if( !( properties == ms_properties )
+   || ( mvec_hashes.size() != size_t( arc_pool.getNumLang() ) * arc_pool.getNumObjectsLang() ) )
+  { // the objects get fitted differently now
+    ms_properties = properties;
+    mvec_hashes.assign( size_t( arc_pool.getNumLang() ) * arc_pool.getNumObjectsLang(), 0 );
+    m_hashedLanguages.reset();
+  }
+
+  mvec_objects.clear();
+  if( aui8_source == aui8_target )
+    return 0; // e.g. from a rejected language to the default language
+
+  for( uint16_t i = 0; i < arc_pool.getNumObjectsLang(); ++i )
+  {
+    if( objectHash( aui8_source, i, arc_pool, arc_uploadPoolState ) != objectHash( aui8_target, i, arc_pool, arc_uploadPoolState ) )
+      mvec_objects.push_back( arc_pool.getIVtObjects()[ aui8_target + 1 ][ i ] );
+  }
+  return numObjects();
+}
+
+
+} // __IsoAgLib
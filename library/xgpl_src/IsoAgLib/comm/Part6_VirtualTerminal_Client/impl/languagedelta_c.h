@@ -0,0 +1,80 @@
+/*
+  languagedelta_c.h: objects of a language part which serialize
+    differently than those of another language part
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef LANGUAGEDELTA_C_H
+#define LANGUAGEDELTA_C_H
+
+#include "objectpoolimage_c.h"
+#include <IsoAgLib/util/impl/bitfieldwrapper_c.h>
+#include <vector>
+
+
+namespace IsoAgLib {
+  class iVtClientObjectPool_c;
+}
+
+
+namespace __IsoAgLib {
+
+
+/** On a language change only the language dependent objects whose
+    serialized bytes differ between the language on the VT and the new
+    one need to be uploaded. The objects are compared by the hash of
+    their serialization, which is kept per language and object as long
+    as the object is unchanged (no RAM copy of its attributes) and the
+    PoolImageProperties_s (except the language) stay the same.
+  */
+class LanguageDelta_c
+{
+public:
+  LanguageDelta_c();
+
+  void invalidate() { m_hashedLanguages.reset(); }
+
+  /** collect the objects of the target language part which serialize
+      differently than the ones of the source language part
+      @param arc_properties properties the objects are fitted to, the language is ignored
+      @return number of objects collected, see objects() */
+  uint16_t collect( const PoolImageProperties_s& arc_properties, uint8_t aui8_source, uint8_t aui8_target,
+                    const IsoAgLib::iVtClientObjectPool_c& arc_pool, const UploadPoolState_c& arc_uploadPoolState );
+
+  IsoAgLib::iVtObject_c* const HUGE_MEM* objects() const { return mvec_objects.empty() ? NULL : &mvec_objects[ 0 ]; }
+  uint16_t numObjects() const { return uint16_t( mvec_objects.size() ); }
+
+private:
+  uint32_t objectHash( uint8_t aui8_language, uint16_t aui16_index,
+                       const IsoAgLib::iVtClientObjectPool_c& arc_pool, const UploadPoolState_c& arc_uploadPoolState );
+
+  PoolImageProperties_s ms_properties; // the hashes were calculated for
+  STL_NAMESPACE::vector<uint32_t> mvec_hashes; // numObjectsLang per language
+  IsoaglibArrayBitset<64> m_hashedLanguages;
+  STL_NAMESPACE::vector<IsoAgLib::iVtObject_c*> mvec_objects;
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  LanguageDelta_c(const LanguageDelta_c&);
+  /** not copyable : copy operator is only declared, never defined */
+  LanguageDelta_c& operator=(const LanguageDelta_c&);
+};
+
+
+} // __IsoAgLib
+
+#endif
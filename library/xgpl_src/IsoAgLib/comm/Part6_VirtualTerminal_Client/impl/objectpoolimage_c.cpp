@@ -0,0 +1,183 @@
+/*
+  objectpoolimage_c.cpp: contiguous serialized image of an object
+    pool part, streamed for uploads instead of the single objects
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "objectpoolimage_c.h"
+#include "uploadpoolstate_c.h"
+#include "vtobject_c.h"
+
+#include <IsoAgLib/util/iassert.h>
+
+#include <cstring>
+
+
+namespace __IsoAgLib {
+
+
+// the objects stream their constant sized part without checking the
+// remaining space, so keep some room behind the calculated size.
+static const uint32_t scui32_imageSlack = 256;
+
+
+ObjectPoolImage_c::ObjectPoolImage_c()
+  : ms_properties()
+  , mpui8_data( NULL )
+  , mui32_size( 0 )
+  , mpui32_refCount( NULL )
+{
+  CNAMESPACE::memset( &ms_properties, 0, sizeof( ms_properties ) );
+}
+
+
+bool
+ObjectPoolImage_c::build(
+  const PoolImageProperties_s& arc_properties,
+  IsoAgLib::iVtObject_c* const HUGE_MEM* apc_objects, uint16_t aui16_numObjects,
+  uint32_t aui32_expectedSize, const UploadPoolState_c& arc_uploadPoolState )
+{
+  clear();
+
+  uint8_t* pui8_image = new uint8_t[ aui32_expectedSize + scui32_imageSlack ];
+  pui8_image[ 0 ] = 0x11; // Upload Object Pool!
+  uint32_t ui32_filled = 1;
+
+  for( uint16_t curObject = 0; ( curObject < aui16_numObjects ) && ( ui32_filled <= aui32_expectedSize ); ++curObject )
+  {
+    vtObject_c &object = *static_cast<vtObject_c*>( apc_objects[ curObject ] );
+    if( arc_uploadPoolState.dontUpload( object ) )
+      continue;
+
+    objRange_t offset = 0;
+    while( ui32_filled <= aui32_expectedSize )
+    {
+      const uint32_t remaining = aui32_expectedSize + scui32_imageSlack - ui32_filled;
+      const int16_t bytes = object.stream( pui8_image + ui32_filled, uint16_t( ( remaining > 0x7FFF ) ? 0x7FFF : remaining ), offset );
+      if( bytes <= 0 )
+        break;
+      ui32_filled += uint32_t( bytes );
+      offset += bytes;
+    }
+  }
+
+  if( ui32_filled != aui32_expectedSize )
+  { // fitTerminal and stream disagree - don't use an image for this part
+    isoaglib_assert( !"Object pool image size mismatch" );
+    delete [] pui8_image;
+    return false;
+  }
+
+  ms_properties = arc_properties;
+  mpui8_data = pui8_image;
+  mui32_size = ui32_filled;
+  mpui32_refCount = new uint32_t( 1 );
+  return true;
+}
+
+
+void
+ObjectPoolImage_c::assign( const PoolImageProperties_s& arc_properties, const uint8_t* apui8_data, uint32_t aui32_size )
+{
+  clear();
+
+  if( ( apui8_data == NULL ) || ( aui32_size == 0 ) || ( apui8_data[ 0 ] != 0x11 ) )
+    return;
+
+  ms_properties = arc_properties;
+  mpui8_data = apui8_data;
+  mui32_size = aui32_size;
+}
+
+
+void
+ObjectPoolImage_c::share( const ObjectPoolImage_c& arc_source )
+{
+  isoaglib_assert( arc_source.shareable() );
+  if( arc_source.mpui8_data == mpui8_data )
+    return;
+
+  clear();
+
+  ms_properties = arc_source.ms_properties;
+  mpui8_data = arc_source.mpui8_data;
+  mui32_size = arc_source.mui32_size;
+  mpui32_refCount = arc_source.mpui32_refCount;
+  ++*mpui32_refCount;
+}
+
+
+void
+ObjectPoolImage_c::clear()
+{
+  if( ( mpui32_refCount != NULL ) && ( --*mpui32_refCount == 0 ) )
+  {
+    delete [] mpui8_data;
+    delete mpui32_refCount;
+  }
+
+  mpui8_data = NULL;
+  mui32_size = 0;
+  mpui32_refCount = NULL;
+}
+
+
+
+uint32_t
+ObjectPoolImage_c::hash( const uint8_t* apui8_data, uint32_t aui32_size, uint32_t aui32_seed )
+{
+  uint32_t result = aui32_seed;
+  for( uint32_t i = 0; i < aui32_size; ++i )
+  {
+    result ^= apui8_data[ i ];
+    result *= 0x01000193UL;
+  }
+  return result;
+}
+
+
+uint32_t
+ObjectPoolImage_c::hashObjects(
+  IsoAgLib::iVtObject_c* const HUGE_MEM* apc_objects, uint16_t aui16_numObjects,
+  const UploadPoolState_c& arc_uploadPoolState, uint32_t aui32_seed )
+{
+  // same buffer size as in ObjectPoolStreamer_c, the objects rely on having that much room.
+  uint8_t buffer[ ISO_VT_UPLOAD_BUFFER_SIZE ];
+
+  uint32_t result = aui32_seed;
+  for( uint16_t curObject = 0; curObject < aui16_numObjects; ++curObject )
+  {
+    vtObject_c &object = *static_cast<vtObject_c*>( apc_objects[ curObject ] );
+    // fit the object first, just like for a real upload
+    if( arc_uploadPoolState.fitTerminalWrapper( object ) == 0 )
+      continue;
+
+    objRange_t offset = 0;
+    for( ;; )
+    {
+      const int16_t bytes = object.stream( buffer, ISO_VT_UPLOAD_BUFFER_SIZE, offset );
+      if( bytes <= 0 )
+        break;
+      result = hash( buffer, uint32_t( bytes ), result );
+      offset += bytes;
+    }
+  }
+  return result;
+}
+
+
+} // __IsoAgLib
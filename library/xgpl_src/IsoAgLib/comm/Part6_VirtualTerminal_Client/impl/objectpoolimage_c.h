@@ -0,0 +1,130 @@
+/*
+  objectpoolimage_c.h: contiguous serialized image of an object
+    pool part, streamed for uploads instead of the single objects
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef OBJECTPOOLIMAGE_C_H
+#define OBJECTPOOLIMAGE_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+
+
+namespace IsoAgLib {
+  class iVtObject_c;
+}
+
+
+namespace __IsoAgLib {
+
+
+class UploadPoolState_c;
+
+
+/** Everything the serialized object pool depends on.
+    Used as key to decide if an ObjectPoolImage_c can be reused.
+  */
+struct PoolImageProperties_s
+{
+  uint16_t dimension;   // mask dimension the pool gets scaled to
+  uint16_t skWidth;     // soft key width the pool gets scaled to
+  uint16_t skHeight;    // soft key height the pool gets scaled to
+  uint16_t fontSizes;   // VT's supported small font sizes
+  uint16_t hwOffsetX;   // offset added to data / alarm mask objects
+  uint16_t hwOffsetY;
+  uint16_t skOffsetX;   // offset added to soft key objects
+  uint16_t skOffsetY;
+  uint8_t  colourDepth; // 0, 1 or 2 (2, 16 or 256 colors)
+  uint8_t  skVirtual;   // VT's number of virtual soft keys
+  uint8_t  version;     // object pool version uploaded (no Aux2 objects with version 2)
+  int8_t   language;    // -1 for the language independent part, else the language index
+
+  bool operator==( const PoolImageProperties_s& r ) const
+  {
+    return ( dimension == r.dimension ) && ( skWidth == r.skWidth ) && ( skHeight == r.skHeight )
+        && ( fontSizes == r.fontSizes ) && ( hwOffsetX == r.hwOffsetX ) && ( hwOffsetY == r.hwOffsetY )
+        && ( skOffsetX == r.skOffsetX ) && ( skOffsetY == r.skOffsetY )
+        && ( colourDepth == r.colourDepth ) && ( skVirtual == r.skVirtual )
+        && ( version == r.version ) && ( language == r.language );
+  }
+};
+
+
+/** Upload image of one object pool part: the 0x11 command byte
+    followed by all objects serialized for one PoolImageProperties_s.
+    The image is either built here or provided by the application,
+    in which case it is only referenced. Built images can be shared
+    by several connections, the buffer is freed with the last one.
+  */
+class ObjectPoolImage_c
+{
+public:
+  ObjectPoolImage_c();
+  ~ObjectPoolImage_c() { clear(); }
+
+  /** serialize the given objects (those not omitted from upload by arc_uploadPoolState)
+      @param aui32_expectedSize size calculated via fitTerminal including the 0x11 byte
+      @return false if the serialized size didn't match, the image is invalid then */
+  bool build( const PoolImageProperties_s& arc_properties,
+              IsoAgLib::iVtObject_c* const HUGE_MEM* apc_objects, uint16_t aui16_numObjects,
+              uint32_t aui32_expectedSize, const UploadPoolState_c& arc_uploadPoolState );
+
+  /** reference an image provided by the application (not copied, not freed) */
+  void assign( const PoolImageProperties_s& arc_properties, const uint8_t* apui8_data, uint32_t aui32_size );
+
+  /** share the built image of another connection (reference counted) */
+  void share( const ObjectPoolImage_c& arc_source );
+
+  void clear();
+
+  /** FNV-1a hash over the given bytes, pass the previous result as seed to continue */
+  static uint32_t hash( const uint8_t* apui8_data, uint32_t aui32_size, uint32_t aui32_seed = scui32_hashSeed );
+
+  /** hash the objects (those not omitted from upload) as they would be serialized,
+      without keeping the serialized data */
+  static uint32_t hashObjects( IsoAgLib::iVtObject_c* const HUGE_MEM* apc_objects, uint16_t aui16_numObjects,
+                               const UploadPoolState_c& arc_uploadPoolState, uint32_t aui32_seed = scui32_hashSeed );
+
+  static const uint32_t scui32_hashSeed = 0x811C9DC5UL;
+
+  bool valid() const { return mpui8_data != NULL; }
+  bool matches( const PoolImageProperties_s& arc_properties ) const { return valid() && ( ms_properties == arc_properties ); }
+
+  const PoolImageProperties_s& properties() const { return ms_properties; }
+  const uint8_t* data() const { return mpui8_data; }
+  uint32_t size() const { return mui32_size; }
+
+  /// @return true for built images, which may be shared, false for application provided ones
+  bool shareable() const { return mpui32_refCount != NULL; }
+
+private:
+  PoolImageProperties_s ms_properties;
+  const uint8_t* mpui8_data;
+  uint32_t mui32_size;
+  uint32_t* mpui32_refCount; // NULL if the data is provided by the application
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  ObjectPoolImage_c(const ObjectPoolImage_c&);
+  /** not copyable : copy operator is only declared, never defined */
+  ObjectPoolImage_c& operator=(const ObjectPoolImage_c&);
+};
+
+
+} // __IsoAgLib
+
+#endif
@@ -19,6 +19,7 @@
   file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
 */
 #include "objectpoolstreamer_c.h"
+#include "objectpoolimage_c.h"
 
 #include <IsoAgLib/comm/Part3_DataLink/impl/multisendpkg_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtclientconnection_c.h>
@@ -31,6 +32,13 @@ namespace __IsoAgLib {
 void
 ObjectPoolStreamer_c::setDataNextStreamPart (MultiSendPkg_c* mspData, uint8_t bytes)
 {
+  if (mpc_image)
+  { // everything's serialized already, no need to buffer anything
+    mspData->setDataPart (mpc_image->data(), int32_t (mui32_objectStreamPosition), bytes);
+    mui32_objectStreamPosition += bytes;
+    return;
+  }
+
   while ((m_uploadBufferFilled-m_uploadBufferPosition) < bytes)
   {
     // copy down the rest of the buffer (we have no ring buffer here!)
@@ -74,6 +82,9 @@ ObjectPoolStreamer_c::resetDataNextStreamPart()
 {
   mpc_iterObjects = mpc_objectsToUpload;
   mui32_objectStreamPosition = 0;
+  if (mpc_image)
+    return;
+
   m_uploadBufferPosition = 0;
   m_uploadBufferFilled = 1;
   marr_uploadBuffer [0] = 0x11; // Upload Object Pool!
@@ -85,6 +96,9 @@ ObjectPoolStreamer_c::saveDataNextStreamPart()
 {
   mpc_iterObjectsStored = mpc_iterObjects;
   mui32_objectStreamPositionStored = mui32_objectStreamPosition;
+  if (mpc_image)
+    return;
+
   m_uploadBufferPositionStored = m_uploadBufferPosition;
   m_uploadBufferFilledStored = m_uploadBufferFilled;
   for (int i=0; i<ISO_VT_UPLOAD_BUFFER_SIZE; i++)
@@ -97,6 +111,9 @@ ObjectPoolStreamer_c::restoreDataNextStreamPart()
 {
   mpc_iterObjects = mpc_iterObjectsStored;
   mui32_objectStreamPosition = mui32_objectStreamPositionStored;
+  if (mpc_image)
+    return;
+
   m_uploadBufferPosition = m_uploadBufferPositionStored;
   m_uploadBufferFilled = m_uploadBufferFilledStored;
   for (int i=0; i<ISO_VT_UPLOAD_BUFFER_SIZE; i++)
@@ -33,6 +33,7 @@ namespace __IsoAgLib {
 
 
 class UploadPoolState_c;
+class ObjectPoolImage_c;
 
 
 /** helper class for low level streaming.
@@ -44,7 +45,8 @@ class ObjectPoolStreamer_c : public IsoAgLib::iMultiSendStreamer_c
 {
 public:
   ObjectPoolStreamer_c( UploadPoolState_c& uploadPoolState )
-    : m_uploadPoolState( uploadPoolState )
+    : mpc_image( NULL )
+    , m_uploadPoolState( uploadPoolState )
   {}
 
   virtual ~ObjectPoolStreamer_c() {}
@@ -58,11 +60,17 @@ public:
 
   void setStreamSize(uint32_t aui32_size) { mui32_size = aui32_size; }
 
+  /** stream directly out of the given image instead of serializing
+      the objects (mpc_objectsToUpload is not used then).
+      @param apc_image NULL to serialize the objects again */
+  void setImage(const ObjectPoolImage_c* apc_image) { mpc_image = apc_image; }
+
 public:
   uint32_t mui32_objectStreamPosition;
   uint32_t mui32_objectStreamPositionStored;
   uint32_t mui32_size;
   IsoAgLib::iVtObject_c* const HUGE_MEM* mpc_objectsToUpload; // @todo maybe this variable can be optimized away and mpc_iterObjects be directly used...
+  const ObjectPoolImage_c* mpc_image;
 
   /** pointers needed by MultiSendStreamer */
   IsoAgLib::iVtObject_c* const HUGE_MEM* mpc_iterObjects;
@@ -0,0 +1,106 @@
+/*
+  picturegraphicrle_c.cpp: run length encoding of picture graphic raw
+    data while streaming it to the VT
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "picturegraphicrle_c.h"
+#include <IsoAgLib/util/iassert.h>
+
+
+namespace __IsoAgLib {
+
+PictureGraphicRle_c::PictureGraphicRle_c()
+  : mpc_source( NULL )
+  , mui32_sourceSize( 0 )
+  , mui32_encodedSize( 0 )
+  , mui32_runSource( 0 )
+  , mui32_runOffset( 0 )
+  , mui8_runLength( 0 )
+{
+}
+
+
+uint32_t
+PictureGraphicRle_c::encodedSize( const HUGE_MEM uint8_t* apc_source, uint32_t aui32_size )
+{
+  if( ( apc_source == mpc_source ) && ( aui32_size == mui32_sourceSize ) )
+    return mui32_encodedSize;
+
+  mpc_source = apc_source;
+  mui32_sourceSize = aui32_size;
+
+  rewind();
+  while( mui8_runLength > 0 )
+    nextRun();
+  mui32_encodedSize = mui32_runOffset;
+
+  rewind();
+  return mui32_encodedSize;
+}
+
+
+uint8_t
+PictureGraphicRle_c::encodedByte( uint32_t aui32_offset )
+{
+  isoaglib_assert( ( mpc_source != NULL ) && ( aui32_offset < mui32_encodedSize ) );
+
+  if( aui32_offset < mui32_runOffset )
+    rewind();
+
+  while( aui32_offset >= ( mui32_runOffset + 2 ) )
+    nextRun();
+
+  return ( aui32_offset == mui32_runOffset )
+    ? mui8_runLength
+    : mpc_source[ mui32_runSource ];
+}
+
+
+void
+PictureGraphicRle_c::rewind()
+{
+  mui32_runSource = 0;
+  mui32_runOffset = 0;
+  mui8_runLength = 0;
+  nextRun();
+}
+
+
+void
+PictureGraphicRle_c::nextRun()
+{
+  if( mui8_runLength > 0 )
+  {
+    mui32_runSource += mui8_runLength;
+    mui32_runOffset += 2;
+  }
+
+  mui8_runLength = 0;
+  if( mui32_runSource >= mui32_sourceSize )
+    return;
+
+  const uint8_t value = mpc_source[ mui32_runSource ];
+  do
+    ++mui8_runLength;
+  while( ( mui8_runLength < 0xFF )
+      && ( ( mui32_runSource + mui8_runLength ) < mui32_sourceSize )
+      && ( mpc_source[ mui32_runSource + mui8_runLength ] == value ) );
+}
+
+
+} // __IsoAgLib
@@ -0,0 +1,67 @@
+/*
+  picturegraphicrle_c.h: run length encoding of picture graphic raw
+    data while streaming it to the VT
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef PICTUREGRAPHICRLE_C_H
+#define PICTUREGRAPHICRLE_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+
+
+namespace __IsoAgLib {
+
+/** Encoder for the RLE1/4/8 format of the Picture Graphic object:
+    pairs of (count 1..255, raw byte). The raw byte holds 8, 2 or 1
+    pixel(s), so the encoding is the same for all colour depths.
+    Nothing is buffered: the encoded data is produced byte by byte
+    at the requested offset, which is O(1) when streaming forward.
+    Going back (e.g. a restored stream position) rescans from the start.
+  */
+class PictureGraphicRle_c
+{
+public:
+  PictureGraphicRle_c();
+
+  /** @return size of the encoded data. Cached for the same source,
+              call invalidate() when changing the data in place. */
+  uint32_t encodedSize( const HUGE_MEM uint8_t* apc_source, uint32_t aui32_size );
+
+  /** @return byte of the encoded data of the last encodedSize() source */
+  uint8_t encodedByte( uint32_t aui32_offset );
+
+  void invalidate() { mpc_source = NULL; }
+
+private:
+  void rewind();
+  void nextRun();
+
+  const HUGE_MEM uint8_t* mpc_source;
+  uint32_t mui32_sourceSize;
+  uint32_t mui32_encodedSize;
+
+  // current run: its position in the source and in the encoded data
+  uint32_t mui32_runSource;
+  uint32_t mui32_runOffset;
+  uint8_t mui8_runLength;
+};
+
+
+} // __IsoAgLib
+
+#endif
@@ -0,0 +1,325 @@
+/*
+  senduploadqueue_c.cpp: queue of the pending VT commands of one
+    send priority with an index for command replacement
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "senduploadqueue_c.h"
+
+
+namespace __IsoAgLib {
+
+// power of 2, so the ring position is just masked
+static const unsigned scui_initialSlots = 16;
+
+
+SendUploadQueue_c::SendUploadQueue_c()
+  : m_slots()
+  , m_index()
+  , mui_head( 0 )
+  , mui_used( 0 )
+  , mui_size( 0 )
+{
+}
+
+
+unsigned
+SendUploadQueue_c::hash( Key_t a_key )
+{
+  uint32_t h = uint32_t( a_key ) ^ ( uint32_t( a_key >> 32 ) * 0x9E3779B1UL );
+  h ^= h >> 15;
+  h *= 0x85EBCA6BUL;
+  h ^= h >> 13;
+  return unsigned( h );
+}
+
+
+int
+SendUploadQueue_c::findIndex( Key_t a_key ) const
+{
+  if( m_index.empty() )
+    return sci_noSlot;
+
+  const unsigned mask = unsigned( m_index.size() ) - 1;
+  for( unsigned i = hash( a_key ) & mask; m_index[ i ].key != 0; i = ( i + 1 ) & mask )
+  {
+    if( m_index[ i ].key == a_key )
+      return int( i );
+  }
+  return sci_noSlot;
+}
+
+
+void
+SendUploadQueue_c::link( int ai_slot )
+{
+  Slot_s& slot = m_slots[ ai_slot ];
+  slot.nextSameKey = sci_noSlot;
+  if( slot.key == 0 )
+    return;
+
+  const int index = findIndex( slot.key );
+  if( index != sci_noSlot )
+  {
+    m_slots[ m_index[ index ].last ].nextSameKey = ai_slot;
+    m_index[ index ].last = ai_slot;
+    return;
+  }
+
+  // the index has twice the slots of the ring, so there's always a free entry
+  const unsigned mask = unsigned( m_index.size() ) - 1;
+  unsigned i = hash( slot.key ) & mask;
+  while( m_index[ i ].key != 0 )
+    i = ( i + 1 ) & mask;
+
+  m_index[ i ].key = slot.key;
+  m_index[ i ].first = ai_slot;
+  m_index[ i ].last = ai_slot;
+}
+
+
+void
+SendUploadQueue_c::eraseIndex( int ai_index )
+{
+  // backward shift deletion keeps the probe sequences intact without tombstones
+  const unsigned mask = unsigned( m_index.size() ) - 1;
+  unsigned hole = unsigned( ai_index );
+  unsigned i = hole;
+  for( ;; )
+  {
+    m_index[ hole ].key = 0;
+    for( ;; )
+    {
+      i = ( i + 1 ) & mask;
+      if( m_index[ i ].key == 0 )
+        return;
+
+      const unsigned home = hash( m_index[ i ].key ) & mask;
+      const bool stays = ( hole <= i )
+        ? ( ( hole < home ) && ( home <= i ) )
+        : ( ( hole < home ) || ( home <= i ) );
+      if( !stays )
+        break;
+    }
+    m_index[ hole ] = m_index[ i ];
+    hole = i;
+  }
+}
+
+
+void
+SendUploadQueue_c::release( Slot_s& ar_slot )
+{
+  ar_slot.upload = SendUpload_c(); // deletes an owned streamer
+  ar_slot.key = 0;
+  ar_slot.nextSameKey = sci_noSlot;
+  ar_slot.removed = false;
+}
+
+
+void
+SendUploadQueue_c::skipRemovedAtFront()
+{
+  const unsigned mask = unsigned( m_slots.size() ) - 1;
+  while( ( mui_used > 0 ) && m_slots[ mui_head ].removed )
+  {
+    release( m_slots[ mui_head ] );
+    mui_head = ( mui_head + 1 ) & mask;
+    --mui_used;
+  }
+}
+
+
+void
+SendUploadQueue_c::grow()
+{
+  unsigned newSize = m_slots.empty() ? scui_initialSlots : unsigned( m_slots.size() );
+  // only compact the ring if that makes enough room, else double it
+  if( mui_size + 1 > newSize / 2 )
+    newSize *= 2;
+
+  STL_NAMESPACE::vector<Slot_s> newSlots( newSize );
+
+  const unsigned mask = unsigned( m_slots.size() ) - 1;
+  unsigned target = 0;
+  for( unsigned i = 0; i < mui_used; ++i )
+  {
+    Slot_s& from = m_slots[ ( mui_head + i ) & mask ];
+    if( from.removed )
+      continue;
+
+    // move without copying: the buffer keeps its address and the streamer its single owner
+    Slot_s& to = newSlots[ target++ ];
+    to.upload.vec_uploadBuffer.swap( from.upload.vec_uploadBuffer );
+    to.upload.mc_streamer = from.upload.mc_streamer;
+    to.upload.ppc_vtObjects = from.upload.ppc_vtObjects;
+    to.upload.ui16_numObjects = from.upload.ui16_numObjects;
+    to.key = from.key;
+    from.upload.unsetStreamer();
+  }
+  isoaglib_assert( target == mui_size );
+
+  m_slots.swap( newSlots );
+  mui_head = 0;
+  mui_used = mui_size;
+
+  IndexEntry_s free = { 0, sci_noSlot, sci_noSlot };
+  m_index.assign( 2 * newSize, free );
+  for( unsigned i = 0; i < mui_used; ++i )
+    link( int( i ) );
+}
+
+
+void
+SendUploadQueue_c::push_back( const SendUpload_c& ar_sendUpload, Key_t a_key )
+{
+  if( mui_used == m_slots.size() )
+    grow();
+
+  const int pos = int( ( mui_head + mui_used ) & ( m_slots.size() - 1 ) );
+  Slot_s& slot = m_slots[ pos ];
+  slot.upload = ar_sendUpload;
+  slot.key = a_key;
+  slot.removed = false;
+  link( pos );
+
+  ++mui_used;
+  ++mui_size;
+}
+
+
+void
+SendUploadQueue_c::pop_front()
+{
+  isoaglib_assert( !empty() );
+
+  Slot_s& slot = m_slots[ mui_head ];
+  if( slot.key != 0 )
+  { // the front is always the first one of its key
+    const int index = findIndex( slot.key );
+    isoaglib_assert( ( index != sci_noSlot ) && ( m_index[ index ].first == int( mui_head ) ) );
+    m_index[ index ].first = slot.nextSameKey;
+    if( m_index[ index ].first == sci_noSlot )
+      eraseIndex( index );
+  }
+
+  release( slot );
+  mui_head = ( mui_head + 1 ) & ( unsigned( m_slots.size() ) - 1 );
+  --mui_used;
+  --mui_size;
+
+  skipRemovedAtFront();
+}
+
+
+void
+SendUploadQueue_c::clear()
+{
+  const unsigned mask = unsigned( m_slots.size() ) - 1;
+  for( unsigned i = 0; i < mui_used; ++i )
+    release( m_slots[ ( mui_head + i ) & mask ] );
+
+  for( unsigned i = 0; i < m_index.size(); ++i )
+    m_index[ i ].key = 0;
+
+  mui_head = 0;
+  mui_used = 0;
+  mui_size = 0;
+}
+
+
+void
+SendUploadQueue_c::clearAllButFront()
+{
+  if( mui_used <= 1 )
+    return;
+
+  const unsigned mask = unsigned( m_slots.size() ) - 1;
+  for( unsigned i = 1; i < mui_used; ++i )
+    release( m_slots[ ( mui_head + i ) & mask ] );
+
+  for( unsigned i = 0; i < m_index.size(); ++i )
+    m_index[ i ].key = 0;
+
+  mui_used = 1;
+  mui_size = 1;
+  link( int( mui_head ) );
+}
+
+
+bool
+SendUploadQueue_c::replace( Key_t a_key, const SendUpload_c* apc_sendUpload, bool ab_skipFront )
+{
+  isoaglib_assert( a_key != 0 );
+
+  const int index = findIndex( a_key );
+  if( index == sci_noSlot )
+    return false;
+
+  IndexEntry_s& entry = m_index[ index ];
+  bool replaced = false;
+  int prev = sci_noSlot;
+  int pos = entry.first;
+  while( pos != sci_noSlot )
+  {
+    Slot_s& slot = m_slots[ pos ];
+    const int next = slot.nextSameKey;
+
+    if( ab_skipFront && ( pos == int( mui_head ) ) )
+    {
+      prev = pos;
+    }
+    else if( ( apc_sendUpload != NULL ) && !replaced )
+    {
+      slot.upload = *apc_sendUpload; // overloaded "operator=", takes over the streamer
+      replaced = true;
+      prev = pos;
+    }
+    else
+    { // further instances of this command: remove them
+      if( prev == sci_noSlot )
+        entry.first = next;
+      else
+        m_slots[ prev ].nextSameKey = next;
+      if( entry.last == pos )
+        entry.last = prev;
+
+      slot.upload = SendUpload_c();
+      slot.removed = true;
+      --mui_size;
+    }
+    pos = next;
+  }
+
+  if( entry.first == sci_noSlot )
+    eraseIndex( index );
+
+  skipRemovedAtFront();
+  return replaced;
+}
+
+
+const SendUpload_c*
+SendUploadQueue_c::slot( unsigned aui_pos ) const
+{
+  isoaglib_assert( aui_pos < mui_used );
+  const Slot_s& slot = m_slots[ ( mui_head + aui_pos ) & ( unsigned( m_slots.size() ) - 1 ) ];
+  return slot.removed ? NULL : &slot.upload;
+}
+
+
+} // __IsoAgLib
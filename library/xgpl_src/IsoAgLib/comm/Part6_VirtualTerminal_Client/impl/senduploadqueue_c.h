@@ -0,0 +1,117 @@
+/*
+  senduploadqueue_c.h: queue of the pending VT commands of one
+    send priority with an index for command replacement
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef SENDUPLOADQUEUE_H
+#define SENDUPLOADQUEUE_H
+
+#include "sendupload_c.h"
+#include <IsoAgLib/util/iassert.h>
+#include <vector>
+
+
+namespace __IsoAgLib {
+
+/** FIFO of SendUpload_c in a ring of slots which only grows, never shrinks.
+    Every queued command carries a key (0: never replaced); all commands
+    with the same key are chained and found via a hash index, so that
+    replacing a queued command by a newer one with the same key is O(1).
+    Removed commands in the middle of the ring are only marked and
+    skipped when they reach the front.
+    The front command keeps its upload buffer at the same address
+    while the ring grows, as it may be sent by MultiSend_c at that time.
+  */
+class SendUploadQueue_c
+{
+public:
+  typedef uint64_t Key_t;
+
+  SendUploadQueue_c();
+
+  bool empty() const { return mui_size == 0; }
+  unsigned size() const { return mui_size; }
+
+  SendUpload_c& front() { isoaglib_assert( !empty() ); return m_slots[ mui_head ].upload; }
+  Key_t frontKey() const { isoaglib_assert( !empty() ); return m_slots[ mui_head ].key; }
+
+  void push_back( const SendUpload_c& ar_sendUpload, Key_t a_key );
+  void pop_front();
+  void clear();
+
+  /// remove all commands except the front one (which may be sent currently)
+  void clearAllButFront();
+
+  /// @return true if a command with the key is queued (including the front one)
+  bool contains( Key_t a_key ) const { return findIndex( a_key ) != sci_noSlot; }
+
+  /** replace the first command with the same key by ar_sendUpload and remove all further ones.
+      @param apc_sendUpload new command, NULL to only remove all commands with the key
+      @param ab_skipFront leave the front command untouched (as it is being sent)
+      @return true if a command was replaced */
+  bool replace( Key_t a_key, const SendUpload_c* apc_sendUpload, bool ab_skipFront );
+
+  /// number of slots from the front on, including removed ones (for debug output)
+  unsigned slots() const { return mui_used; }
+  /// @return command in slot, NULL if it was removed
+  const SendUpload_c* slot( unsigned aui_pos ) const;
+
+private:
+  struct Slot_s
+  {
+    Slot_s() : upload(), key( 0 ), nextSameKey( sci_noSlot ), removed( false ) {}
+
+    SendUpload_c upload;
+    Key_t key;
+    int nextSameKey;
+    bool removed;
+  };
+
+  struct IndexEntry_s
+  {
+    Key_t key; // 0: free
+    int first;
+    int last;
+  };
+
+  static const int sci_noSlot = -1;
+
+  static unsigned hash( Key_t a_key );
+  int findIndex( Key_t a_key ) const;
+  void link( int ai_slot );
+  void eraseIndex( int ai_index );
+  void release( Slot_s& ar_slot );
+  void skipRemovedAtFront();
+  void grow();
+
+  STL_NAMESPACE::vector<Slot_s> m_slots; // never resized, only swapped, so no SendUpload_c gets copied
+  STL_NAMESPACE::vector<IndexEntry_s> m_index;
+  unsigned mui_head;
+  unsigned mui_used;
+  unsigned mui_size;
+
+private:
+  /** not copyable : copy constructor/operator only declared, not defined */
+  SendUploadQueue_c( const SendUploadQueue_c& );
+  SendUploadQueue_c& operator=( const SendUploadQueue_c& );
+};
+
+
+} // __IsoAgLib
+
+#endif
@@ -20,6 +20,7 @@
 #include "uploadpoolstate_c.h"
 #include <IsoAgLib/comm/Part3_DataLink/impl/stream_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtclientconnection_c.h>
+#include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtclient_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtserverinstance_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/ivtclientobjectpool_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/ivtobjectworkingset_c.h>
@@ -41,6 +42,14 @@ namespace __IsoAgLib
 // Some old GS2 will force us to run into a time-out, so we need to continue in case of a time-out!
 static const int32_t s_timeOutGetVersions = 6000;
 
+// characters used for the content hash part of the version label (5 bits each)
+static const char s_hashLabelChars[] = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+
+static bool isHashLabelChar( char c )
+{
+  return ( ( c >= '0' ) && ( c <= '9' ) ) || ( ( c >= 'A' ) && ( c <= 'V' ) );
+}
+
 
 UploadPoolState_c::UploadPoolState_c(
   VtClientConnection_c &connection,
@@ -49,10 +58,18 @@ UploadPoolState_c::UploadPoolState_c(
   bool wsMaster )
   : m_connection( connection )
   , m_pool( pool )
-  , mb_usingVersionLabel( _versionLabel != NULL )
+  , mb_usingVersionLabel( ( _versionLabel != NULL ) || pool.useContentHashVersionLabel() )
   //marrp7c_versionLabel[ 7 ] body!
+  , mb_contentHashVersionLabel( pool.useContentHashVersionLabel() )
+  , mui8_versionLabelPrefixLength( 0 )
   , m_uploadingVersion( 0 )
   , mc_iVtObjectStreamer( *this )
+  , mc_imageFix()
+  , mc_imageLang()
+  , mc_languageDelta()
+  , mc_imageLangDelta()
+  , mb_languageDeltaUpload( false )
+  , mb_poolImageOutdated( false )
   , men_uploadPoolState( UploadPoolEndSuccess ) // default for Slaves!
   , men_uploadPoolType( UploadPoolTypeCompleteInitially ) // dummy
   , mi32_uploadTimestamp( 0 )
@@ -63,9 +80,12 @@ UploadPoolState_c::UploadPoolState_c(
   , mppc_uploadPhaseUserObjects( NULL )
   , mi8_objectPoolUploadingLanguage( 0 )
   , mi8_objectPoolUploadedLanguage( 0 )
+  , mui8_objectPoolUploadedRealLanguage( 0 )
   , mui16_objectPoolUploadingLanguageCode( 0x0000 )
   , mui16_objectPoolUploadedLanguageCode( 0x0000 )
   , mi8_vtLanguage( -2 )
+  //marr_obsoleteVersions[..] // not needed until found
+  , mui8_numObsoleteVersions( 0 )
 {
   if( _versionLabel )
   {
@@ -78,6 +98,16 @@ UploadPoolState_c::UploadPoolState_c(
     isoaglib_assert( m_langRejectedUseDefaultAsFallback.bits() >= m_pool.getNumLang() );
   }
 
+  if( mb_contentHashVersionLabel )
+  { // the given label (if any) is the prefix, the rest gets filled in once the VT is known
+    if( _versionLabel )
+      mui8_versionLabelPrefixLength = uint8_t( CNAMESPACE::strlen( _versionLabel ) );
+    else
+      for( unsigned int i=0; i<7; ++i ) marrp7c_versionLabel[ i ] = ' '; // ASCII: Space
+
+    isoaglib_assert( mui8_versionLabelPrefixLength + 3 <= ( m_pool.multiLanguage() ? 5 : 7 ) );
+  }
+
   if( wsMaster )
   {
     ms_uploadPhasesAutomatic[0] = UploadPhase_s( &mc_iVtObjectStreamer, 0 );
@@ -152,6 +182,10 @@ UploadPoolState_c::initPool()
 {
   getPool().initAllObjectsOnce( m_connection.getMultitonInst() );
 
+#ifdef CONFIG_VT_CLIENT_RAM_STRUCT_ARENA_PREFAULT
+  getPool().getRamStructArena().prefault();
+#endif
+
   // now let all clients know which client they belong to
   const uint8_t clientId = m_connection.getClientId();
   if( clientId > 0 ) // the iVtObjects are initialised with 0 as default index
@@ -177,10 +211,12 @@ UploadPoolState_c::initPool()
 
 // 1.) Search for version-label
 // 2.) Mark all rejected languages
+// 3.) Select a version of another language if there's none for the current one (language delta update only)
 bool
 UploadPoolState_c::searchVersionsAndMarkRejected( Stream_c& stream, uint8_t numVersions )
 {
   bool versionFound = false;
+  IsoaglibArrayBitset<64> storedLanguages;
 
   // don't break on this search, because still all need to be marked!
   for( uint8_t counter = 0; counter < numVersions; ++counter )
@@ -189,6 +225,13 @@ UploadPoolState_c::searchVersionsAndMarkRejected( Stream_c& stream, uint8_t numV
     for( uint16_t i = 0; i < 7; ++i )
       c_nextversion[i] = stream.get();
 
+    if( isObsoleteVersion( c_nextversion )
+     && ( mui8_numObsoleteVersions < CONFIG_VT_CLIENT_MAX_OBSOLETE_VERSIONS ) )
+    {
+      CNAMESPACE::memcpy( marr_obsoleteVersions[ mui8_numObsoleteVersions ], c_nextversion, 7 );
+      ++mui8_numObsoleteVersions;
+    }
+
     // check if this is a rejected language
     if( m_pool.multiLanguage() )
     {
@@ -215,7 +258,10 @@ UploadPoolState_c::searchVersionsAndMarkRejected( Stream_c& stream, uint8_t numV
             c_nextversion[ 6 ] );
           
           if( langIndex >= 0 )
+          {
+            storedLanguages.setBit( unsigned( langIndex ) );
             versionFound = true; // Pool-name (without language extension) matches!
+          }
           // else: Some version with a language not used in this pool (maybe some old pool that had this version)
         }
       }
@@ -224,9 +270,22 @@ UploadPoolState_c::searchVersionsAndMarkRejected( Stream_c& stream, uint8_t numV
     else // no multilanguage
     {
       if( 0 == CNAMESPACE::memcmp( c_nextversion, marrp7c_versionLabel, 7 ) )
+        versionFound = true; // don't break, obsolete versions may follow
+    }
+  }
+
+  if( versionFound && m_pool.multiLanguage() && m_pool.useLanguageDeltaUpdate() )
+  {
+    const unsigned labelLanguage = calcRealUploadingLanguage( false );
+    if( !storedLanguages.isBitSet( labelLanguage ) && !m_langRejectedUseDefaultAsFallback.isBitSet( labelLanguage ) )
+    { // load the pool in another language, the language update to the VT's language then only uploads the differences
+      for( int8_t i = 0; i < int8_t( m_pool.getNumLang() ); ++i )
       {
-        versionFound = true; 
-        break;
+        if( storedLanguages.isBitSet( unsigned( i ) ) && !m_langRejectedUseDefaultAsFallback.isBitSet( unsigned( i ) ) )
+        {
+          setObjectPoolUploadingLanguage( i );
+          break;
+        }
       }
     }
   }
@@ -235,6 +294,76 @@ UploadPoolState_c::searchVersionsAndMarkRejected( Stream_c& stream, uint8_t numV
 }
 
 
+// @return true if the label has been generated from an older content of the pool (same prefix, different hash)
+bool
+UploadPoolState_c::isObsoleteVersion( const char* versionLabel ) const
+{
+  // without a prefix any label of hash characters would look like ours
+  if( !mb_contentHashVersionLabel || ( mui8_versionLabelPrefixLength == 0 ) )
+    return false;
+
+  if( 0 != CNAMESPACE::memcmp( versionLabel, marrp7c_versionLabel, mui8_versionLabelPrefixLength ) )
+    return false;
+
+  const unsigned labelEnd = m_pool.multiLanguage() ? 5 : 7;
+  bool differs = false;
+  for( unsigned i = mui8_versionLabelPrefixLength; i < labelEnd; ++i )
+  {
+    if( !isHashLabelChar( versionLabel[ i ] ) )
+      return false; // not generated by us, leave it alone.
+    if( versionLabel[ i ] != marrp7c_versionLabel[ i ] )
+      differs = true;
+  }
+  return differs;
+}
+
+
+void
+UploadPoolState_c::deleteObsoleteVersions()
+{
+  for( uint8_t i = 0; i < mui8_numObsoleteVersions; ++i )
+    (void)m_connection.commandHandler().sendNonVolatileDeleteVersion( marr_obsoleteVersions[ i ] );
+
+  mui8_numObsoleteVersions = 0;
+}
+
+
+// The label covers the VT properties the pool is adapted to and all languages,
+// the language code (if any) is set separately by setObjectPoolUploadingLanguage().
+void
+UploadPoolState_c::setContentHashVersionLabel()
+{
+  const PoolImageProperties_s properties = poolImageProperties( -1 );
+  const uint8_t header[] = {
+    uint8_t( properties.dimension ), uint8_t( properties.dimension >> 8 ),
+    uint8_t( properties.skWidth ), uint8_t( properties.skWidth >> 8 ),
+    uint8_t( properties.skHeight ), uint8_t( properties.skHeight >> 8 ),
+    uint8_t( properties.fontSizes ), uint8_t( properties.fontSizes >> 8 ),
+    properties.colourDepth, properties.skVirtual, properties.version };
+
+  uint32_t hash = ObjectPoolImage_c::hash( header, sizeof( header ) );
+
+  // the serialized image is needed for the upload anyway, so don't stream the objects twice
+  if( m_pool.usePoolImage() )
+    (void)preparePoolPart( mc_imageFix, -1, m_pool.getIVtObjects()[0], m_pool.getNumObjects() );
+
+  if( mc_imageFix.valid() )
+    hash = ObjectPoolImage_c::hash( mc_imageFix.data(), mc_imageFix.size(), hash );
+  else
+    hash = ObjectPoolImage_c::hashObjects( m_pool.getIVtObjects()[0], m_pool.getNumObjects(), *this, hash );
+
+  for( uint8_t lang = 0; lang < m_pool.getNumLang(); ++lang )
+    hash = ObjectPoolImage_c::hashObjects( m_pool.getIVtObjects()[ lang + 1 ], m_pool.getNumObjectsLang(), *this, hash );
+
+  const unsigned labelEnd = m_pool.multiLanguage() ? 5 : 7; // multi-language pools have the language code at 5 and 6
+  for( unsigned i = mui8_versionLabelPrefixLength; i < labelEnd; ++i )
+  {
+    marrp7c_versionLabel[ i ] = s_hashLabelChars[ hash & 0x1F ];
+    hash = ( hash >> 5 ) | ( hash << 27 );
+  }
+}
+
+
 void
 UploadPoolState_c::handleGetVersionsResponse( Stream_c *stream )
 {
@@ -242,6 +371,7 @@ UploadPoolState_c::handleGetVersionsResponse( Stream_c *stream )
     return;
 
   uint8_t number_of_versions = 0;
+  mui8_numObsoleteVersions = 0;
   if( stream != NULL )
   {
     number_of_versions = stream->get();
@@ -282,7 +412,10 @@ UploadPoolState_c::handleGetMemoryResponse( const CanPkgExt_c &pkg )
     else
     {
       // Take the language that's been set in the VT right NOW
-      setObjectPoolUploadingLanguage();
+      setObjectPoolUploadingLanguage( mi8_vtLanguage );
+
+      if( mb_contentHashVersionLabel )
+        setContentHashVersionLabel();
 
       if( mb_usingVersionLabel )
         startGetVersions();
@@ -338,14 +471,7 @@ UploadPoolState_c::handleLoadVersionResponse( unsigned errorNibble )
 
   if( errorNibble == 0 )
   {
-#ifdef ENABLE_SKM_HANDLER
-    // Call fitTerminal() for all soft key masks to create and initialize SkmHandlers for this VT connection
-    for (uint32_t curObject = 0; curObject < m_pool.getNumObjects(); ++curObject)
-    {
-      if( m_pool.getIVtObjects()[0][curObject]->getObjectType() == VT_OBJECT_TYPE_SOFT_KEY_MASK )
-        fitTerminalWrapper( *static_cast<vtObject_c*>( m_pool.getIVtObjects()[0][curObject] ) );
-    }
-#endif
+    fitTerminalSoftKeyMasks();
 
     finalizeUploading();
 #if DEBUG_VTCOMM || DEBUG_VTPOOLUPLOAD
@@ -373,6 +499,21 @@ UploadPoolState_c::handleLoadVersionResponse( unsigned errorNibble )
   }
 }
 
+
+void
+UploadPoolState_c::fitTerminalSoftKeyMasks()
+{
+#ifdef ENABLE_SKM_HANDLER
+  // Call fitTerminal() for all soft key masks to create and initialize SkmHandlers for this VT connection
+  for (uint32_t curObject = 0; curObject < m_pool.getNumObjects(); ++curObject)
+  {
+    if( m_pool.getIVtObjects()[0][curObject]->getObjectType() == VT_OBJECT_TYPE_SOFT_KEY_MASK )
+      fitTerminalWrapper( *static_cast<vtObject_c*>( m_pool.getIVtObjects()[0][curObject] ) );
+  }
+#endif
+}
+
+
 void
 UploadPoolState_c::uploadFailed( UploadError aen_uploadError )
 {
@@ -668,7 +809,7 @@ UploadPoolState_c::timeEventLanguageUpdate()
   if( (mi8_objectPoolUploadingLanguage == -2) // indicates no update running
    && (mi8_vtLanguage != mi8_objectPoolUploadedLanguage) )
   { // update languages on the fly
-    setObjectPoolUploadingLanguage();
+    setObjectPoolUploadingLanguage( mi8_vtLanguage );
     /// NOTIFY THE APPLICATION so it can enqueue some commands that are processed BEFORE the update is done
     /// e.g. switch to a "Wait while changing language..." datamask.
     m_pool.eventPrepareForLanguageChange( calcAppUploadingLanguage(), mui16_objectPoolUploadingLanguageCode );
@@ -789,6 +930,7 @@ UploadPoolState_c::startCurrentUploadPhase()
   case UploadPoolTypeUserPoolUpdate:
     streamer = ms_uploadPhaseUser.pc_streamer;
     mc_iVtObjectStreamer.mpc_objectsToUpload = mppc_uploadPhaseUserObjects;
+    mc_iVtObjectStreamer.setImage (NULL);
     mc_iVtObjectStreamer.setStreamSize (ms_uploadPhaseUser.ui32_size);
     break;
 
@@ -815,13 +957,23 @@ UploadPoolState_c::startCurrentUploadPhase()
     {
       case UploadPhaseIVtObjectsFix:
         mc_iVtObjectStreamer.mpc_objectsToUpload = m_pool.getIVtObjects()[0]; // main FIX (lang. indep) iVtObject part
+        mc_iVtObjectStreamer.setImage (mc_imageFix.valid() ? &mc_imageFix : NULL);
         mc_iVtObjectStreamer.setStreamSize (ms_uploadPhasesAutomatic [mui_uploadPhaseAutomatic].ui32_size);
         break;
 
       case UploadPhaseIVtObjectsLang:
       { // phase 0 & 1 use iVtObjectStreamer, so prepare for that!
-        const int8_t realUploadingLanguageAsIndex = calcRealUploadingLanguage( true ) + 1; // skip language-independent objects.
-        mc_iVtObjectStreamer.mpc_objectsToUpload = m_pool.getIVtObjects()[ realUploadingLanguageAsIndex ];
+        if (mb_languageDeltaUpload)
+        {
+          mc_iVtObjectStreamer.mpc_objectsToUpload = mc_languageDelta.objects();
+          mc_iVtObjectStreamer.setImage (mc_imageLangDelta.valid() ? &mc_imageLangDelta : NULL);
+        }
+        else
+        {
+          const int8_t realUploadingLanguageAsIndex = calcRealUploadingLanguage( true ) + 1; // skip language-independent objects.
+          mc_iVtObjectStreamer.mpc_objectsToUpload = m_pool.getIVtObjects()[ realUploadingLanguageAsIndex ];
+          mc_iVtObjectStreamer.setImage (mc_imageLang.valid() ? &mc_imageLang : NULL);
+        }
         mc_iVtObjectStreamer.setStreamSize (ms_uploadPhasesAutomatic [mui_uploadPhaseAutomatic].ui32_size);
       } break;
 
@@ -842,9 +994,9 @@ UploadPoolState_c::startCurrentUploadPhase()
 
 
 void
-UploadPoolState_c::setObjectPoolUploadingLanguage()
+UploadPoolState_c::setObjectPoolUploadingLanguage( int8_t language )
 {
-  mi8_objectPoolUploadingLanguage = mi8_vtLanguage;
+  mi8_objectPoolUploadingLanguage = language;
   mui16_objectPoolUploadingLanguageCode = 0x0000;
   if( m_pool.multiLanguage() )
   {
@@ -868,6 +1020,7 @@ UploadPoolState_c::finalizeUploading()
   { /// Was complete initial pool or language pool update.
     /// in both cases we uploaded in one specific language!! so do the following:
     mi8_objectPoolUploadedLanguage = mi8_objectPoolUploadingLanguage;
+    mui8_objectPoolUploadedRealLanguage = uint8_t( calcRealUploadingLanguage( true ) );
     mui16_objectPoolUploadedLanguageCode = mui16_objectPoolUploadingLanguageCode;
     mi8_objectPoolUploadingLanguage = -2; // -2 indicated that the language-update while pool is up IS IDLE!
     mui16_objectPoolUploadingLanguageCode = 0x0000;
@@ -887,6 +1040,9 @@ UploadPoolState_c::finalizeUploading()
       INTERNAL_DEBUG_DEVICE << "Now men_uploadPoolState = UploadPoolEndSuccess;" << INTERNAL_DEBUG_DEVICE_ENDL;
   #endif
       men_uploadPoolState = UploadPoolEndSuccess;
+
+      // now that the pool is up, clean up the VT's storage
+      deleteObsoleteVersions();
     }
 
 #ifdef USE_CCI_ISB_WORKAROUND
@@ -933,6 +1089,9 @@ UploadPoolState_c::initObjectPoolUploadingPhases(
     if (aui16_numOfUserPoolUpdateObjects == 0)
       return;
 
+    // the updated objects most probably got changed, so the images are outdated
+    invalidatePoolImage();
+
     /// INIT FIRST
     ms_uploadPhaseUser.pc_streamer = &mc_iVtObjectStreamer;
     ms_uploadPhaseUser.ui32_size = 1; // the 0x11 command-byte is always there.
@@ -950,9 +1109,8 @@ UploadPoolState_c::initObjectPoolUploadingPhases(
 
       /// Phase 0
       ms_uploadPhasesAutomatic [UploadPhaseIVtObjectsFix].pc_streamer = &mc_iVtObjectStreamer;
-      ms_uploadPhasesAutomatic [UploadPhaseIVtObjectsFix].ui32_size = 1; // the 0x11 command-byte is always there.
-      for (uint32_t curObject=0; curObject < m_pool.getNumObjects(); ++curObject)
-        ms_uploadPhasesAutomatic [UploadPhaseIVtObjectsFix].ui32_size += fitTerminalWrapper( *static_cast<vtObject_c*>( m_pool.getIVtObjects()[0][curObject] ) );
+      ms_uploadPhasesAutomatic [UploadPhaseIVtObjectsFix].ui32_size
+        = preparePoolPart( mc_imageFix, -1, m_pool.getIVtObjects()[0], m_pool.getNumObjects() );
 
       /// Phase 2
       const STL_NAMESPACE::pair<uint32_t, IsoAgLib::iMultiSendStreamer_c*> cpair_retval = m_pool.getAppSpecificFixPoolData();
@@ -968,17 +1126,22 @@ UploadPoolState_c::initObjectPoolUploadingPhases(
     /// Phase 1
     ms_uploadPhasesAutomatic [UploadPhaseIVtObjectsLang].pc_streamer = &mc_iVtObjectStreamer;
     ms_uploadPhasesAutomatic [UploadPhaseIVtObjectsLang].ui32_size = 0; // there may not always be a language part.
+    mb_languageDeltaUpload = false;
     if( m_pool.multiLanguage() )
     {
       // check if we need to fallback to the default-language
-      const int8_t realUploadingLanguageAsIndex = calcRealUploadingLanguage( true ) + 1; // skip language-independent objects.
+      const int8_t realUploadingLanguage = int8_t( calcRealUploadingLanguage( true ) );
 
-      for (uint32_t curObject=0; curObject < m_pool.getNumObjectsLang(); ++curObject)
+      if( ( ren_uploadPoolType == UploadPoolTypeLanguageUpdate ) && m_pool.useLanguageDeltaUpdate() )
+      { // the VT has the objects of the previous language, only upload those which changed
+        mb_languageDeltaUpload = true;
+        ms_uploadPhasesAutomatic[ UploadPhaseIVtObjectsLang ].ui32_size
+          = prepareLanguageDelta( mui8_objectPoolUploadedRealLanguage, uint8_t( realUploadingLanguage ) );
+      }
+      else
+      {
         ms_uploadPhasesAutomatic[ UploadPhaseIVtObjectsLang ].ui32_size
-          += fitTerminalWrapper( *static_cast<vtObject_c*>( m_pool.getIVtObjects()[ realUploadingLanguageAsIndex ][ curObject ] ) );
-      if (ms_uploadPhasesAutomatic[ UploadPhaseIVtObjectsLang ].ui32_size > 0)
-      { // only if there's at least one object being streamed up as user-partial-objectpool-update add the CMD byte for size calculation...
-        ++ms_uploadPhasesAutomatic[ UploadPhaseIVtObjectsLang ].ui32_size; // add the 0x11 byte!
+          = preparePoolPart( mc_imageLang, realUploadingLanguage, m_pool.getIVtObjects()[ realUploadingLanguage + 1 ], m_pool.getNumObjectsLang() ); // skip language-independent objects.
       }
     } // else: no LANGUAGE SPECIFIC objectpool, so keep this at 0 to indicate this!
 
@@ -994,6 +1157,121 @@ UploadPoolState_c::initObjectPoolUploadingPhases(
 }
 
 
+PoolImageProperties_s
+UploadPoolState_c::poolImageProperties( int8_t language ) const
+{
+  const VtServerInstance_c::vtCapabilities_s &caps = m_connection.getVtServerInst().getVtCapabilities();
+
+  PoolImageProperties_s properties;
+  properties.dimension = m_connection.getHwDimension();
+  properties.skWidth = m_connection.getSkWidth();
+  properties.skHeight = m_connection.getSkHeight();
+  properties.fontSizes = caps.fontSizes;
+  properties.hwOffsetX = m_connection.getHwOffsetX();
+  properties.hwOffsetY = m_connection.getHwOffsetY();
+  properties.skOffsetX = m_connection.getSkOffsetX();
+  properties.skOffsetY = m_connection.getSkOffsetY();
+  properties.colourDepth = caps.hwGraphicType;
+  properties.skVirtual = caps.skVirtual;
+  properties.version = m_uploadingVersion;
+  properties.language = language;
+  return properties;
+}
+
+
+// @return size including the 0x11 byte, 0 if there's no object to upload at all (language part only)
+uint32_t
+UploadPoolState_c::calcPoolPartSize( IsoAgLib::iVtObject_c* const HUGE_MEM* objects, uint16_t numObjects ) const
+{
+  uint32_t size = 0;
+  for (uint32_t curObject=0; curObject < numObjects; ++curObject)
+    size += fitTerminalWrapper( *static_cast<vtObject_c*>( objects[ curObject ] ) );
+
+  return size;
+}
+
+
+// Calculates the size of a pool part, using/building the part's image if the pool wants images.
+// @param language -1 for the language independent part
+uint32_t
+UploadPoolState_c::preparePoolPart( ObjectPoolImage_c& image, int8_t language, IsoAgLib::iVtObject_c* const HUGE_MEM* objects, uint16_t numObjects )
+{
+  if( mb_poolImageOutdated )
+  {
+    mc_imageFix.clear();
+    mc_imageLang.clear();
+    mb_poolImageOutdated = false;
+  }
+
+  if( !m_pool.usePoolImage() )
+  {
+    image.clear();
+    const uint32_t size = calcPoolPartSize( objects, numObjects );
+    // the language independent part always has the 0x11 command-byte, the language part only if there are objects
+    return ( ( size > 0 ) || ( language < 0 ) ) ? size + 1 : 0;
+  }
+
+  const PoolImageProperties_s properties = poolImageProperties( language );
+  if( !image.matches( properties ) )
+  {
+    uint32_t precompiledSize = 0;
+    const uint8_t* precompiled = m_pool.getPrecompiledPoolImage( properties, precompiledSize );
+    const ObjectPoolImage_c* shared = NULL;
+    if( ( precompiled == NULL ) && ( m_pool.getPoolImageShareKey() != 0 ) )
+      shared = getVtClientInstance( m_connection.getMultitonInst() ).findSharedPoolImage( m_pool.getPoolImageShareKey(), properties, m_connection );
+
+    if( precompiled != NULL )
+      image.assign( properties, precompiled, precompiledSize );
+    else if( shared != NULL )
+      image.share( *shared ); // serialized already for the upload to another VT
+    else
+      image.clear();
+  }
+
+  if( image.valid() )
+  {
+    if( language < 0 )
+      fitTerminalSoftKeyMasks(); // as the objects are not fitted for the size calculation
+    return image.size();
+  }
+
+  uint32_t size = calcPoolPartSize( objects, numObjects );
+  if( ( size == 0 ) && ( language >= 0 ) )
+    return 0;
+
+  ++size; // add the 0x11 byte!
+  image.build( properties, objects, numObjects, size, *this );
+  return size;
+}
+
+
+// Calculates the size of the language part's objects that differ between the two languages,
+// building their image if the pool wants images.
+// @return size including the 0x11 byte, 0 if no object differs
+uint32_t
+UploadPoolState_c::prepareLanguageDelta( uint8_t sourceLanguage, uint8_t targetLanguage )
+{
+  mc_imageLangDelta.clear();
+
+  const uint16_t numObjects = mc_languageDelta.collect(
+    poolImageProperties( -1 ), sourceLanguage, targetLanguage, m_pool, *this );
+
+  uint32_t size = calcPoolPartSize( mc_languageDelta.objects(), numObjects );
+  if( size == 0 )
+    return 0;
+
+  ++size; // add the 0x11 byte!
+  if( m_pool.usePoolImage() )
+    (void)mc_imageLangDelta.build( poolImageProperties( int8_t( targetLanguage ) ), mc_languageDelta.objects(), numObjects, size, *this );
+
+#if DEBUG_VTCOMM || DEBUG_VTPOOLUPLOAD
+  INTERNAL_DEBUG_DEVICE << "Language update from " << unsigned( sourceLanguage ) << " to " << unsigned( targetLanguage ) << ": "
+                        << numObjects << " of " << m_pool.getNumObjectsLang() << " objects differ." << INTERNAL_DEBUG_DEVICE_ENDL;
+#endif
+  return size;
+}
+
+
 unsigned
 UploadPoolState_c::calcRealUploadingLanguage( bool considerReject ) const
 {
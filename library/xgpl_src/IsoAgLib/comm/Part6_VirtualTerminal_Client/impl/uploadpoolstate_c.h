@@ -22,6 +22,8 @@
 
 #include <IsoAgLib/comm/Part3_DataLink/impl/multisend_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/objectpoolstreamer_c.h>
+#include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/objectpoolimage_c.h>
+#include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/languagedelta_c.h>
 #include <IsoAgLib/util/impl/bitfieldwrapper_c.h>
 
 namespace IsoAgLib { class iVtObject_c; }
@@ -138,8 +140,17 @@ namespace __IsoAgLib {
     // @return needRestart?
     bool handleEndOfObjectPoolResponseOnLanguageUpdate( bool success );
 
+    //! drop the serialized pool images, the next upload serializes the objects again
+    void invalidatePoolImage() { mb_poolImageOutdated = true; mc_languageDelta.invalidate(); }
+    //! @return image of the language independent (false) or the language part (true), may be invalid
+    const ObjectPoolImage_c& poolImage( bool languagePart ) const { return languagePart ? mc_imageLang : mc_imageFix; }
+    bool poolImageOutdated() const { return mb_poolImageOutdated; }
+
   private:
     bool searchVersionsAndMarkRejected( Stream_c&, uint8_t numVersions );
+    bool isObsoleteVersion( const char* versionLabel ) const;
+    void deleteObsoleteVersions();
+    void setContentHashVersionLabel();
     unsigned calcRealUploadingLanguage( bool considerReject ) const;
     int8_t calcAppUploadingLanguage() const;
     uint8_t rejectOffset( uint8_t langCode0, uint8_t langCode1 ) const;
@@ -149,6 +160,12 @@ namespace __IsoAgLib {
     void handleGetMemoryResponse( const CanPkgExt_c &pkg );
     void handleStoreVersionResponse( unsigned errorNibble );
     void handleLoadVersionResponse( unsigned errorNibble );
+    void fitTerminalSoftKeyMasks();
+
+    PoolImageProperties_s poolImageProperties( int8_t language ) const;
+    uint32_t calcPoolPartSize( IsoAgLib::iVtObject_c* const HUGE_MEM* objects, uint16_t numObjects ) const;
+    uint32_t preparePoolPart( ObjectPoolImage_c& image, int8_t language, IsoAgLib::iVtObject_c* const HUGE_MEM* objects, uint16_t numObjects );
+    uint32_t prepareLanguageDelta( uint8_t sourceLanguage, uint8_t targetLanguage );
 
     void startUploadVersion();
     void startLoadVersion();
@@ -161,7 +178,7 @@ namespace __IsoAgLib {
 
     void indicateUploadPhaseCompletion();
     void indicateUploadCompletion(); // all phases completed.
-    void setObjectPoolUploadingLanguage();
+    void setObjectPoolUploadingLanguage( int8_t language );
 
     int8_t getLanguageIndex( uint8_t langCode0, uint8_t langCode1 ) const;
 
@@ -176,9 +193,17 @@ namespace __IsoAgLib {
 
     bool mb_usingVersionLabel; // if NOT using version label, "marrp7c_versionLabel" has random values!
     char marrp7c_versionLabel[ 7 ];
+    bool mb_contentHashVersionLabel; // the label's characters behind the prefix are derived from the pool's content
+    uint8_t mui8_versionLabelPrefixLength;
 
     uint8_t m_uploadingVersion; // if uploading a v3 client to a v2 VT (without Aux2), uploadingVersion will be v2
     ObjectPoolStreamer_c mc_iVtObjectStreamer;
+    ObjectPoolImage_c mc_imageFix;  // only used if the pool wants images
+    ObjectPoolImage_c mc_imageLang;
+    LanguageDelta_c mc_languageDelta; // objects to upload on a language update, if the pool wants that
+    ObjectPoolImage_c mc_imageLangDelta; // image of the above objects, only used if the pool wants images
+    bool mb_languageDeltaUpload;
+    bool mb_poolImageOutdated; // images may still be streamed, so they're only dropped when preparing the next upload
     UploadPoolState_t men_uploadPoolState;
     UploadPoolType_t men_uploadPoolType;
 
@@ -195,6 +220,7 @@ namespace __IsoAgLib {
 
     int8_t mi8_objectPoolUploadingLanguage; // only valid if "initially uploading" or "language updating"
     int8_t mi8_objectPoolUploadedLanguage;  // only valid if "ObjectPoolUploadedSuccessfully"
+    uint8_t mui8_objectPoolUploadedRealLanguage; // language part on the VT (with fallback to the default language)
 
     uint16_t mui16_objectPoolUploadingLanguageCode;
     uint16_t mui16_objectPoolUploadedLanguageCode;
@@ -208,6 +234,9 @@ namespace __IsoAgLib {
     int8_t mi8_vtLanguage; // always valid, as we're waiting for a VT's language first before starting anything...
 
     IsoaglibArrayBitset<64> m_langRejectedUseDefaultAsFallback; // 64 languages should be enough for everybody :)
+
+    char marr_obsoleteVersions[ CONFIG_VT_CLIENT_MAX_OBSOLETE_VERSIONS ][ 7 ];
+    uint8_t mui8_numObsoleteVersions;
   };
 
 
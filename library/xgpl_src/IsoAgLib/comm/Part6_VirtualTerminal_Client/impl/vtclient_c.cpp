@@ -187,6 +187,34 @@ VtClient_c::getClientCount() const
 }
 
 
+
+const ObjectPoolImage_c*
+VtClient_c::findSharedPoolImage( uint32_t aui32_shareKey, const PoolImageProperties_s& arc_properties, const VtClientConnection_c& arc_requester ) const
+{
+  isoaglib_assert( aui32_shareKey != 0 );
+
+  for( unsigned index = 0; index < m_vtConnections.size(); ++index )
+  {
+    VtClientConnection_c* connection = m_vtConnections[ index ];
+    if( ( connection == NULL ) || ( connection == &arc_requester ) )
+      continue;
+
+    const IsoAgLib::iVtClientObjectPool_c& pool = connection->getPool();
+    if( !pool.usePoolImage() || ( pool.getPoolImageShareKey() != aui32_shareKey ) )
+      continue;
+
+    const UploadPoolState_c& uploadPoolState = connection->uploadPoolState();
+    if( uploadPoolState.poolImageOutdated() )
+      continue;
+
+    const ObjectPoolImage_c& image = uploadPoolState.poolImage( arc_properties.language >= 0 );
+    if( image.shareable() && image.matches( arc_properties ) )
+      return &image;
+  }
+  return NULL;
+}
+
+
 void 
 VtClient_c::processMsg( const CanPkg_c& arc_data )
 {
@@ -67,6 +67,11 @@ public:
   VtClientConnection_c& getClientByID (uint8_t ui8_clientIndex) { return *m_vtConnections[ui8_clientIndex]; }
   VtClientConnection_c* getClientPtrByID (uint8_t ui8_clientIndex) { return ( ui8_clientIndex < m_vtConnections.size() ) ? m_vtConnections[ui8_clientIndex] : NULL; }
 
+  /** @return pool image built by another connection whose pool has the same share key
+              (see iVtClientObjectPool_c::getPoolImageShareKey) for these properties
+              (same scaling and offsets), NULL if none */
+  const ObjectPoolImage_c* findSharedPoolImage( uint32_t aui32_shareKey, const PoolImageProperties_s& arc_properties, const VtClientConnection_c& arc_requester ) const;
+
   bool isAnyVtAvailable() const { return m_serverManager.isAnyVtAvailable(); }
   // is any claimed VT sending VT status
   bool isAnyVtActive( bool mustBePrimary ) const { return (getActiveVtServer( mustBePrimary, NULL ) != NULL); }
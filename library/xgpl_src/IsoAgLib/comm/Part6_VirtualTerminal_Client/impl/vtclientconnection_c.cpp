@@ -31,8 +31,11 @@
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/ivtobjectauxiliaryfunction2_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/ivtobjectauxiliaryinput2_c.h>
 #include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtserverinstance_c.h>
+#include <IsoAgLib/comm/Part6_VirtualTerminal_Client/impl/vtobjectfontattributes_c.h>
 #include <IsoAgLib/util/iassert.h>
 
+#include <cstring>
+
 #if DEBUG_VTCOMM
   #include <supplementary_driver/driver/rs232/impl/rs232io_c.h>
   #include <IsoAgLib/util/impl/util_funcs.h>
@@ -149,6 +152,8 @@ VtClientConnection_c::VtClientConnection_c(
   , m_skHeight( 0 ) // to be retrieved from the VT / APP
   , m_skOffsetX( 0 ) // to be retrieved from the APP
   , m_skOffsetY( 0 ) // to be retrieved from the APP
+  , ms_scaling()
+  , mui16_scaledFontSizesVt( 0 )
   , mc_preferredVt( IsoName_c::IsoNameUnspecified() )
   , mi32_bootTime_ms( 0 )
   , mb_reconnect( true )
@@ -156,6 +161,9 @@ VtClientConnection_c::VtClientConnection_c(
   , m_dataStorageHandler( arc_dataStorage )
   , m_schedulerTaskProxy( *this, 100, false )
 {
+  ms_scaling.skFactorD = 1;
+  CNAMESPACE::memset( marr_scaledFontSize, 0xFF, sizeof( marr_scaledFontSize ) );
+
   // can't be done in c'tor due to back-ref to *this
   m_uploadPoolState.initPool();
 
@@ -925,6 +933,62 @@ VtClientConnection_c::populateScalingInformation()
     static_cast< const IsoAgLib::iIsoName_c &>( getVtServerInst().getIsoName() ),
     m_hwDimension,         m_hwOffsetX, m_hwOffsetY,
     m_skWidth, m_skHeight, m_skOffsetX, m_skOffsetY );
+
+  ms_scaling.opDimension = getVtObjectPoolDimension();
+  ms_scaling.vtDimension = m_hwDimension;
+  ms_scaling.vtOffsetX = m_hwOffsetX;
+  ms_scaling.vtOffsetY = m_hwOffsetY;
+  ms_scaling.opSoftKeyWidth = getVtObjectPoolSoftKeyWidth();
+  ms_scaling.opSoftKeyHeight = getVtObjectPoolSoftKeyHeight();
+  ms_scaling.vtSoftKeyWidth = m_skWidth;
+  ms_scaling.vtSoftKeyHeight = m_skHeight;
+  ms_scaling.skOffsetX = m_skOffsetX;
+  ms_scaling.skOffsetY = m_skOffsetY;
+
+  ms_scaling.skFactorM = 1;
+  ms_scaling.skFactorD = 1;
+  if( ( ms_scaling.opSoftKeyWidth > 0 ) && ( ms_scaling.opSoftKeyHeight > 0 ) )
+  {
+    const int32_t ci_factorX = ( ms_scaling.vtSoftKeyWidth  << 20 ) / ms_scaling.opSoftKeyWidth;
+    const int32_t ci_factorY = ( ms_scaling.vtSoftKeyHeight << 20 ) / ms_scaling.opSoftKeyHeight;
+    if( ci_factorX < ci_factorY )
+    {
+      ms_scaling.skFactorM = ms_scaling.vtSoftKeyWidth;
+      ms_scaling.skFactorD = ms_scaling.opSoftKeyWidth;
+    }
+    else
+    {
+      ms_scaling.skFactorM = ms_scaling.vtSoftKeyHeight;
+      ms_scaling.skFactorD = ms_scaling.opSoftKeyHeight;
+    }
+  }
+
+  // the font sizes depend on the factors, too
+  CNAMESPACE::memset( marr_scaledFontSize, 0xFF, sizeof( marr_scaledFontSize ) );
+}
+
+
+uint8_t
+VtClientConnection_c::getScaledFontSize( uint8_t aui8_fontSize, bool ab_softKeyScaling ) const
+{
+  if( aui8_fontSize > ( 15-1 ) )
+    aui8_fontSize = ( 15-1 );
+
+  const uint16_t cui16_vtFontSizes = getVtServerInst().getVtFontSizes();
+  if( cui16_vtFontSizes != mui16_scaledFontSizesVt )
+  {
+    CNAMESPACE::memset( marr_scaledFontSize, 0xFF, sizeof( marr_scaledFontSize ) );
+    mui16_scaledFontSizesVt = cui16_vtFontSizes;
+  }
+
+  uint8_t& scaled = marr_scaledFontSize[ ab_softKeyScaling ? 1 : 0 ][ aui8_fontSize ];
+  if( scaled == 0xFF )
+  {
+    scaled = ab_softKeyScaling
+      ? vtObjectFontAttributes_c::scaleFontSize( aui8_fontSize, ms_scaling.skFactorM, ms_scaling.skFactorD, cui16_vtFontSizes )
+      : vtObjectFontAttributes_c::scaleFontSize( aui8_fontSize, ms_scaling.vtDimension, ms_scaling.opDimension, cui16_vtFontSizes );
+  }
+  return scaled;
 }
 
 
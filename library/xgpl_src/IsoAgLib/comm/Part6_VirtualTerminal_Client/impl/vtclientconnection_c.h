@@ -80,10 +80,13 @@ public:
   IsoAgLib::iVtClientConnection_c* toInterfacePointer();
 
   UploadPoolState_c &uploadPoolState() { return m_uploadPoolState; }
+  const UploadPoolState_c &uploadPoolState() const { return m_uploadPoolState; }
   IsoAgLib::iVtClientObjectPool_c& getPool() const { return m_uploadPoolState.getPool(); }
   IsoAgLib::iVtClientDataStorage_c& getVtClientDataStorage() const { return m_dataStorageHandler; }
   CommandHandler_c &commandHandler() { return m_commandHandler; }
   const CommandHandler_c &commandHandler() const { return m_commandHandler; }
+  Aux2Functions_c &aux2Functions() { return m_aux2Functions; }
+  const Aux2Functions_c &aux2Functions() const { return m_aux2Functions; }
   Aux2Inputs_c &aux2Inputs() { return m_aux2Inputs; }
 
   bool poolSuccessfullyUploaded() const { return m_uploadPoolState.successfullyUploaded(); }
@@ -120,6 +123,12 @@ public:
   uint16_t getVtObjectPoolDimension() const;
   uint16_t getVtObjectPoolSoftKeyWidth() const;
   uint16_t getVtObjectPoolSoftKeyHeight() const;
+
+  /// scaling factors for the current VT, see populateScalingInformation
+  const VtScaling_s& getScaling() const { return ms_scaling; }
+  /** @return font size the pool's font size is scaled to, for mask or soft key scaling
+      (cached per VT font sizes, button scaling differs per button and isn't cached) */
+  uint8_t getScaledFontSize( uint8_t aui8_fontSize, bool ab_softKeyScaling ) const;
   uint8_t  getUserConvertedColor (uint8_t colorValue, IsoAgLib::iVtObject_c* obj, IsoAgLib::e_vtColour whichColour);
   uint8_t  getClientId() const { return mui8_clientId; }
 
@@ -227,6 +236,10 @@ private:
   uint16_t m_skOffsetX;  // Add an X offset to every object on an alarm / data mask
   uint16_t m_skOffsetY;  // Add an Y offset to every object on an alarm / data mask
 
+  VtScaling_s ms_scaling; // derived from the above once per upload
+  mutable uint8_t marr_scaledFontSize[ 2 ][ 15 ]; // [soft key scaling][font size], 0xFF: not yet calculated
+  mutable uint16_t mui16_scaledFontSizesVt; // VT font sizes marr_scaledFontSize is valid for
+
   IsoName_c mc_preferredVt;
   int32_t mi32_bootTime_ms;
   bool mb_reconnect;
@@ -244,7 +257,7 @@ inline
 void
 VtClientConnection_c::notifyOnCommandQueueFilledFromEmpty()
 {
-  m_schedulerTaskProxy.retriggerNow();
+  m_schedulerTaskProxy.trigger();
 }
 
 
@@ -256,7 +269,7 @@ VtClientConnection_c::notifyOnFinishedCommand( bool stillCommandsLeft )
 
   // immediately on next timeEvent send out next command
   if( stillCommandsLeft )
-    m_schedulerTaskProxy.retriggerNow();
+    m_schedulerTaskProxy.trigger();
 }
 
 
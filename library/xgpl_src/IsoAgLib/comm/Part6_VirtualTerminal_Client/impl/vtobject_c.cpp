@@ -91,13 +91,28 @@ vtObject_c::createRamStructIfNotYet (uint16_t ui16_structLen)
 { // Do we have to generate a RAM copy of our struct (to save the value), or has this already be done?
   if (!(s_properties.flags & FLAG_IN_RAM)) {
     void* old=vtObject_a;
-    vtObject_a = (iVtObject_s*) new uint8_t [ui16_structLen];
+    // pack the copies into the arena of the registered pool, which hands back the ROM struct when it's freed
+    VtClientConnection_c* connection = getVtClientInstance4Comm().getClientPtrByID (s_properties.clientId);
+    if (connection)
+      vtObject_a = (iVtObject_s*) connection->getPool().getRamStructArena().allocate (ui16_structLen, *this, old);
+    else
+      vtObject_a = (iVtObject_s*) new uint8_t [ui16_structLen];
     CNAMESPACE::memcpy (vtObject_a, old, ui16_structLen);
     s_properties.flags |= FLAG_IN_RAM;
   }
 }
 
 
+void
+vtObject_c::releaseRamStruct (const void* ap_ramStruct, void* ap_romStruct)
+{ // only if not re-initialized (and possibly copied into another arena) in the meantime
+  if ((s_properties.flags & FLAG_IN_RAM) && (vtObject_a == ap_ramStruct)) {
+    vtObject_a = (iVtObject_s*) ap_romStruct;
+    s_properties.flags &= ~FLAG_IN_RAM;
+  }
+}
+
+
 // //////////////////////////////// saveValue(8/16/32)
 void
 vtObject_c::saveValue8 (uint16_t ui16_structOffset, uint16_t ui16_structLen, uint8_t ui8_newValue)
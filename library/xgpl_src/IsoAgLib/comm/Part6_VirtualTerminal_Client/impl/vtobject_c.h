@@ -58,8 +58,13 @@ public:
     MULTITON_INST_INIT_CALL
   }
 
+  /** switch back to the ROM struct, called when the arena holding the RAM copy is freed */
+  void releaseRamStruct (const void* ap_ramStruct, void* ap_romStruct);
+
   //! Internal checker function
   bool isOmittedFromUpload() const;
+  //! @return true if the object got changed at runtime (it's not serialized from its ROM attributes then)
+  bool isChangedInRam() const;
 
 protected:
   iVtObject_s& get_vtObject_a()
@@ -143,6 +148,14 @@ vtObject_c::isOmittedFromUpload() const
 }
 
 
+inline
+bool
+vtObject_c::isChangedInRam() const
+{
+  return (s_properties.flags & (FLAG_IN_RAM | FLAG_STRING_IN_RAM | FLAG_OBJECTS2FOLLOW_IN_RAM)) != 0;
+}
+
+
 } // __IsoAgLib
 
 #endif
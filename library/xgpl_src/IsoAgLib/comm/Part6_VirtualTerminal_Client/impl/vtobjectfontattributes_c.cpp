@@ -112,25 +112,33 @@ void
 vtObjectFontAttributes_c::calcScaledFontDimension() const
 {
   MACRO_localVars;
-  MACRO_scaleLocalVars;
-  MACRO_scaleSKLocalVars;
 
   // you can call it idempotent!!
   if (mui8_fontSizeScaled != 0xFF)
     return; // already calculated
 
-  mui8_fontSizeScaled = vtObjectFontAttributes_a->fontSize;
-  if (mui8_fontSizeScaled > (15-1)) mui8_fontSizeScaled = (15-1);
+  const VtClientConnection_c& connection = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId);
+  if (p_parentButtonObject) {
+    // the factors differ per button, so they're not cached by the connection
+    MACRO_scaleLocalVars;
+    MACRO_scaleSKLocalVars;
+    mui8_fontSizeScaled = scaleFontSize (vtObjectFontAttributes_a->fontSize, factorM, factorD, connection.getVtServerInst().getVtFontSizes());
+  } else {
+    mui8_fontSizeScaled = connection.getScaledFontSize (vtObjectFontAttributes_a->fontSize, (s_properties.flags & FLAG_ORIGIN_SKM) != 0);
+  }
+}
+
+
+uint8_t
+vtObjectFontAttributes_c::scaleFontSize (uint8_t fontSize, int32_t scaleM, int32_t scaleD, uint16_t vtFontSizes)
+{
+  uint8_t fontSizeScaled = fontSize;
+  if (fontSizeScaled > (15-1)) fontSizeScaled = (15-1);
 
   uint32_t width, height;
   uint8_t wIndex=0, hIndex=0;
-  if ((s_properties.flags & FLAG_ORIGIN_SKM) || p_parentButtonObject) {
-    width = (((uint32_t) factorM * (marr_font2PixelDimensionTableW [mui8_fontSizeScaled]) <<10)/factorD); // (8 bit shifted fixed floating)
-    height= (((uint32_t) factorM * (marr_font2PixelDimensionTableH [mui8_fontSizeScaled]) <<10)/factorD); // (8 bit shifted fixed floating)
-  } else {
-    width = (((uint32_t) vtDimension * (marr_font2PixelDimensionTableW [mui8_fontSizeScaled]) <<10)/opDimension); // (8 bit shifted fixed floating)
-    height= (((uint32_t) vtDimension * (marr_font2PixelDimensionTableH [mui8_fontSizeScaled]) <<10)/opDimension); // (8 bit shifted fixed floating)
-  }
+  width = (((uint32_t) scaleM * (marr_font2PixelDimensionTableW [fontSizeScaled]) <<10)/scaleD); // (8 bit shifted fixed floating)
+  height= (((uint32_t) scaleM * (marr_font2PixelDimensionTableH [fontSizeScaled]) <<10)/scaleD); // (8 bit shifted fixed floating)
 
   /** @todo SOON-174 maybe keep aspect ratio?? Make it a user-flag on registerIsoObjectPool? Or put it into the objects itself?? */
   // now get the lower possible size...
@@ -149,20 +157,21 @@ vtObjectFontAttributes_c::calcScaledFontDimension() const
   }
   if ((i < 0) || (j < 0))
   { // too small font, smaller than 6x8... ==> take 6x8
-    mui8_fontSizeScaled = 0;
+    fontSizeScaled = 0;
   }
   else
   { // match indices together... take the lowest one, that'll do!
     if (wIndex < hIndex)
-      mui8_fontSizeScaled = wIndex;
+      fontSizeScaled = wIndex;
     else
-      mui8_fontSizeScaled = hIndex;
+      fontSizeScaled = hIndex;
   }
 
   /// Always check if the font is available!
-  while (!(__IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getVtServerInst().getVtFontSizes() & (1 << mui8_fontSizeScaled))) {
-    mui8_fontSizeScaled--; // try a smaller font, but "6x8" should be there in any way, 'cause we set it in processMsg!!
+  while (!(vtFontSizes & (1 << fontSizeScaled))) {
+    fontSizeScaled--; // try a smaller font, but "6x8" should be there in any way, 'cause we set it in processMsg!!
   }
+  return fontSizeScaled;
 }
 
 void
@@ -47,6 +47,9 @@ public:
 
   uint16_t getScaledWidthHeight();
 
+  //! @return the largest font size of the VT that fits the font size scaled by scaleM/scaleD
+  static uint8_t scaleFontSize (uint8_t fontSize, int32_t scaleM, int32_t scaleD, uint16_t vtFontSizes);
+
   // //////////////////////////////////
   // All special Attribute-Set methods
   void setFontColour(uint8_t newValue,  bool b_updateObject=false, bool b_enableReplaceOfCmd=false) {
@@ -152,6 +152,8 @@ vtObjectPictureGraphic_c::stream(uint8_t* destMemory, uint16_t maxBytes, objRang
       }
     }
 
+    const bool runtimeRle = selectRuntimeRle( rawData, numberOfBytesInRawData, options );
+
     // Get a ref to the vtClient, so that we can convert colours by calling getUserConvertedColor() over and over
     VtClientConnection_c& vtClient = __IsoAgLib::getVtClientInstance4Comm().getClientByID(s_properties.clientId);
     const uint32_t pgheaderSize = 17;
@@ -212,13 +214,17 @@ vtObjectPictureGraphic_c::stream(uint8_t* destMemory, uint16_t maxBytes, objRang
 
     while ((sourceOffset >= pgheaderSize) && (sourceOffset < (pgheaderSize+numberOfBytesInRawData)) && ((curBytes+1) <= maxBytes))
     {
+      const uint8_t rawByte = runtimeRle
+        ? runtimeRleByte( sourceOffset - pgheaderSize )
+        : rawData [sourceOffset-pgheaderSize];
+
 #ifdef CONFIG_VT_CLIENT_PICTURE_GRAPHIC_COLOUR_CONVERSION
         if( sourceOffset < (pgheaderSize + (vtObjectPictureGraphic_a->numberOfMacrosToFollow << 1)) )
         {
             // Copy over the macros
             // 2 bytes for each macro defined, so the end of the macros is
             // sourceOffset + (pgheaderSize + (vtObjectPictureGraphic_a->numberOfMacrosToFollow << 1))
-            destMemory [curBytes] = rawData [sourceOffset-pgheaderSize];
+            destMemory [curBytes] = rawByte;
         }
         else
         {
@@ -226,7 +232,7 @@ vtObjectPictureGraphic_c::stream(uint8_t* destMemory, uint16_t maxBytes, objRang
             if ((options & 0x04) && (sourceOffset & 0x01))
             {
                 // just return the byte without conversion
-                destMemory[curBytes] = rawData[sourceOffset - pgheaderSize];
+                destMemory[curBytes] = rawByte;
             }
             else
             {
@@ -238,16 +244,16 @@ vtObjectPictureGraphic_c::stream(uint8_t* destMemory, uint16_t maxBytes, objRang
                 switch (ui8_graphicType)
                 {
                 case 2: // 8-bit
-                    destMemory[curBytes] = vtClient.getUserConvertedColor(rawData[sourceOffset - pgheaderSize], this, IsoAgLib::PictureGraphicColour);
+                    destMemory[curBytes] = vtClient.getUserConvertedColor(rawByte, this, IsoAgLib::PictureGraphicColour);
                     break;
 
                 case 1: // 4-bit - Convert only 4 bits at a time (2 function calls)
                     // Convert 2 color codes (YES, convert color)
                     destMemory[curBytes] =
                         (
-                            vtClient.getUserConvertedColor(rawData[sourceOffset - pgheaderSize] & 0x0F, this, IsoAgLib::PictureGraphicColour)			// Colour in Bottom 4 bits
+                            vtClient.getUserConvertedColor(rawByte & 0x0F, this, IsoAgLib::PictureGraphicColour)			// Colour in Bottom 4 bits
                         |
-                            (vtClient.getUserConvertedColor((rawData[sourceOffset - pgheaderSize] & 0xF0) >> 4, this, IsoAgLib::PictureGraphicColour)	// Colour in Top 4 bits
+                            (vtClient.getUserConvertedColor((rawByte & 0xF0) >> 4, this, IsoAgLib::PictureGraphicColour)	// Colour in Top 4 bits
                              << 4)
                         );
                     break;
@@ -256,7 +262,7 @@ vtObjectPictureGraphic_c::stream(uint8_t* destMemory, uint16_t maxBytes, objRang
                     switch (colourOperation)
                     {
                     case NoChange:
-                        destMemory[curBytes] = rawData[sourceOffset - pgheaderSize];
+                        destMemory[curBytes] = rawByte;
                         break;
 
                     case SetToZero:
@@ -268,7 +274,7 @@ vtObjectPictureGraphic_c::stream(uint8_t* destMemory, uint16_t maxBytes, objRang
                         break;
 
                     case Toggle:
-                        destMemory[curBytes] = rawData[sourceOffset - pgheaderSize] ^ 0xFF;
+                        destMemory[curBytes] = rawByte ^ 0xFF;
                         break;
                     }
                     break;
@@ -280,7 +286,7 @@ vtObjectPictureGraphic_c::stream(uint8_t* destMemory, uint16_t maxBytes, objRang
             }
         }
 #else
-      destMemory [curBytes] = rawData [sourceOffset-pgheaderSize];
+      destMemory [curBytes] = rawByte;
 #endif
 
       curBytes++;
@@ -306,23 +312,67 @@ vtObjectPictureGraphic_c::fitTerminal() const
 
   MACRO_calculateRequestedSize
 
+  const HUGE_MEM uint8_t* rawData = NULL;
+  uint8_t options = 0;
+
   MACRO_CheckFixedBitmapsLoop_start
+      rawData = vtObjectPictureGraphic_a->fixedBitmapsToFollow [fixNr].rawData;
       numberOfBytesInRawData = vtObjectPictureGraphic_a->fixedBitmapsToFollow [fixNr].numberOfBytesInRawData;
+      options = vtObjectPictureGraphic_a->fixedBitmapsToFollow [fixNr].formatoptions & 0x7;
   MACRO_CheckFixedBitmapsLoop_end
 
   if (!b_foundFixedBitmap) {
     MACRO_calculate_ui8_graphicType
     switch (ui8_graphicType) {
-      case 2:  MACRO_helperForDifferentSizesSizeOnly (numberOfBytesInRawData2) break;
-      case 1:  MACRO_helperForDifferentSizesSizeOnly (numberOfBytesInRawData1) break;
+      case 2:  MACRO_helperForDifferentSizes (numberOfBytesInRawData2, options, rawData2, 0x10) break;
+      case 1:  MACRO_helperForDifferentSizes (numberOfBytesInRawData1, options, rawData1, 0x08) break;
       case 0:
-      default: MACRO_helperForDifferentSizesSizeOnly (numberOfBytesInRawData0) break;
+      default: MACRO_helperForDifferentSizes (numberOfBytesInRawData0, options, rawData0, 0x04) break;
     }
   }
 
+  (void)selectRuntimeRle( rawData, numberOfBytesInRawData, options );
+
   return 17+numberOfBytesInRawData+vtObjectPictureGraphic_a->numberOfMacrosToFollow*2;
 }
 
+
+bool
+vtObjectPictureGraphic_c::selectRuntimeRle( const HUGE_MEM uint8_t* rawData, uint32_t& numberOfBytesInRawData, uint8_t& options ) const
+{
+#ifdef CONFIG_VT_CLIENT_PICTURE_GRAPHIC_RUNTIME_RLE
+  // already RLE encoded by vt2iso or the application
+  if( ( options & 0x04 ) || ( rawData == NULL ) )
+    return false;
+
+  const uint32_t encodedSize = mc_rle.encodedSize( rawData, numberOfBytesInRawData );
+  if( encodedSize >= numberOfBytesInRawData )
+    return false;
+
+  numberOfBytesInRawData = encodedSize;
+  options |= 0x04;
+  return true;
+#else
+  (void)rawData;
+  (void)numberOfBytesInRawData;
+  (void)options;
+  return false;
+#endif
+}
+
+
+uint8_t
+vtObjectPictureGraphic_c::runtimeRleByte( uint32_t offset )
+{
+#ifdef CONFIG_VT_CLIENT_PICTURE_GRAPHIC_RUNTIME_RLE
+  return mc_rle.encodedByte( offset );
+#else
+  (void)offset;
+  isoaglib_assert( !"runtime RLE not configured" );
+  return 0;
+#endif
+}
+
 #ifdef USE_ISO_TERMINAL_GETATTRIBUTES
 uint16_t
 vtObjectPictureGraphic_c::updateWidth(bool b_SendRequest)
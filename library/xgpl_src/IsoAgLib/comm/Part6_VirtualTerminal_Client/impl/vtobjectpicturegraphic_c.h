@@ -23,6 +23,9 @@
 #include "vtobject_c.h"
 #include "vtclient_c.h"
 #include "vtclientconnection_c.h"
+#ifdef CONFIG_VT_CLIENT_PICTURE_GRAPHIC_RUNTIME_RLE
+#  include "picturegraphicrle_c.h"
+#endif
 
 
 namespace __IsoAgLib {
@@ -57,10 +60,13 @@ public:
 
   /// The following modification functions will only take affect on updating the object pool!
   /// USE THEM WITH CARE!!!
+  /// With CONFIG_VT_CLIENT_PICTURE_GRAPHIC_RUNTIME_RLE, raw data (ab_rle=false) is uploaded
+  /// RLE encoded if that's smaller. Call them again if the data got changed in place.
   void setRawData0 (HUGE_MEM uint8_t* newValue, uint32_t aui32_size, bool ab_rle, uint16_t aui16_actWidth=0xFFFF, uint16_t aui16_actHeight=0xFFFF, uint16_t aui16_width=0xFFFF)
   { // normally it would be enough to just use saveValueP once, because the ram-struct is then created... but anyway...
     saveValueP (MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), rawData0),                sizeof(iVtObjectPictureGraphic_s), (IsoAgLib::iVtObject_c*)newValue);
     saveValue32(MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), numberOfBytesInRawData0), sizeof(iVtObjectPictureGraphic_s), aui32_size);
+    invalidateRuntimeRle();
     saveValue8 (MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), options),                 sizeof(iVtObjectPictureGraphic_s), ab_rle ? (get_vtObjectPictureGraphic_a()->options |  (1<<2))
                                                                                                                                           : (get_vtObjectPictureGraphic_a()->options & ~(1<<2)) );
     if (aui16_actWidth != 0xFFFF) saveValue16(MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), actualWidth),  sizeof(iVtObjectPictureGraphic_s), aui16_actWidth);
@@ -72,6 +78,7 @@ public:
   { // normally it would be enough to just use saveValueP once, because the ram-struct is then created... but anyway...
     saveValueP (MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), rawData1),                sizeof(iVtObjectPictureGraphic_s), (IsoAgLib::iVtObject_c*)newValue);
     saveValue32(MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), numberOfBytesInRawData1), sizeof(iVtObjectPictureGraphic_s), aui32_size);
+    invalidateRuntimeRle();
     saveValue8 (MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), options),                 sizeof(iVtObjectPictureGraphic_s), ab_rle ? (get_vtObjectPictureGraphic_a()->options |  (1<<3))
                                                                                                                                           : (get_vtObjectPictureGraphic_a()->options & ~(1<<3)) );
     if (aui16_actWidth != 0xFFFF) saveValue16(MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), actualWidth),  sizeof(iVtObjectPictureGraphic_s), aui16_actWidth);
@@ -83,6 +90,7 @@ public:
   { // normally it would be enough to just use saveValueP once, because the ram-struct is then created... but anyway...
     saveValueP (MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), rawData2),                sizeof(iVtObjectPictureGraphic_s), (IsoAgLib::iVtObject_c*)newValue);
     saveValue32(MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), numberOfBytesInRawData2), sizeof(iVtObjectPictureGraphic_s), aui32_size);
+    invalidateRuntimeRle();
     saveValue8 (MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), options),                 sizeof(iVtObjectPictureGraphic_s), ab_rle ? (get_vtObjectPictureGraphic_a()->options |  (1<<4))
                                                                                                                                           : (get_vtObjectPictureGraphic_a()->options & ~(1<<4)) );
     if (aui16_actWidth != 0xFFFF) saveValue16(MACRO_getStructOffset(get_vtObjectPictureGraphic_a(), actualWidth),  sizeof(iVtObjectPictureGraphic_s), aui16_actWidth);
@@ -106,6 +114,21 @@ public:
 
   void saveReceivedAttribute (uint8_t attrID, uint8_t* pui8_attributeValue);
 #endif
+
+private:
+  /// select the runtime RLE encoded data if smaller than the raw data
+  /// @return true if selected, the data is then read via runtimeRleByte()
+  bool selectRuntimeRle( const HUGE_MEM uint8_t* rawData, uint32_t& numberOfBytesInRawData, uint8_t& options ) const;
+  uint8_t runtimeRleByte( uint32_t offset );
+
+#ifdef CONFIG_VT_CLIENT_PICTURE_GRAPHIC_RUNTIME_RLE
+  void invalidateRuntimeRle() { mc_rle.invalidate(); }
+
+  // encoder state of the raw data that's currently uploaded
+  mutable PictureGraphicRle_c mc_rle;
+#else
+  void invalidateRuntimeRle() {}
+#endif
 };
 
 } //__IsoAgLib
@@ -0,0 +1,119 @@
+/*
+  vtobjectramarena_c.cpp: arena holding the RAM copies of the
+    attribute structs of an object pool's objects
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "vtobjectramarena_c.h"
+#include "vtobject_c.h"
+
+#include <cstring>
+
+
+namespace __IsoAgLib {
+
+
+// keep the data behind the block header aligned, too
+static const uint32_t scui32_headerSize = ( sizeof( void* ) + 2 * sizeof( uint32_t ) + 7 ) & ~uint32_t( 7 );
+
+
+VtObjectRamArena_c::VtObjectRamArena_c()
+  : mp_blocks( NULL )
+  , mp_copies( NULL )
+  , mui32_allocated( 0 )
+  , mui32_capacity( 0 )
+{
+}
+
+
+VtObjectRamArena_c::Block_s*
+VtObjectRamArena_c::newBlock( uint32_t aui32_size )
+{
+  // allocate as doubles for the alignment of the data
+  const uint32_t ui32_doubles = ( scui32_headerSize + aui32_size + sizeof( double ) - 1 ) / sizeof( double );
+  Block_s* block = reinterpret_cast<Block_s*>( new double[ ui32_doubles ] );
+  block->next = mp_blocks;
+  block->size = aui32_size;
+  block->used = 0;
+
+  mp_blocks = block;
+  mui32_capacity += aui32_size;
+  return block;
+}
+
+
+void
+VtObjectRamArena_c::prefault()
+{
+  if( mp_blocks == NULL )
+    (void)newBlock( align( CONFIG_VT_CLIENT_RAM_STRUCT_ARENA_CHUNK_SIZE ) );
+
+  uint8_t* data = reinterpret_cast<uint8_t*>( mp_blocks ) + scui32_headerSize;
+  CNAMESPACE::memset( data + mp_blocks->used, 0, mp_blocks->size - mp_blocks->used );
+}
+
+
+void*
+VtObjectRamArena_c::allocate( uint16_t aui16_size, vtObject_c& arc_owner, void* ap_romStruct )
+{
+  const uint32_t ui32_size = allocationSize( aui16_size );
+
+  Block_s* block = mp_blocks;
+  if( ( block == NULL ) || ( block->size - block->used < ui32_size ) )
+  {
+    uint32_t ui32_blockSize = align( CONFIG_VT_CLIENT_RAM_STRUCT_ARENA_CHUNK_SIZE );
+    if( ui32_blockSize < ui32_size )
+      ui32_blockSize = ui32_size;
+
+    // the rest of the old block is lost, but its structs stay where they are
+    block = newBlock( ui32_blockSize );
+  }
+
+  uint8_t* result = reinterpret_cast<uint8_t*>( block ) + scui32_headerSize + block->used;
+  block->used += ui32_size;
+  mui32_allocated += ui32_size;
+
+  Copy_s* copy = reinterpret_cast<Copy_s*>( result );
+  copy->next = mp_copies;
+  copy->owner = &arc_owner;
+  copy->romStruct = ap_romStruct;
+  mp_copies = copy;
+
+  return result + align( sizeof( Copy_s ) );
+}
+
+
+void
+VtObjectRamArena_c::clear()
+{
+  // the objects may outlive the pool (and get registered again)
+  for( Copy_s* copy = mp_copies; copy != NULL; copy = copy->next )
+    copy->owner->releaseRamStruct( reinterpret_cast<uint8_t*>( copy ) + align( sizeof( Copy_s ) ), copy->romStruct );
+  mp_copies = NULL;
+
+  while( mp_blocks != NULL )
+  {
+    Block_s* next = mp_blocks->next;
+    delete [] reinterpret_cast<double*>( mp_blocks );
+    mp_blocks = next;
+  }
+  mui32_allocated = 0;
+  mui32_capacity = 0;
+}
+
+
+} // __IsoAgLib
@@ -0,0 +1,99 @@
+/*
+  vtobjectramarena_c.h: arena holding the RAM copies of the
+    attribute structs of an object pool's objects
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef VTOBJECTRAMARENA_C_H
+#define VTOBJECTRAMARENA_C_H
+
+#include <IsoAgLib/isoaglib_config.h>
+
+
+namespace __IsoAgLib {
+
+class vtObject_c;
+
+/** Bump allocator for the RAM copies vtObject_c::createRamStructIfNotYet
+    makes of the ROM attribute structs. The copies are never freed one
+    by one, so they are packed into few blocks which are only freed
+    with the arena (i.e. with the object pool). Each copy remembers its
+    object and ROM struct, so the objects are switched back to their
+    ROM structs before the blocks are freed.
+    The blocks are allocated with CONFIG_VT_CLIENT_RAM_STRUCT_ARENA_CHUNK_SIZE
+    when needed, so the memory grows with the objects actually changed.
+  */
+class VtObjectRamArena_c
+{
+public:
+  VtObjectRamArena_c();
+  ~VtObjectRamArena_c() { clear(); }
+
+  /** allocate the first block (if not done yet) and touch its free part,
+      so neither allocation nor page faults happen on the first changes */
+  void prefault();
+
+  /** @param ap_romStruct the struct the object uses until the copy is made
+      @return aligned memory for a struct of the given size, never NULL */
+  void* allocate( uint16_t aui16_size, vtObject_c& arc_owner, void* ap_romStruct );
+
+  /// switch all objects back to their ROM structs and free all blocks
+  void clear();
+
+  uint32_t allocated() const { return mui32_allocated; }
+  uint32_t capacity() const { return mui32_capacity; }
+
+private:
+  struct Block_s
+  {
+    Block_s* next;
+    uint32_t size;
+    uint32_t used;
+  };
+
+  // placed in front of each copy
+  struct Copy_s
+  {
+    Copy_s* next;
+    vtObject_c* owner;
+    void* romStruct;
+  };
+
+  // the attribute structs contain pointers, uint32_t and float values
+  static uint32_t align( uint32_t aui32_size ) { return ( aui32_size + 7 ) & ~uint32_t( 7 ); }
+  // bytes taken from the arena for a struct of the given size
+  static uint32_t allocationSize( uint32_t aui32_structSize )
+  { return align( sizeof( Copy_s ) ) + align( aui32_structSize ); }
+
+  Block_s* newBlock( uint32_t aui32_size );
+
+  Block_s* mp_blocks; // the current block is the first in the list
+  Copy_s* mp_copies;
+  uint32_t mui32_allocated;
+  uint32_t mui32_capacity;
+
+private:
+  /** not copyable : copy constructor is only declared, never defined */
+  VtObjectRamArena_c(const VtObjectRamArena_c&);
+  /** not copyable : copy operator is only declared, never defined */
+  VtObjectRamArena_c& operator=(const VtObjectRamArena_c&);
+};
+
+
+} // __IsoAgLib
+
+#endif
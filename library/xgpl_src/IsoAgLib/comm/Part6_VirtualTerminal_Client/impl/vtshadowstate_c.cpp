@@ -0,0 +1,116 @@
+/*
+  vtshadowstate_c.cpp: values the VT acknowledged for the objects of
+    the client's pool, used to suppress redundant commands
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include "vtshadowstate_c.h"
+
+
+namespace __IsoAgLib {
+
+// limit the linear probing so that a nearly full table keeps O(1) lookups
+static const unsigned scui_maxProbes = 8;
+
+
+static unsigned
+startIndex( uint32_t aui32_key )
+{
+  return unsigned( ( aui32_key * 0x9E3779B1UL ) >> 16 ) % CONFIG_VT_CLIENT_SHADOW_STATE_SIZE;
+}
+
+
+void
+VtShadowState_c::clear()
+{
+  for( unsigned i = 0; i < CONFIG_VT_CLIENT_SHADOW_STATE_SIZE; ++i )
+  {
+    marr_entry[ i ].key = 0;
+    marr_entry[ i ].value = 0;
+    marr_entry[ i ].valid = false;
+  }
+}
+
+
+const VtShadowState_c::Entry_s*
+VtShadowState_c::find( uint32_t aui32_key ) const
+{
+  unsigned index = startIndex( aui32_key );
+  for( unsigned probe = 0; probe < scui_maxProbes; ++probe )
+  {
+    const Entry_s& entry = marr_entry[ index ];
+    if( entry.key == aui32_key )
+      return &entry;
+    if( entry.key == 0 )
+      break;
+    index = ( index + 1 ) % CONFIG_VT_CLIENT_SHADOW_STATE_SIZE;
+  }
+  return NULL;
+}
+
+
+VtShadowState_c::Entry_s*
+VtShadowState_c::findOrInsert( uint32_t aui32_key )
+{
+  unsigned index = startIndex( aui32_key );
+  for( unsigned probe = 0; probe < scui_maxProbes; ++probe )
+  {
+    Entry_s& entry = marr_entry[ index ];
+    if( entry.key == aui32_key )
+      return &entry;
+    if( entry.key == 0 )
+    {
+      entry.key = aui32_key;
+      entry.valid = false;
+      return &entry;
+    }
+    index = ( index + 1 ) % CONFIG_VT_CLIENT_SHADOW_STATE_SIZE;
+  }
+  return NULL;
+}
+
+
+bool
+VtShadowState_c::matches( uint8_t aui8_command, uint16_t aui16_objId, uint32_t aui32_value ) const
+{
+  const Entry_s* entry = find( key( aui8_command, aui16_objId ) );
+  return ( entry != NULL ) && entry->valid && ( entry->value == aui32_value );
+}
+
+
+void
+VtShadowState_c::set( uint8_t aui8_command, uint16_t aui16_objId, uint32_t aui32_value )
+{
+  Entry_s* entry = findOrInsert( key( aui8_command, aui16_objId ) );
+  if( entry )
+  {
+    entry->value = aui32_value;
+    entry->valid = true;
+  }
+}
+
+
+void
+VtShadowState_c::invalidate( uint8_t aui8_command, uint16_t aui16_objId )
+{
+  Entry_s* entry = const_cast<Entry_s*>( find( key( aui8_command, aui16_objId ) ) );
+  if( entry )
+    entry->valid = false;
+}
+
+
+} // __IsoAgLib
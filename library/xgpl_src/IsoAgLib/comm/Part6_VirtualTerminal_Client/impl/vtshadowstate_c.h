@@ -0,0 +1,68 @@
+/*
+  vtshadowstate_c.h: values the VT acknowledged for the objects of
+    the client's pool, used to suppress redundant commands
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef VTSHADOWSTATE_H
+#define VTSHADOWSTATE_H
+
+#include <IsoAgLib/isoaglib_config.h>
+
+
+namespace __IsoAgLib {
+
+/** Last value the VT acknowledged per (command, object ID), e.g. the
+    numeric value, the hide/show state or a hash of the string value.
+    Fixed size open addressing table; when it's full, further
+    objects are just not shadowed. Entries are never removed but
+    only invalidated, as the set of keys of one pool is limited.
+  */
+class VtShadowState_c
+{
+public:
+  VtShadowState_c() { clear(); }
+
+  void clear();
+
+  /// @return true if the VT is known to show the value
+  bool matches( uint8_t aui8_command, uint16_t aui16_objId, uint32_t aui32_value ) const;
+
+  void set( uint8_t aui8_command, uint16_t aui16_objId, uint32_t aui32_value );
+  void invalidate( uint8_t aui8_command, uint16_t aui16_objId );
+
+private:
+  struct Entry_s
+  {
+    uint32_t key; // 0: unused
+    uint32_t value;
+    bool valid;
+  };
+
+  static uint32_t key( uint8_t aui8_command, uint16_t aui16_objId )
+  { return ( uint32_t( aui8_command ) << 16 ) | aui16_objId; }
+
+  const Entry_s* find( uint32_t aui32_key ) const;
+  Entry_s* findOrInsert( uint32_t aui32_key );
+
+  Entry_s marr_entry[ CONFIG_VT_CLIENT_SHADOW_STATE_SIZE ];
+};
+
+
+} // __IsoAgLib
+
+#endif
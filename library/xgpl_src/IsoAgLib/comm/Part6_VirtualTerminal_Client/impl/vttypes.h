@@ -77,6 +77,24 @@ class vtObjectAuxiliaryFunction2_c;
 class vtObjectAuxiliaryInput2_c;
 class vtObjectAuxiliaryControlDesignatorObjectPointer_c;
 
+/** Scaling of an object pool to the connected VT, calculated once per
+    VT properties by VtClientConnection_c::populateScalingInformation */
+struct VtScaling_s
+{
+  int32_t opDimension;
+  int32_t vtDimension;
+  int32_t vtOffsetX;
+  int32_t vtOffsetY;
+  int32_t opSoftKeyWidth;
+  int32_t opSoftKeyHeight;
+  int32_t vtSoftKeyWidth;
+  int32_t vtSoftKeyHeight;
+  int32_t skOffsetX;
+  int32_t skOffsetY;
+  int32_t skFactorM; // soft key scaling: the smaller one of the width and height factor
+  int32_t skFactorD;
+};
+
 } // end namespace __IsoAgLib
 
 // Use the following define in your project's define-settings if you are using objects larger than 64KB
@@ -99,20 +117,21 @@ typedef uint16_t objRange_t;
     uint16_t curBytes=0;
 
 #define MACRO_scaleLocalVars \
-    int32_t opDimension = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getVtObjectPoolDimension(); \
-    int32_t vtDimension = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getHwDimension(); \
-    int32_t vtOffsetX   = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getHwOffsetX(); \
-    int32_t vtOffsetY   = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getHwOffsetY(); \
+    const __IsoAgLib::VtScaling_s& crs_scaling = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getScaling(); \
+    int32_t opDimension = crs_scaling.opDimension; \
+    int32_t vtDimension = crs_scaling.vtDimension; \
+    int32_t vtOffsetX   = crs_scaling.vtOffsetX; \
+    int32_t vtOffsetY   = crs_scaling.vtOffsetY; \
     ( void )vtOffsetX; \
     ( void )vtOffsetY;
 
 #define MACRO_getSkDimension \
-    opSoftKeyWidth  = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getVtObjectPoolSoftKeyWidth(); \
-    opSoftKeyHeight = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getVtObjectPoolSoftKeyHeight(); \
-    vtSoftKeyWidth  = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getSkWidth(); \
-    vtSoftKeyHeight = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getSkHeight(); \
-    skOffsetX       = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getSkOffsetX(); \
-    skOffsetY       = __IsoAgLib::getVtClientInstance4Comm().getClientByID (s_properties.clientId).getSkOffsetY();
+    opSoftKeyWidth  = crs_scaling.opSoftKeyWidth; \
+    opSoftKeyHeight = crs_scaling.opSoftKeyHeight; \
+    vtSoftKeyWidth  = crs_scaling.vtSoftKeyWidth; \
+    vtSoftKeyHeight = crs_scaling.vtSoftKeyHeight; \
+    skOffsetX       = crs_scaling.skOffsetX; \
+    skOffsetY       = crs_scaling.skOffsetY;
 
 #define MACRO_scaleSKLocalVars \
     int32_t opSoftKeyWidth,  opSoftKeyHeight, vtSoftKeyWidth, vtSoftKeyHeight, skOffsetX, skOffsetY; \
@@ -138,16 +157,10 @@ typedef uint16_t objRange_t;
       MACRO_getSkDimension \
       /* set defaults for button sizes to avoid compiler warning */ \
       opButtonWidth = opButtonHeight = vtButtonWidth = vtButtonHeight = 0; \
-      const int32_t ci_factorX = (vtSoftKeyWidth  << 20) / opSoftKeyWidth; \
-      const int32_t ci_factorY = (vtSoftKeyHeight << 20) / opSoftKeyHeight; \
-      if (ci_factorX < ci_factorY) { \
-        factorM = vtSoftKeyWidth; \
-        factorD = opSoftKeyWidth; \
-      } else { \
-        factorM = vtSoftKeyHeight; \
-        factorD = opSoftKeyHeight; \
-      } \
-    }
+      factorM = crs_scaling.skFactorM; \
+      factorD = crs_scaling.skFactorD; \
+    } \
+    ( void )opSoftKeyWidth;
 
 #define MACRO_scaleDimension(dim) \
  { \
@@ -75,6 +75,29 @@ public:
   unsigned getCommandQueueSize() const { return commandHandler().getQueueSize(); }
   unsigned getCommandQueueSize( unsigned priority ) const { return commandHandler().getQueueSize( priority ); }
 
+  /** suppress Change Numeric Value, Change String Value and Hide/Show Object
+      commands for values the VT already acknowledged. Off by default,
+      don't use it if macros on the VT change these values. Strings are
+      compared by a 32 bit hash, so a changed string is suppressed in the
+      rare case of a hash collision. */
+  void enableShadowStateCheck() { commandHandler().enableShadowStateCheck(); }
+  void disableShadowStateCheck() { commandHandler().disableShadowStateCheck(); }
+
+  /** time from the reception of an AUX2 Input Status message until the
+      return of iVtClientObjectPool_c::eventAuxFunction2Value(), in [ms] */
+  uint32_t getAux2InputStatusMaxLatency() const { return aux2Functions().getInputStatusMaxLatency(); }
+  uint32_t getAux2InputStatusAverageLatency() const { return aux2Functions().getInputStatusAverageLatency(); }
+  void resetAux2InputStatusLatency() { aux2Functions().resetInputStatusLatency(); }
+
+  /** collect all following commands until the matching commitCommandTransaction(),
+      e.g. while refreshing a mask in one application cycle. Only the latest value
+      of each object/attribute is queued, in the order of its first change.
+      Transactions can be nested, the outermost commit queues the commands. */
+  void beginCommandTransaction() { commandHandler().beginTransaction(); }
+  void commitCommandTransaction() { commandHandler().commitTransaction(); }
+  /** discard the collected commands (of all nested transactions) */
+  void abortCommandTransaction() { commandHandler().abortTransaction(); }
+
   //! @param versionLabel7chars == NULL: Use VersionLabel used for Uploading/Loading (must be given at init!)
   //!                                    This includes the language-code for multi-language pools!
   //!        versionLabel7chars != NULL: Use VersionLabel given. Must be 7 characters!
@@ -111,6 +134,19 @@ public:
 
   uint8_t getVersion() const { return VtClientConnection_c::getVersion(); }
 
+  /** drop the serialized pool images (see iVtClientObjectPool_c::usePoolImage()),
+      e.g. after objects got changed with b_updateObject=true.
+      The next upload will serialize the objects again. */
+  void invalidatePoolImage() { uploadPoolState().invalidatePoolImage(); }
+
+  /** get the serialized pool image for storing it and providing it via
+      iVtClientObjectPool_c::getPrecompiledPoolImage() on the next start.
+      @param languagePart false: language independent part, true: language part of the last uploaded language
+      @param size gets the size of the image
+      @param properties gets the properties the image was serialized for
+      @return image or NULL if there's none (yet) */
+  const uint8_t* getPoolImage( bool languagePart, uint32_t& size, iVtClientObjectPool_c::PoolImageProperties_s& properties );
+
 private:
   iVtClientConnection_c();
 
@@ -138,6 +174,18 @@ iVtClientConnection_c::sendNonVolatileDeleteVersion( const char* versionLabel7ch
     return commandHandler().sendNonVolatileDeleteVersion( versionLabel7chars );
 }
 
+inline const uint8_t*
+iVtClientConnection_c::getPoolImage( bool languagePart, uint32_t& size, iVtClientObjectPool_c::PoolImageProperties_s& properties )
+{
+  const __IsoAgLib::ObjectPoolImage_c& image = uploadPoolState().poolImage( languagePart );
+  if( !image.valid() )
+    return NULL;
+
+  size = image.size();
+  properties = image.properties();
+  return image.data();
+}
+
 inline void
 iVtClientConnection_c::sendCommandsToBus( bool commandsToBus )
 {
@@ -25,6 +25,8 @@
 #include <supplementary_driver/driver/datastreams/streaminput_c.h>
 #include <IsoAgLib/comm/Part5_NetworkManagement/iisoname_c.h>
 #include <IsoAgLib/comm/Part3_DataLink/impl/stream_c.h>
+#include "impl/objectpoolimage_c.h"
+#include "impl/vtobjectramarena_c.h"
 #include <utility>
 
 struct localSettings_s;
@@ -335,6 +337,7 @@ public:
     , skHeight (a_objectPoolSettings.skHeight)
     , b_initAllObjects (false)
     , numLang( 0 )
+    , m_ramStructArena()
   {
     iVtObject_c* const HUGE_MEM* const* iter = a_iVtObjects+1; // skip first entry (should be the general object pool part!)
     while (*iter++ != NULL)
@@ -392,6 +395,60 @@ public:
    */
   virtual STL_NAMESPACE::pair<uint32_t, iMultiSendStreamer_c*> getAppSpecificLangPoolData (int8_t /*ai8_languageIndex*/, uint16_t /*aui16_languageCode*/) { return STL_NAMESPACE::pair<uint32_t,iMultiSendStreamer_c*>(0, (iMultiSendStreamer_c*)NULL); }
 
+  /** Properties a serialized pool image depends on, see usePoolImage() */
+  typedef __IsoAgLib::PoolImageProperties_s PoolImageProperties_s;
+
+  /** Return true to serialize the iVtObjects once into a contiguous image
+   * per PoolImageProperties_s, which is then streamed for every (re-)upload
+   * with the same properties instead of re-serializing each object.
+   * CAUTION: Objects changed with b_updateObject=true are NOT reflected
+   *          in the image, call iVtClientConnection_c::invalidatePoolImage()
+   *          after such changes if the pool may be uploaded again.
+   */
+  virtual bool usePoolImage() const { return false; }
+
+  /** Supply an image precomputed for the given properties, e.g. one that was
+   * retrieved by iVtClientConnection_c::getPoolImage() and stored earlier.
+   * The image has to start with the 0x11 command byte and has to stay valid
+   * until the connection is destroyed. Only called if usePoolImage() is true.
+   * @param rui32_size Size of the image (including the 0x11 byte)
+   * @return Image or NULL to have it serialized at runtime.
+   */
+  virtual const uint8_t* getPrecompiledPoolImage (const PoolImageProperties_s& /*ars_properties*/, uint32_t& /*rui32_size*/) { return NULL; }
+
+  /** Return a key != 0 to share the serialized pool image with the other
+   * connections (to other VTs) whose pools return the same key: A connection
+   * uploading to a VT with the same PoolImageProperties_s (including the
+   * offsets set in populateScalingInformation) streams the image built by
+   * another one instead of serializing its own objects again.
+   * Pools with the same key have to serialize identically (e.g. the same
+   * pool registered once per VT) and have to be invalidated together.
+   * Only used if usePoolImage() is true.
+   */
+  virtual uint32_t getPoolImageShareKey() const { return 0; }
+
+  /** Return true to have the version label derived from a hash of the
+   * serialized pool (for the VT's properties, all languages), so it changes
+   * exactly when the pool content uploaded to this VT changes.
+   * The version label given at registration (may be NULL) is used as prefix,
+   * the remaining characters (up to 5 for multi-language pools, else 7) are
+   * filled with the hash. At least 3 characters should be left for the hash.
+   * Obsolete labels with the same (non-empty) prefix found on the VT get
+   * deleted after the pool was successfully loaded/uploaded.
+   */
+  virtual bool useContentHashVersionLabel() const { return false; }
+
+  /** Return true to upload only the language dependent objects which
+   * serialize differently in the new language on a language change,
+   * instead of all of them. Objects left out keep their current state on
+   * the VT (e.g. values changed with b_updateObject=false), so don't use it
+   * if macros on the VT change language dependent objects.
+   * If the VT has no version of the pool stored for its current language,
+   * but one for another language, that version gets loaded and changed
+   * to the current language this way instead of uploading the whole pool.
+   */
+  virtual bool useLanguageDeltaUpdate() const { return false; }
+
 private:
   /**
      hook functions that get called after recognizing
@@ -410,6 +467,7 @@ protected:
   uint16_t skHeight;
   bool b_initAllObjects;
   uint8_t numLang;
+  __IsoAgLib::VtObjectRamArena_c m_ramStructArena; // RAM copies of the changed objects' attribute structs, freed with the pool
 
 public:
   iVtObject_c* const HUGE_MEM* const*
@@ -424,6 +482,8 @@ public:
   uint16_t              getSkHeight()       const { return skHeight; }
   uint8_t               getNumLang()        const { return numLang; }
   bool                  multiLanguage()     const { return getNumLang() > 0; }
+  __IsoAgLib::VtObjectRamArena_c&
+                        getRamStructArena()       { return m_ramStructArena; }
 
   iVtObjectWorkingSet_c&
   getWorkingSetObject() const { return *(iVtObjectWorkingSet_c*)(**iVtObjects); }
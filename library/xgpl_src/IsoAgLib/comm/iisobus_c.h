@@ -22,6 +22,7 @@
 
 #include "impl/isobus_c.h"
 #include <IsoAgLib/driver/can/icancustomer_c.h>
+#include <IsoAgLib/driver/can/icanstatistics_c.h>
 
 
 namespace IsoAgLib {
@@ -78,6 +79,34 @@ class iIsoBus_c : private __IsoAgLib::IsoBus_c {
   }
   #endif
 
+  #if CONFIG_CAN_TX_QUEUE_SIZE > 0
+  /** limit the rate of a PGN sent via the software send queue
+      @param aui32_pgn PGN (without destination address for PDU1)
+      @param aui16_spacing minimum time between two frames [msec], 0 removes the limit
+      @return false if no more PGN limits can be set (CONFIG_CAN_TX_QUEUE_PGN_SPACINGS) */
+  bool setTxMinSpacing( uint32_t aui32_pgn, uint16_t aui16_spacing ) {
+    return IsoBus_c::setTxMinSpacing( aui32_pgn, aui16_spacing );
+  }
+
+  /** @return number of frames currently waiting in the software send queue */
+  unsigned getTxQueueSize() const { return IsoBus_c::getTxQueue().size(); }
+  /** @return maximum number of frames that were waiting at the same time */
+  unsigned getTxQueueMaxSize() const { return IsoBus_c::getTxQueue().getMaxSize(); }
+  /** @return average/maximum time [msec] a queued frame waited until passed to the HAL */
+  uint32_t getTxQueueAverageLatency() const { return IsoBus_c::getTxQueue().getAverageLatency(); }
+  uint32_t getTxQueueMaxLatency() const { return IsoBus_c::getTxQueue().getMaxLatency(); }
+  /** @return number of frames discarded because of a full queue or timeout */
+  uint32_t getTxQueueDiscardCount() const { return IsoBus_c::getTxQueue().getDiscardCount(); }
+  #endif
+
+  #ifdef USE_CAN_STATISTICS
+  /** deliver detailed statistics: frame/byte counters per PGN and SA,
+      bus load in 100ms/1s/10s windows, FIFO drops, filter misses and TX wait time */
+  iCanStatistics_c& getCanStatistics() {
+    return static_cast<iCanStatistics_c&>( IsoBus_c::getCanStatistics() );
+  }
+  #endif
+
  private:
   #if (PRT_INSTANCE_CNT == 1)
   friend iIsoBus_c& getIIsoBusInstance();
@@ -66,8 +66,17 @@ public:
   uint16_t getProcessedThroughput() const { return getCanInstance4Comm().getProcessedThroughput(); }
   #endif
 
+  #ifdef USE_CAN_STATISTICS
+  CanStatistics_c& getCanStatistics() { return getCanInstance4Comm().getStatistics(); }
+  #endif
+
   int sendCanFreecnt() { return getCanInstance4Comm().sendCanFreecnt(); }
 
+  #if CONFIG_CAN_TX_QUEUE_SIZE > 0
+  bool setTxMinSpacing( uint32_t aui32_pgn, uint16_t aui16_spacing ) { return getCanInstance4Comm().setTxMinSpacing( aui32_pgn, aui16_spacing ); }
+  const CanTxQueue_c& getTxQueue() const { return getCanInstance4Comm().getTxQueue(); }
+  #endif
+
   // @todo to be changed to return the FilterBox instead of a boolean.
   bool existFilter(const __IsoAgLib::CanCustomer_c& ar_customer, const IsoAgLib::iMaskFilter_c& arc_maskFilter ) {
     return getCanInstance4Comm().existFilter (ar_customer, IsoAgLib::iMaskFilterType_c( arc_maskFilter, IsoAgLib::iIdent_c::ExtendedIdent ), NULL);
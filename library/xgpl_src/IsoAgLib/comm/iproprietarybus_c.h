@@ -25,6 +25,7 @@
 #include <IsoAgLib/driver/can/icancustomer_c.h>
 #include <IsoAgLib/driver/can/icanpkg_c.h>
 #include <IsoAgLib/driver/can/imaskfilter_c.h>
+#include <IsoAgLib/driver/can/icanstatistics_c.h>
 #include <IsoAgLib/util/impl/singleton.h>
 
 #if 0 < PROP_INSTANCE_CNT
@@ -137,6 +138,14 @@ class iProprietaryBus_c {
   }
 #endif
 
+#ifdef USE_CAN_STATISTICS
+  /** deliver detailed statistics: frame/byte counters per PGN and SA,
+      bus load in 100ms/1s/10s windows, FIFO drops, filter misses and TX wait time */
+  iCanStatistics_c& getCanStatistics() {
+    return static_cast<iCanStatistics_c&>( __IsoAgLib::getCanInstance4Prop().getStatistics() );
+  }
+#endif
+
  private:
   /** allow getIproprietaryBusInstance() access to shielded base class.
       otherwise __IsoAgLib::getProprietaryBusInstance() wouldn't be accepted by compiler
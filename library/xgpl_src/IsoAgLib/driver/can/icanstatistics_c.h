@@ -0,0 +1,82 @@
+/*
+  icanstatistics_c.h: interface for the detailed per-PGN / per-SA
+    statistics of the traffic of one CAN instance
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef ICAN_STATISTICS_H
+#define ICAN_STATISTICS_H
+
+#include "impl/canstatistics_c.h"
+
+#ifdef USE_CAN_STATISTICS
+
+// Begin Namespace IsoAgLib
+namespace IsoAgLib {
+
+/** Read access to the statistics of one CAN instance.
+    Get it via iIsoBus_c::getCanStatistics() or iProprietaryBus_c::getCanStatistics().
+    @see __IsoAgLib::CanStatistics_c
+  */
+class iCanStatistics_c : private __IsoAgLib::CanStatistics_c {
+public:
+  typedef __IsoAgLib::CanStatistics_c::Counter_s Counter_s;
+  typedef __IsoAgLib::CanStatistics_c::Traffic_s Traffic_s;
+  typedef __IsoAgLib::CanStatistics_c::PgnEntry_s PgnEntry_s;
+  typedef __IsoAgLib::CanStatistics_c::Window_en Window_en;
+
+  static const unsigned scui_pgnSlots = __IsoAgLib::CanStatistics_c::scui_pgnSlots;
+  static const uint32_t scui32_unusedPgn = __IsoAgLib::CanStatistics_c::scui32_unusedPgn;
+
+  void reset() { CanStatistics_c::reset(); }
+
+  const Traffic_s& getTotal() const { return CanStatistics_c::getTotal(); }
+  const Traffic_s& getTrafficForSa( uint8_t aui8_sa ) const { return CanStatistics_c::getTrafficForSa( aui8_sa ); }
+  const Traffic_s* getTrafficForPgn( uint32_t aui32_pgn ) const { return CanStatistics_c::getTrafficForPgn( aui32_pgn ); }
+  const PgnEntry_s& getPgnEntry( unsigned aui_index ) const { return CanStatistics_c::getPgnEntry( aui_index ); }
+  uint32_t getPgnTableOverflows() const { return CanStatistics_c::getPgnTableOverflows(); }
+
+  /** @return bus load in bits per second for the window
+              Window100ms, Window1s or Window10s */
+  uint32_t getBusLoad( Window_en ae_window ) const { return CanStatistics_c::getBusLoad( ae_window ); }
+
+  uint32_t getFifoDrops() const { return CanStatistics_c::getFifoDrops(); }
+  uint32_t getFilterMisses() const { return CanStatistics_c::getFilterMisses(); }
+
+  uint32_t getTxWaitCount() const { return CanStatistics_c::getTxWaitCount(); }
+  uint32_t getTxWaitAverage() const { return CanStatistics_c::getTxWaitAverage(); }
+  uint32_t getTxWaitMax() const { return CanStatistics_c::getTxWaitMax(); }
+
+  unsigned getSnapshotSize() const { return CanStatistics_c::getSnapshotSize(); }
+  unsigned writeSnapshot( uint8_t* apui8_buffer, unsigned aui_bufferSize ) const
+  { return CanStatistics_c::writeSnapshot( apui8_buffer, aui_bufferSize ); }
+
+  static const Window_en Window100ms = __IsoAgLib::CanStatistics_c::Window100ms;
+  static const Window_en Window1s = __IsoAgLib::CanStatistics_c::Window1s;
+  static const Window_en Window10s = __IsoAgLib::CanStatistics_c::Window10s;
+
+private:
+  iCanStatistics_c();
+
+  friend class iIsoBus_c;
+  friend class iProprietaryBus_c;
+};
+
+} // namespace IsoAgLib
+
+#endif
+#endif
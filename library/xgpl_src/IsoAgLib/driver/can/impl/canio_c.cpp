@@ -48,6 +48,12 @@ namespace __IsoAgLib {
       mc_maskStd( 0, Ident_c::StandardIdent ),
       mc_maskExt( 0, Ident_c::ExtendedIdent ),
       mui8_busNumber( 0xFF )
+#ifdef USE_CAN_STATISTICS
+      ,mc_statistics()
+#endif
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+      ,mc_txQueue()
+#endif
   {}
 
 
@@ -61,6 +67,10 @@ namespace __IsoAgLib {
     const bool r = HAL::canInit( mui8_busNumber, mui_bitrate );
     isoaglib_assert( r );
 
+#ifdef USE_CAN_STATISTICS
+    mc_statistics.reset();
+#endif
+
     if( r ) {
       setInitialized();
     }
@@ -78,6 +88,10 @@ namespace __IsoAgLib {
 
     m_arrFilterBox.clear();
 
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+    mc_txQueue.clear();
+#endif
+
     setClosed();
   }
 
@@ -228,6 +242,10 @@ namespace __IsoAgLib {
 
         CanPkg_c& pkg = HAL::CanFifos_c::get( mui8_busNumber).front();
 
+#ifdef USE_CAN_STATISTICS
+        mc_statistics.updateRx( pkg );
+#endif
+
         CanIo_c::ArrFilterBox::iterator pc_iFilterBox;
         if( canMsg2FilterBox( pkg.ident(), pkg.identType(), pc_iFilterBox ) ) {
 #ifndef NO_FILTERBOX_LIST_ORDER_SWAP
@@ -244,9 +262,18 @@ namespace __IsoAgLib {
 #endif
           (*pc_iFilterBox)->processMsg( pkg );
         }
+#ifdef USE_CAN_STATISTICS
+        else {
+          mc_statistics.updateFilterMiss();
+        }
+#endif
 
         HAL::CanFifos_c::get( mui8_busNumber).pop();
       }
+
+#ifdef USE_CAN_STATISTICS
+      mc_statistics.updateFifoDrops( HAL::CanFifos_c::get( mui8_busNumber ).getDropCount() );
+#endif
     }
   }
 
@@ -256,6 +283,34 @@ namespace __IsoAgLib {
 
     isoaglib_assert ( initialized() );
 
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+    const ecutime_t now = System_c::getTime();
+
+    /* bypass the queue only if nothing is waiting, so that the
+     * priority and FIFO order of the queued frames is kept */
+    if( mc_txQueue.empty()
+        && mc_txQueue.isSendAllowed( acrc_src, now )
+        && ( HAL::canTxQueueFree( mui8_busNumber ) != 0 ) ) {
+      if( canTxSend( acrc_src ) ) {
+#ifdef USE_CAN_STATISTICS
+        mc_statistics.updateTxWait( 0 );
+#endif
+        mc_txQueue.notifySent( acrc_src, now );
+      } else if( ! mc_txQueue.push( acrc_src, now ) ) {
+        // the HAL's queue fill level may be unknown (-1), so queue it for a retry
+        IsoAgLib::getILibErrInstance().registerNonFatal( IsoAgLib::iLibErr_c::HalCanBusOverflow, getMultitonInst() );
+      }
+    } else {
+      if( ! mc_txQueue.push( acrc_src, now ) )
+        IsoAgLib::getILibErrInstance().registerNonFatal( IsoAgLib::iLibErr_c::HalCanBusOverflow, getMultitonInst() );
+
+      ( void )processTxQueue();
+    }
+#else
+#if defined( USE_CAN_STATISTICS ) || ( CONFIG_CAN_BLOCK_TIME > 0 )
+    const ecutime_t now = System_c::getTime();
+#endif
+
 #if CONFIG_CAN_BLOCK_TIME > 0
     int fc = sendCanFreecnt();
 
@@ -263,7 +318,6 @@ namespace __IsoAgLib {
      *  a send queue and no information about the possible about of frames 
      *  is available - so we just try to send and check the result */
     if( -1 != fc ) {
-      const ecutime_t now = System_c::getTime();
       while( fc < 1 ) {
         HAL::sleep_max_ms( 1 );
         /** we wait for CONFIG_CAN_BLOCK_TIME ms if the send-queue is opening for this one package.
@@ -279,32 +333,95 @@ namespace __IsoAgLib {
     }
 #endif
 
-    if( ! HAL::canTxSend( mui8_busNumber, acrc_src ) ) {
+#ifdef USE_CAN_STATISTICS
+    mc_statistics.updateTxWait( int32_t( System_c::getTime() - now ) );
+#endif
 
-      IsoAgLib::iLibErr_c::TypeNonFatal_en nonFatalError = IsoAgLib::iLibErr_c::HalCanBusOverflow;;
+    ( void )canTxSend( acrc_src );
+#endif
 
-      HAL::canState_t state;
-      if( HAL::canState(mui8_busNumber, state) ) // If I'm able to retrieve the canState, then report that
-      {
-        switch( state )
-        {
-        case HAL::e_canBusOff:
-          nonFatalError = IsoAgLib::iLibErr_c::HalCanBusOff;
-          break;
+    return *this;
+  }
 
-        case HAL::e_canBusWarn:
-          nonFatalError = IsoAgLib::iLibErr_c::HalCanBusWarn;
-          break;
 
-        case HAL::e_canNoError: // nothing special, bus okay, so just got overflown
-          ;
-        }
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+  int32_t
+  CanIo_c::processTxQueue() {
+
+    if( ! initialized() )
+      return -1;
+
+    const ecutime_t now = System_c::getTime();
+    int fc = HAL::canTxQueueFree( mui8_busNumber );
+
+    while( ( fc != 0 ) && ! mc_txQueue.empty() ) {
+      int prev;
+      const int slot = mc_txQueue.next( now, prev );
+      if( slot == CanTxQueue_c::sci_noSlot )
+        break; // only frames held back by PGN spacing left
+
+      const int32_t age = int32_t( now - mc_txQueue.enqueueTime( slot ) );
+      if( age > CONFIG_CAN_TX_QUEUE_MAX_AGE ) {
+        // most likely bus-off/passive: don't send outdated data later on
+        mc_txQueue.remove( slot, prev, now, false );
+        IsoAgLib::getILibErrInstance().registerNonFatal( IsoAgLib::iLibErr_c::HalCanBusOverflow, getMultitonInst() );
+        continue;
       }
 
-      IsoAgLib::getILibErrInstance().registerNonFatal(nonFatalError, getMultitonInst());
+      if( ! canTxSend( mc_txQueue.frame( slot ) ) )
+        break; // keep the frame queued and retry on the next call
+#ifdef USE_CAN_STATISTICS
+      mc_statistics.updateTxWait( age );
+#endif
+      mc_txQueue.remove( slot, prev, now, true );
+
+      if( fc > 0 )
+        --fc;
     }
 
-    return *this;
+    return mc_txQueue.getTimeToNextSend( now );
+  }
+
+
+  bool
+  CanIo_c::setTxMinSpacing( uint32_t aui32_pgn, uint16_t aui16_spacing ) {
+    return mc_txQueue.setMinSpacing( aui32_pgn, aui16_spacing );
+  }
+#endif
+
+
+  bool
+  CanIo_c::canTxSend( const CanPkg_c& acrc_src ) {
+
+    if( HAL::canTxSend( mui8_busNumber, acrc_src ) ) {
+#ifdef USE_CAN_STATISTICS
+      mc_statistics.updateTx( acrc_src );
+#endif
+      return true;
+    }
+
+    IsoAgLib::iLibErr_c::TypeNonFatal_en nonFatalError = IsoAgLib::iLibErr_c::HalCanBusOverflow;;
+
+    HAL::canState_t state;
+    if( HAL::canState(mui8_busNumber, state) ) // If I'm able to retrieve the canState, then report that
+    {
+      switch( state )
+      {
+      case HAL::e_canBusOff:
+        nonFatalError = IsoAgLib::iLibErr_c::HalCanBusOff;
+        break;
+
+      case HAL::e_canBusWarn:
+        nonFatalError = IsoAgLib::iLibErr_c::HalCanBusWarn;
+        break;
+
+      case HAL::e_canNoError: // nothing special, bus okay, so just got overflown
+        ;
+      }
+    }
+
+    IsoAgLib::getILibErrInstance().registerNonFatal(nonFatalError, getMultitonInst());
+    return false;
   }
 
 
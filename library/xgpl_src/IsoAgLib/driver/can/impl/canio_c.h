@@ -29,6 +29,8 @@
 #include <IsoAgLib/hal/hal_system.h>
 #include "ident_c.h"
 #include "filterbox_c.h"
+#include "canstatistics_c.h"
+#include "cantxqueue_c.h"
 
 #include <list>
 
@@ -58,6 +60,13 @@ namespace __IsoAgLib {
       uint32_t getProcessedThroughput() const;
 #endif
 
+#ifdef USE_CAN_STATISTICS
+      /** deliver detailed statistics (per PGN, per SA, bus load windows, drops) */
+      CanStatistics_c& getStatistics() {
+        return mc_statistics;
+      }
+#endif
+
       /** wait until specified timeout or until next CAN message receive
        *  @return true -> there are CAN messages waiting for process. else: return due to timeout
        */
@@ -66,11 +75,30 @@ namespace __IsoAgLib {
       }
 
       /** deliver the numbers which can be placed at the moment in the send buffer
+        (the software send queue if configured by CONFIG_CAN_TX_QUEUE_SIZE)
         @return number of msgs which fit into send buffer
       */
       int sendCanFreecnt() {
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+        return int( mc_txQueue.freeCount() );
+#else
         return HAL::canTxQueueFree( mui8_busNumber );
+#endif
+      }
+
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+      /** pass as many queued frames to the HAL as it can take
+        @return time [msec] until the queue needs to be processed again, -1 if it is empty */
+      int32_t processTxQueue();
+
+      /** set the minimum time between two sent frames of a PGN, 0 to remove the limit
+        @return false if no more PGN limits can be set (CONFIG_CAN_TX_QUEUE_PGN_SPACINGS) */
+      bool setTxMinSpacing( uint32_t aui32_pgn, uint16_t aui16_spacing );
+
+      const CanTxQueue_c& getTxQueue() const {
+        return mc_txQueue;
       }
+#endif
 
       /** test if a FilterBox_c definition already exist
         (version expecial for extended ident, chosen at compile time)
@@ -109,7 +137,9 @@ namespace __IsoAgLib {
       */
       void processMsg( bool& br_break );
 
-      /** function for sending data out of CanPkg_c */
+      /** function for sending data out of CanPkg_c.
+        With CONFIG_CAN_TX_QUEUE_SIZE > 0 this never blocks: frames that
+        can't be passed to the HAL right away are queued by priority. */
       CanIo_c& operator<<( CanPkg_c& acrc_src );
 
       /** return time stamp of the last can package that has been received and processed successfully */
@@ -132,6 +162,9 @@ namespace __IsoAgLib {
         */
       FilterBox_c* getFilterBox( const IsoAgLib::iMaskFilterType_c& arc_maskFilter ) const;
 
+      /** pass frame to the HAL and register an error if this fails */
+      bool canTxSend( const CanPkg_c& acrc_src );
+
       /** Vector of configured filter boxes */
       ArrFilterBox m_arrFilterBox;
 
@@ -151,6 +184,14 @@ namespace __IsoAgLib {
 
       uint8_t mui8_busNumber;
 
+#ifdef USE_CAN_STATISTICS
+      CanStatistics_c mc_statistics;
+#endif
+
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+      CanTxQueue_c mc_txQueue;
+#endif
+
       /** flag to avoid loop of CAN message processing, when timeEvent() is called during previous
        *  timeEvent triggered CAN processing -> when this flag is true, no further processing is performed
        */
@@ -0,0 +1,282 @@
+/*
+  canstatistics_c.cpp: detailed per-PGN / per-SA statistics of the
+    traffic handled by one CanIo_c instance
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+
+#include "canstatistics_c.h"
+
+#ifdef USE_CAN_STATISTICS
+
+#include <IsoAgLib/driver/can/impl/canpkg_c.h>
+#include <IsoAgLib/driver/system/impl/system_c.h>
+#include <IsoAgLib/util/impl/util_funcs.h>
+
+#include <cstring>
+
+namespace __IsoAgLib {
+
+  // limit the linear probing so that a nearly full table keeps O(1) updates
+  static const unsigned scui_maxPgnProbes = 8;
+
+  static const unsigned scui_snapshotHeaderSize = 2 + 1 + 4 + 16 + 12 + 12 + 12 + 2 + 2;
+  static const unsigned scui_snapshotSaEntrySize = 1 + 16;
+  static const unsigned scui_snapshotPgnEntrySize = 3 + 16;
+
+
+  CanStatistics_c::CanStatistics_c() {
+    reset();
+  }
+
+
+  void
+  CanStatistics_c::reset() {
+    CNAMESPACE::memset( &mc_total, 0, sizeof( mc_total ) );
+    CNAMESPACE::memset( marr_sa, 0, sizeof( marr_sa ) );
+    for( unsigned i = 0; i < scui_pgnSlots; ++i ) {
+      marr_pgn[ i ].pgn = scui32_unusedPgn;
+      CNAMESPACE::memset( &marr_pgn[ i ].traffic, 0, sizeof( Traffic_s ) );
+    }
+    mui32_pgnTableOverflows = 0;
+
+    CNAMESPACE::memset( marr_sliceBits, 0, sizeof( marr_sliceBits ) );
+    mi32_currentSlice = int32_t( System_c::getTime() / sci32_sliceTime );
+
+    mui32_fifoDrops = 0;
+    mui32_filterMisses = 0;
+
+    mui32_txWaitCount = 0;
+    mui32_txWaitSum = 0;
+    mui32_txWaitMax = 0;
+  }
+
+
+  void
+  CanStatistics_c::add( Counter_s& ar_counter, const CanPkg_c& pkg ) {
+    ++ar_counter.frames;
+    ar_counter.bytes += pkg.getLen();
+  }
+
+
+  void
+  CanStatistics_c::updateRx( const CanPkg_c& pkg ) {
+    add( mc_total.rx, pkg );
+    updateBusLoad( pkg );
+
+    if( pkg.identType() != Ident_c::ExtendedIdent )
+      return;
+
+    add( marr_sa[ pkg.ident() & 0xFF ].rx, pkg );
+
+    PgnEntry_s* entry = findOrInsertPgn( pkg.ident() );
+    if( entry )
+      add( entry->traffic.rx, pkg );
+  }
+
+
+  void
+  CanStatistics_c::updateTx( const CanPkg_c& pkg ) {
+    add( mc_total.tx, pkg );
+    updateBusLoad( pkg );
+
+    if( pkg.identType() != Ident_c::ExtendedIdent )
+      return;
+
+    add( marr_sa[ pkg.ident() & 0xFF ].tx, pkg );
+
+    PgnEntry_s* entry = findOrInsertPgn( pkg.ident() );
+    if( entry )
+      add( entry->traffic.tx, pkg );
+  }
+
+
+  void
+  CanStatistics_c::updateTxWait( int32_t ai32_waitTime ) {
+    if( ai32_waitTime < 0 )
+      ai32_waitTime = 0;
+
+    ++mui32_txWaitCount;
+    mui32_txWaitSum += uint32_t( ai32_waitTime );
+    if( uint32_t( ai32_waitTime ) > mui32_txWaitMax )
+      mui32_txWaitMax = uint32_t( ai32_waitTime );
+  }
+
+
+  void
+  CanStatistics_c::updateBusLoad( const CanPkg_c& pkg ) {
+    const int32_t slice = int32_t( System_c::getTime() / sci32_sliceTime );
+
+    if( slice != mi32_currentSlice ) {
+      // clear all slices we skipped - at most once around the ring
+      int32_t gap = slice - mi32_currentSlice;
+      if( ( gap < 0 ) || ( gap > sci32_numSlices ) )
+        gap = sci32_numSlices;
+      for( int32_t i = 1; i <= gap; ++i )
+        marr_sliceBits[ ( slice - gap + i ) % sci32_numSlices ] = 0;
+      mi32_currentSlice = slice;
+    }
+
+    // same estimation of the frame overhead as in the HAL bus load measurement
+    const uint32_t bytes = pkg.getLen() + ( ( pkg.identType() == Ident_c::ExtendedIdent ) ? 4 : 2 );
+    marr_sliceBits[ slice % sci32_numSlices ] += bytes * 8;
+  }
+
+
+  uint32_t
+  CanStatistics_c::getBusLoad( Window_en ae_window ) const {
+    int32_t numSlices = 1;
+    switch( ae_window ) {
+      case Window100ms: numSlices = 1; break;
+      case Window1s:    numSlices = 10; break;
+      case Window10s:   numSlices = 100; break;
+    }
+
+    const int32_t now = int32_t( System_c::getTime() / sci32_sliceTime );
+    uint32_t bits = 0;
+    for( int32_t slice = now - numSlices; slice < now; ++slice ) {
+      // slices not yet written since the last update are idle
+      if( ( slice >= 0 ) && ( slice <= mi32_currentSlice ) && ( slice > ( mi32_currentSlice - sci32_numSlices ) ) )
+        bits += marr_sliceBits[ slice % sci32_numSlices ];
+    }
+
+    return uint32_t( ( uint64_t( bits ) * 1000 ) / uint64_t( numSlices * sci32_sliceTime ) );
+  }
+
+
+  CanStatistics_c::PgnEntry_s*
+  CanStatistics_c::findOrInsertPgn( uint32_t aui32_ident ) {
+    uint32_t pgn = ( aui32_ident >> 8 ) & 0x3FFFF;
+    if( ( ( pgn >> 8 ) & 0xFF ) < 0xF0 )
+      pgn &= 0x3FF00; // PDU1: strip destination address
+
+    unsigned index = unsigned( pgn ^ ( pgn >> 8 ) ) % scui_pgnSlots;
+    for( unsigned probe = 0; probe < scui_maxPgnProbes; ++probe ) {
+      PgnEntry_s& entry = marr_pgn[ index ];
+      if( entry.pgn == pgn )
+        return &entry;
+      if( entry.pgn == scui32_unusedPgn ) {
+        entry.pgn = pgn;
+        return &entry;
+      }
+      index = ( index + 1 ) % scui_pgnSlots;
+    }
+
+    ++mui32_pgnTableOverflows;
+    return NULL;
+  }
+
+
+  const CanStatistics_c::Traffic_s*
+  CanStatistics_c::getTrafficForPgn( uint32_t aui32_pgn ) const {
+    unsigned index = unsigned( aui32_pgn ^ ( aui32_pgn >> 8 ) ) % scui_pgnSlots;
+    for( unsigned probe = 0; probe < scui_maxPgnProbes; ++probe ) {
+      const PgnEntry_s& entry = marr_pgn[ index ];
+      if( entry.pgn == aui32_pgn )
+        return &entry.traffic;
+      if( entry.pgn == scui32_unusedPgn )
+        break;
+      index = ( index + 1 ) % scui_pgnSlots;
+    }
+    return NULL;
+  }
+
+
+  static bool hasTraffic( const CanStatistics_c::Traffic_s& arc_traffic ) {
+    return ( arc_traffic.rx.frames > 0 ) || ( arc_traffic.tx.frames > 0 );
+  }
+
+
+  static uint8_t* writeTraffic( uint8_t* pui8_target, const CanStatistics_c::Traffic_s& arc_traffic ) {
+    number2LittleEndianString( arc_traffic.rx.frames, pui8_target ); pui8_target += 4;
+    number2LittleEndianString( arc_traffic.rx.bytes, pui8_target ); pui8_target += 4;
+    number2LittleEndianString( arc_traffic.tx.frames, pui8_target ); pui8_target += 4;
+    number2LittleEndianString( arc_traffic.tx.bytes, pui8_target ); pui8_target += 4;
+    return pui8_target;
+  }
+
+
+  unsigned
+  CanStatistics_c::getSnapshotSize() const {
+    unsigned size = scui_snapshotHeaderSize;
+    for( unsigned i = 0; i < 256; ++i ) {
+      if( hasTraffic( marr_sa[ i ] ) )
+        size += scui_snapshotSaEntrySize;
+    }
+    for( unsigned i = 0; i < scui_pgnSlots; ++i ) {
+      if( marr_pgn[ i ].pgn != scui32_unusedPgn )
+        size += scui_snapshotPgnEntrySize;
+    }
+    return size;
+  }
+
+
+  unsigned
+  CanStatistics_c::writeSnapshot( uint8_t* apui8_buffer, unsigned aui_bufferSize ) const {
+    const unsigned size = getSnapshotSize();
+    if( size > aui_bufferSize )
+      return 0;
+
+    uint8_t* p = apui8_buffer;
+    *p++ = 'C';
+    *p++ = 'S';
+    *p++ = 1; // version
+    number2LittleEndianString( uint32_t( System_c::getTime() ), p ); p += 4;
+    p = writeTraffic( p, mc_total );
+    number2LittleEndianString( getBusLoad( Window100ms ), p ); p += 4;
+    number2LittleEndianString( getBusLoad( Window1s ), p ); p += 4;
+    number2LittleEndianString( getBusLoad( Window10s ), p ); p += 4;
+    number2LittleEndianString( mui32_fifoDrops, p ); p += 4;
+    number2LittleEndianString( mui32_filterMisses, p ); p += 4;
+    number2LittleEndianString( mui32_pgnTableOverflows, p ); p += 4;
+    number2LittleEndianString( mui32_txWaitCount, p ); p += 4;
+    number2LittleEndianString( getTxWaitAverage(), p ); p += 4;
+    number2LittleEndianString( mui32_txWaitMax, p ); p += 4;
+
+    uint8_t* pui8_count = p;
+    p += 2;
+    uint16_t count = 0;
+    for( unsigned i = 0; i < 256; ++i ) {
+      if( hasTraffic( marr_sa[ i ] ) ) {
+        *p++ = uint8_t( i );
+        p = writeTraffic( p, marr_sa[ i ] );
+        ++count;
+      }
+    }
+    number2LittleEndianString( count, pui8_count );
+
+    pui8_count = p;
+    p += 2;
+    count = 0;
+    for( unsigned i = 0; i < scui_pgnSlots; ++i ) {
+      if( marr_pgn[ i ].pgn != scui32_unusedPgn ) {
+        *p++ = uint8_t( marr_pgn[ i ].pgn );
+        *p++ = uint8_t( marr_pgn[ i ].pgn >> 8 );
+        *p++ = uint8_t( marr_pgn[ i ].pgn >> 16 );
+        p = writeTraffic( p, marr_pgn[ i ].traffic );
+        ++count;
+      }
+    }
+    number2LittleEndianString( count, pui8_count );
+
+    isoaglib_assert( unsigned( p - apui8_buffer ) == size );
+    return size;
+  }
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+  canstatistics_c.h: detailed per-PGN / per-SA statistics of the
+    traffic handled by one CanIo_c instance
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef CAN_STATISTICS_H
+#define CAN_STATISTICS_H
+
+#include <IsoAgLib/isoaglib_config.h>
+
+#ifdef USE_CAN_STATISTICS
+
+namespace __IsoAgLib {
+
+  class CanPkg_c;
+
+  /** Statistics of the traffic of one CAN instance.
+      All counters live in fixed-size tables, so that updating them
+      from CanIo_c::processMsg() and CanIo_c::operator<<() is O(1)
+      and does not allocate any memory.
+      Frames with standard (11bit) identifiers are only counted in
+      the totals and bus load, as they do not carry PGN and SA.
+    */
+  class CanStatistics_c {
+    public:
+      struct Counter_s {
+        uint32_t frames;
+        uint32_t bytes;
+      };
+
+      struct Traffic_s {
+        Counter_s rx;
+        Counter_s tx;
+      };
+
+      struct PgnEntry_s {
+        uint32_t pgn; // scui32_unusedPgn for free slot
+        Traffic_s traffic;
+      };
+
+      enum Window_en {
+        Window100ms,
+        Window1s,
+        Window10s
+      };
+
+      static const uint32_t scui32_unusedPgn = 0xFFFFFFFFUL;
+      static const unsigned scui_pgnSlots = CONFIG_CAN_STATISTICS_PGN_SLOTS;
+
+      CanStatistics_c();
+
+      /** reset all counters to zero */
+      void reset();
+
+      void updateRx( const CanPkg_c& pkg );
+      void updateTx( const CanPkg_c& pkg );
+      void updateFilterMiss() { ++mui32_filterMisses; }
+      void updateFifoDrops( uint32_t aui32_totalDrops ) { mui32_fifoDrops = aui32_totalDrops; }
+      void updateTxWait( int32_t ai32_waitTime );
+
+      /** @return sum of all received/sent frames and bytes */
+      const Traffic_s& getTotal() const { return mc_total; }
+
+      /** @return traffic from (rx) or with (tx) given source address */
+      const Traffic_s& getTrafficForSa( uint8_t aui8_sa ) const { return marr_sa[ aui8_sa ]; }
+
+      /** @return traffic for given PGN or NULL if the PGN was not seen (or did not fit into the table) */
+      const Traffic_s* getTrafficForPgn( uint32_t aui32_pgn ) const;
+
+      /** access to the raw PGN table for iteration.
+          unused entries have pgn == scui32_unusedPgn
+          @param aui_index [0..scui_pgnSlots-1] */
+      const PgnEntry_s& getPgnEntry( unsigned aui_index ) const { return marr_pgn[ aui_index ]; }
+
+      /** @return number of frames with a PGN that didn't fit into the PGN table */
+      uint32_t getPgnTableOverflows() const { return mui32_pgnTableOverflows; }
+
+      /** @return bus load in bits per second, averaged over the given
+                  window of completed 100ms slices */
+      uint32_t getBusLoad( Window_en ae_window ) const;
+
+      uint32_t getFifoDrops() const { return mui32_fifoDrops; }
+      uint32_t getFilterMisses() const { return mui32_filterMisses; }
+
+      uint32_t getTxWaitCount() const { return mui32_txWaitCount; }
+      /** @return average time a frame waited for being passed to the HAL [msec] */
+      uint32_t getTxWaitAverage() const { return ( mui32_txWaitCount > 0 ) ? ( mui32_txWaitSum / mui32_txWaitCount ) : 0; }
+      uint32_t getTxWaitMax() const { return mui32_txWaitMax; }
+
+      /** @return size of the binary snapshot in bytes as it would be written now */
+      unsigned getSnapshotSize() const;
+
+      /** write a compact binary (little endian) snapshot of all statistics for post-mortem analysis.
+          Layout (version 1):
+            "CS" | version(1) | time(4) | total rx/tx frames/bytes (4*4) | busload 100ms/1s/10s (3*4)
+            | fifo drops(4) | filter misses(4) | pgn table overflows(4) | tx wait count/avg/max (3*4)
+            | number of SAs(2) | { sa(1) | rx/tx frames/bytes (4*4) }
+            | number of PGNs(2) | { pgn(3) | rx/tx frames/bytes (4*4) }
+          Only SAs/PGNs with traffic are written.
+          @return number of bytes written, 0 if the buffer is too small */
+      unsigned writeSnapshot( uint8_t* apui8_buffer, unsigned aui_bufferSize ) const;
+
+    private:
+      static const int32_t sci32_sliceTime = 100;
+      static const int32_t sci32_numSlices = 101; // 10 seconds history plus the current slice
+
+      void updateBusLoad( const CanPkg_c& pkg );
+      PgnEntry_s* findOrInsertPgn( uint32_t aui32_ident );
+
+      static void add( Counter_s& ar_counter, const CanPkg_c& pkg );
+
+      Traffic_s mc_total;
+      Traffic_s marr_sa[ 256 ];
+      PgnEntry_s marr_pgn[ scui_pgnSlots ];
+      uint32_t mui32_pgnTableOverflows;
+
+      uint32_t marr_sliceBits[ sci32_numSlices ];
+      int32_t mi32_currentSlice;
+
+      uint32_t mui32_fifoDrops;
+      uint32_t mui32_filterMisses;
+
+      uint32_t mui32_txWaitCount;
+      uint32_t mui32_txWaitSum;
+      uint32_t mui32_txWaitMax;
+  };
+
+}
+
+#endif
+#endif
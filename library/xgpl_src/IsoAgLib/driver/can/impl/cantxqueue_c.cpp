@@ -0,0 +1,272 @@
+/*
+  cantxqueue_c.cpp: priority ordered, rate limited software send
+    queue of CanIo_c
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+
+#include "cantxqueue_c.h"
+
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+
+#include <IsoAgLib/util/iassert.h>
+
+namespace __IsoAgLib {
+
+  static const uint32_t scui32_noPgn = 0xFFFFFFFFUL;
+
+
+  CanTxQueue_c::CanTxQueue_c()
+    : mui_numSpacings( 0 )
+    , mui_maxSize( 0 )
+    , mui32_sentCount( 0 )
+    , mui32_discardCount( 0 )
+    , mui32_maxLatency( 0 )
+    , mui32_latencySum( 0 )
+  {
+    clear();
+  }
+
+
+  void
+  CanTxQueue_c::clear() {
+    for( int i = 0; i < sci_numPriorities; ++i ) {
+      marr_head[ i ] = sci_noSlot;
+      marr_tail[ i ] = sci_noSlot;
+    }
+    for( int i = 0; i < CONFIG_CAN_TX_QUEUE_SIZE; ++i ) {
+      marr_next[ i ] = i + 1;
+    }
+    marr_next[ CONFIG_CAN_TX_QUEUE_SIZE - 1 ] = sci_noSlot;
+    mi_free = 0;
+    mui_size = 0;
+  }
+
+
+  uint8_t
+  CanTxQueue_c::priority( const CanPkg_c& pkg ) {
+    if( pkg.identType() == Ident_c::ExtendedIdent )
+      return uint8_t( ( pkg.ident() >> 26 ) & 0x07 );
+    else
+      return uint8_t( ( pkg.ident() >> 8 ) & 0x07 );
+  }
+
+
+  uint32_t
+  CanTxQueue_c::pgn( const CanPkg_c& pkg ) {
+    if( pkg.identType() != Ident_c::ExtendedIdent )
+      return scui32_noPgn;
+
+    uint32_t result = ( pkg.ident() >> 8 ) & 0x3FFFF;
+    if( ( ( result >> 8 ) & 0xFF ) < 0xF0 )
+      result &= 0x3FF00;
+    return result;
+  }
+
+
+  bool
+  CanTxQueue_c::push( const CanPkg_c& pkg, ecutime_t now ) {
+    const uint8_t prio = priority( pkg );
+    bool b_discarded = false;
+
+    if( mi_free == sci_noSlot ) {
+      // full: make room by dropping the youngest frame of the lowest priority
+      int lowest = sci_numPriorities - 1;
+      while( marr_head[ lowest ] == sci_noSlot )
+        --lowest;
+
+      ++mui32_discardCount;
+      if( lowest <= prio )
+        return false;
+
+      int prev = sci_noSlot;
+      for( int s = marr_head[ lowest ]; s != marr_tail[ lowest ]; s = marr_next[ s ] )
+        prev = s;
+      unlink( marr_tail[ lowest ], prev );
+      b_discarded = true;
+    }
+
+    const int slot = mi_free;
+    mi_free = marr_next[ slot ];
+
+    marr_frame[ slot ] = pkg;
+    marr_enqueueTime[ slot ] = now;
+    marr_next[ slot ] = sci_noSlot;
+
+    if( marr_tail[ prio ] == sci_noSlot )
+      marr_head[ prio ] = slot;
+    else
+      marr_next[ marr_tail[ prio ] ] = slot;
+    marr_tail[ prio ] = slot;
+
+    ++mui_size;
+    if( mui_size > mui_maxSize )
+      mui_maxSize = mui_size;
+
+    return !b_discarded;
+  }
+
+
+  int
+  CanTxQueue_c::next( ecutime_t now, int& ri_prev ) const {
+    for( int p = 0; p < sci_numPriorities; ++p ) {
+      ri_prev = sci_noSlot;
+      for( int s = marr_head[ p ]; s != sci_noSlot; s = marr_next[ s ] ) {
+        // without any spacing configured, the head is always the one to go
+        if( ( mui_numSpacings == 0 ) || ( getTimeToSend( marr_frame[ s ], now ) <= 0 ) )
+          return s;
+        ri_prev = s;
+      }
+    }
+    ri_prev = sci_noSlot;
+    return sci_noSlot;
+  }
+
+
+  void
+  CanTxQueue_c::unlink( int ai_slot, int ai_prev ) {
+    const uint8_t prio = priority( marr_frame[ ai_slot ] );
+
+    if( ai_prev == sci_noSlot )
+      marr_head[ prio ] = marr_next[ ai_slot ];
+    else
+      marr_next[ ai_prev ] = marr_next[ ai_slot ];
+
+    if( marr_tail[ prio ] == ai_slot )
+      marr_tail[ prio ] = ai_prev;
+
+    marr_next[ ai_slot ] = mi_free;
+    mi_free = ai_slot;
+    --mui_size;
+  }
+
+
+  void
+  CanTxQueue_c::remove( int ai_slot, int ai_prev, ecutime_t now, bool ab_sent ) {
+    isoaglib_assert( ai_slot != sci_noSlot );
+
+    if( ab_sent ) {
+      const uint32_t latency = uint32_t( now - marr_enqueueTime[ ai_slot ] );
+      ++mui32_sentCount;
+      mui32_latencySum += latency;
+      if( latency > mui32_maxLatency )
+        mui32_maxLatency = latency;
+
+      notifySent( marr_frame[ ai_slot ], now );
+    } else {
+      ++mui32_discardCount;
+    }
+
+    unlink( ai_slot, ai_prev );
+  }
+
+
+  int32_t
+  CanTxQueue_c::getTimeToNextSend( ecutime_t now ) const {
+    if( empty() )
+      return -1;
+
+    if( mui_numSpacings == 0 )
+      return 0;
+
+    int32_t result = -1;
+    for( int p = 0; p < sci_numPriorities; ++p ) {
+      for( int s = marr_head[ p ]; s != sci_noSlot; s = marr_next[ s ] ) {
+        int32_t t = getTimeToSend( marr_frame[ s ], now );
+        if( t <= 0 )
+          return 0;
+        if( ( result < 0 ) || ( t < result ) )
+          result = t;
+      }
+    }
+    return result;
+  }
+
+
+  bool
+  CanTxQueue_c::isSendAllowed( const CanPkg_c& pkg, ecutime_t now ) const {
+    return ( mui_numSpacings == 0 ) || ( getTimeToSend( pkg, now ) <= 0 );
+  }
+
+
+  void
+  CanTxQueue_c::notifySent( const CanPkg_c& pkg, ecutime_t now ) {
+    if( mui_numSpacings == 0 )
+      return;
+
+    Spacing_s* spacing = findSpacing( pgn( pkg ) );
+    if( spacing )
+      spacing->lastSent = now;
+  }
+
+
+  int32_t
+  CanTxQueue_c::getTimeToSend( const CanPkg_c& pkg, ecutime_t now ) const {
+    const Spacing_s* spacing = findSpacing( pgn( pkg ) );
+    if( ( spacing == NULL ) || ( spacing->lastSent < 0 ) )
+      return 0;
+
+    return int32_t( ( spacing->lastSent + spacing->spacing ) - now );
+  }
+
+
+  const CanTxQueue_c::Spacing_s*
+  CanTxQueue_c::findSpacing( uint32_t aui32_pgn ) const {
+    if( aui32_pgn == scui32_noPgn )
+      return NULL;
+
+    for( unsigned i = 0; i < mui_numSpacings; ++i ) {
+      if( marr_spacing[ i ].pgn == aui32_pgn )
+        return &marr_spacing[ i ];
+    }
+    return NULL;
+  }
+
+
+  CanTxQueue_c::Spacing_s*
+  CanTxQueue_c::findSpacing( uint32_t aui32_pgn ) {
+    return const_cast<Spacing_s*>( static_cast<const CanTxQueue_c*>( this )->findSpacing( aui32_pgn ) );
+  }
+
+
+  bool
+  CanTxQueue_c::setMinSpacing( uint32_t aui32_pgn, uint16_t aui16_spacing ) {
+    Spacing_s* spacing = findSpacing( aui32_pgn );
+
+    if( aui16_spacing == 0 ) {
+      if( spacing ) {
+        *spacing = marr_spacing[ mui_numSpacings - 1 ];
+        --mui_numSpacings;
+      }
+      return true;
+    }
+
+    if( spacing == NULL ) {
+      if( mui_numSpacings >= CONFIG_CAN_TX_QUEUE_PGN_SPACINGS )
+        return false;
+
+      spacing = &marr_spacing[ mui_numSpacings++ ];
+      spacing->pgn = aui32_pgn;
+      spacing->lastSent = -1;
+    }
+    spacing->spacing = aui16_spacing;
+    return true;
+  }
+
+}
+
+#endif
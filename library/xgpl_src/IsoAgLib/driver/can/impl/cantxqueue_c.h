@@ -0,0 +1,126 @@
+/*
+  cantxqueue_c.h: priority ordered, rate limited software send
+    queue of CanIo_c
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef CAN_TX_QUEUE_H
+#define CAN_TX_QUEUE_H
+
+#include <IsoAgLib/isoaglib_config.h>
+
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+
+#include "canpkg_c.h"
+
+namespace __IsoAgLib {
+
+  /** Software send queue for frames that can't be passed to the HAL immediately.
+      Frames are ordered by the CAN priority (top 3 bits of the 29bit ident,
+      top 3 bits of the 11bit ident) and FIFO within the same priority.
+      Optionally a minimum spacing between two frames of the same PGN can be set;
+      such frames are held back while other PGNs may overtake them.
+      All storage is fixed-size, push and pop are O(1) without rate limits.
+    */
+  class CanTxQueue_c {
+    public:
+      static const int sci_noSlot = -1;
+
+      CanTxQueue_c();
+
+      void clear();
+
+      bool empty() const { return mui_size == 0; }
+      unsigned size() const { return mui_size; }
+      unsigned freeCount() const { return CONFIG_CAN_TX_QUEUE_SIZE - mui_size; }
+
+      /** insert frame. If the queue is full, the youngest frame with the
+          lowest priority is discarded - which may be the new one.
+          @return false if a frame was discarded */
+      bool push( const CanPkg_c& pkg, ecutime_t now );
+
+      /** search the frame to be sent next
+          @param ri_prev gets the predecessor needed for remove()
+          @return slot or sci_noSlot if nothing may be sent now */
+      int next( ecutime_t now, int& ri_prev ) const;
+
+      const CanPkg_c& frame( int ai_slot ) const { return marr_frame[ ai_slot ]; }
+      ecutime_t enqueueTime( int ai_slot ) const { return marr_enqueueTime[ ai_slot ]; }
+
+      /** remove the frame found by next()
+          @param ab_sent true if it was passed to the HAL (for latency/spacing) */
+      void remove( int ai_slot, int ai_prev, ecutime_t now, bool ab_sent );
+
+      /** @return time until a frame held back by PGN spacing may be sent,
+                  0 if a frame could be sent now, -1 if the queue is empty */
+      int32_t getTimeToNextSend( ecutime_t now ) const;
+
+      /** check spacing for a frame bypassing the queue */
+      bool isSendAllowed( const CanPkg_c& pkg, ecutime_t now ) const;
+      void notifySent( const CanPkg_c& pkg, ecutime_t now );
+
+      /** set the minimum time between two frames of a PGN. 0 removes the limit.
+          @return false if no free entry (CONFIG_CAN_TX_QUEUE_PGN_SPACINGS) is left */
+      bool setMinSpacing( uint32_t aui32_pgn, uint16_t aui16_spacing );
+
+      unsigned getMaxSize() const { return mui_maxSize; }
+      uint32_t getSentCount() const { return mui32_sentCount; }
+      uint32_t getDiscardCount() const { return mui32_discardCount; }
+      uint32_t getMaxLatency() const { return mui32_maxLatency; }
+      uint32_t getAverageLatency() const { return ( mui32_sentCount > 0 ) ? ( mui32_latencySum / mui32_sentCount ) : 0; }
+
+    private:
+      struct Spacing_s {
+        uint32_t pgn;
+        uint16_t spacing;
+        ecutime_t lastSent;
+      };
+
+      static const int sci_numPriorities = 8;
+
+      static uint8_t priority( const CanPkg_c& pkg );
+      static uint32_t pgn( const CanPkg_c& pkg );
+
+      const Spacing_s* findSpacing( uint32_t aui32_pgn ) const;
+      Spacing_s* findSpacing( uint32_t aui32_pgn );
+      int32_t getTimeToSend( const CanPkg_c& pkg, ecutime_t now ) const;
+
+      void unlink( int ai_slot, int ai_prev );
+
+      CanPkg_c marr_frame[ CONFIG_CAN_TX_QUEUE_SIZE ];
+      ecutime_t marr_enqueueTime[ CONFIG_CAN_TX_QUEUE_SIZE ];
+      int marr_next[ CONFIG_CAN_TX_QUEUE_SIZE ];
+
+      int marr_head[ sci_numPriorities ];
+      int marr_tail[ sci_numPriorities ];
+      int mi_free;
+      unsigned mui_size;
+
+      Spacing_s marr_spacing[ CONFIG_CAN_TX_QUEUE_PGN_SPACINGS ];
+      unsigned mui_numSpacings;
+
+      unsigned mui_maxSize;
+      uint32_t mui32_sentCount;
+      uint32_t mui32_discardCount;
+      uint32_t mui32_maxLatency;
+      uint32_t mui32_latencySum;
+  };
+
+}
+
+#endif
+#endif
@@ -5,13 +5,15 @@
 
 namespace HAL {
 
-  CanFifo_c::CanFifo_c() : m_rIdx( 0 ), m_wIdx( 0 ) {}
+  CanFifo_c::CanFifo_c() : m_rIdx( 0 ), m_wIdx( 0 ), m_dropCount( 0 ) {}
 
 
   void CanFifo_c::push( __IsoAgLib::CanPkg_c& pkg  ) {
     const unsigned w = m_wIdx;
     if( w == ( m_rIdx + ( m_bufferSize * 2 ) ) ) {
-      isoaglib_assert( !"buffer full" );
+      // buffer full: drop the new frame instead of overwriting unread ones
+      ++m_dropCount;
+      return;
     }
 
     m_wIdx++;
@@ -13,11 +13,15 @@ namespace HAL {
       __IsoAgLib::CanPkg_c& front();
       void pop();
       bool empty() const;
+
+      /** @return number of frames that were dropped because the FIFO was full */
+      unsigned getDropCount() const { return m_dropCount; }
     private:
       static const unsigned m_bufferSize = 1 << CAN_FIFO_EXPONENT_BUFFER_SIZE; // see isoaglib_config.h
 
       volatile unsigned m_rIdx;
       volatile unsigned m_wIdx;
+      volatile unsigned m_dropCount;
 
       __IsoAgLib::CanPkg_c m_data[m_bufferSize];
   };
@@ -50,6 +50,16 @@ namespace HAL {
   void canRxWaitBreak();
 #endif
 
+#ifdef SYSTEM_PC
+  //! Let canRxWait() additionally return when the given descriptor
+  //! (e.g. an application socket) gets readable.
+  //! @return false if CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS are registered already
+  bool canRxWaitAddFd( int fd );
+  void canRxWaitRemoveFd( int fd );
+  //! @return true if the descriptor was readable after the last canRxWait()
+  bool canRxWaitFdIsSet( int fd );
+#endif
+
   //! Returning -1 means that the queue can't be queried,
   //! but it definitely has enough space to put messages in!
   int canTxQueueFree( unsigned channel );
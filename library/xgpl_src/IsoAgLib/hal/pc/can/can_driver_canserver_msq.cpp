@@ -39,6 +39,7 @@
 #include <IsoAgLib/hal/generic_utils/can/canfifo_c.h>
 #include <IsoAgLib/hal/hal_can.h>
 #include <IsoAgLib/hal/pc/system/system.h>
+#include <IsoAgLib/hal/pc/system/canrxwaitfds.h>
 #include <IsoAgLib/util/iassert.h>
 
 #include "can_server_interface.h"
@@ -232,14 +233,19 @@ namespace HAL {
 
     FD_ZERO( &rfds );
     FD_SET( __HAL::msqDataClient.i32_pipeHandle, &rfds );
+    int fdMax = __HAL::msqDataClient.i32_pipeHandle;
 #ifdef USE_MUTUAL_EXCLUSION
     FD_SET( __HAL::breakWaitPipeFd[0], &rfds );
+    if( __HAL::breakWaitPipeFd[0] > fdMax )
+      fdMax = __HAL::breakWaitPipeFd[0];
 #endif
+    __HAL::canRxWaitPrepareFds( rfds, fdMax );
 
-    s_timeout.tv_sec = 0;
-    s_timeout.tv_usec = timeout_ms * 1000;
+    s_timeout.tv_sec = timeout_ms / 1000;
+    s_timeout.tv_usec = ( timeout_ms % 1000 ) * 1000;
 
-    rc = select( __HAL::msqDataClient.i32_pipeHandle+1, &rfds, NULL, NULL, &s_timeout );
+    rc = select( fdMax + 1, &rfds, NULL, NULL, &s_timeout );
+    __HAL::canRxWaitEvaluateFds( rfds, rc );
 
 #ifdef USE_MUTUAL_EXCLUSION
     if( FD_ISSET( __HAL::breakWaitPipeFd[0], &rfds ) ) {
@@ -27,6 +27,7 @@
 #include <IsoAgLib/hal/generic_utils/can/canfifo_c.h>
 #include <IsoAgLib/hal/hal_can.h>
 #include <IsoAgLib/hal/pc/system/system.h>
+#include <IsoAgLib/hal/pc/system/canrxwaitfds.h>
 #include <IsoAgLib/isoaglib_config.h>
 
 
@@ -479,11 +480,14 @@ namespace HAL {
 #ifdef USE_MUTUAL_EXCLUSION
     FD_SET( __HAL::breakWaitSocket_read, &rfds );
 #endif
+    int fdMax = 0;
+    __HAL::canRxWaitPrepareFds( rfds, fdMax );
 
-    s_timeout.tv_sec = 0;
-    s_timeout.tv_usec = timeout_ms * 1000;
+    s_timeout.tv_sec = timeout_ms / 1000;
+    s_timeout.tv_usec = ( timeout_ms % 1000 ) * 1000;
 
     int rc = select( FD_SETSIZE, &rfds, NULL, NULL, &s_timeout );
+    __HAL::canRxWaitEvaluateFds( rfds, rc );
 
 #ifdef USE_MUTUAL_EXCLUSION
     if( FD_ISSET( __HAL::breakWaitSocket_read, &rfds ) ) {
@@ -29,6 +29,7 @@
 
 #include "IsoAgLib/hal/generic_utils/can/canfifo_c.h"
 #include <IsoAgLib/hal/pc/system/system.h>
+#include <IsoAgLib/hal/pc/system/canrxwaitfds.h>
 #include <IsoAgLib/util/iassert.h>
 #include <IsoAgLib/isoaglib_config.h>
 #include <IsoAgLib/hal/hal_can.h>
@@ -71,7 +72,22 @@ namespace HAL {
 
 
   bool canRxWait( unsigned timeout_ms ) {
-    return false;
+    // no frames to wait for, only the descriptors registered by the application
+    fd_set rfds;
+    FD_ZERO( &rfds );
+    int fdMax = -1;
+    __HAL::canRxWaitPrepareFds( rfds, fdMax );
+    if( fdMax < 0 )
+      return false;
+
+    struct timeval timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = ( timeout_ms % 1000 ) * 1000;
+
+    const int rc = select( fdMax + 1, &rfds, 0, 0, &timeout );
+    __HAL::canRxWaitEvaluateFds( rfds, rc );
+
+    return ( rc > 0 );
   }
 
 #ifdef USE_MUTUAL_EXCLUSION
@@ -36,6 +36,7 @@
 #include <list>
 
 #include <IsoAgLib/hal/pc/system/system.h>
+#include <IsoAgLib/hal/pc/system/canrxwaitfds.h>
 #include <IsoAgLib/util/iassert.h>
 
 #ifndef PF_CAN
@@ -383,15 +384,19 @@ namespace HAL {
   bool canRxWait( unsigned timeout_ms ) {
 
     static struct timeval timeout;
-    timeout.tv_sec = 0;
-    timeout.tv_usec = timeout_ms * 1000;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = ( timeout_ms % 1000 ) * 1000;
 
     fd_set rfds = __HAL::g_rfds;
-    const int rc = select( __HAL::g_fdMax + 1, &rfds, 0, 0, &timeout );
+    int fdMax = __HAL::g_fdMax;
+    __HAL::canRxWaitPrepareFds( rfds, fdMax );
+
+    const int rc = select( fdMax + 1, &rfds, 0, 0, &timeout );
 
 #ifdef USE_MUTUAL_EXCLUSION
     __HAL::canClearBreakWaitFd( rfds );
 #endif
+    __HAL::canRxWaitEvaluateFds( rfds, rc );
 
     return ( rc > 0 );
   };
@@ -88,6 +88,12 @@
   #define CONFIG_HAL_PC_RTE_DEFAULT_SERVER "rte4"
 #endif
 
+/** max number of application file descriptors (sockets, pipes) that
+    can be registered to wake up HAL::canRxWait() */
+#ifndef CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS
+  #define CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS 8
+#endif
+
 /* Initialisierung Watchdog 0 */
 #define WD_MAX_TIME      0//200        /* 128 ms                    */
 #define WD_MIN_TIME      0      /* 0 ms                      */
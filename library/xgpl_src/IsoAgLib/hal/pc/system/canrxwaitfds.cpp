@@ -0,0 +1,100 @@
+/*
+  canrxwaitfds.cpp: application file descriptors the PC CAN drivers
+    additionally wait for in HAL::canRxWait()
+
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+
+#include "canrxwaitfds.h"
+#include <IsoAgLib/hal/hal_can.h>
+
+
+namespace __HAL {
+
+  static int s_fds[ CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS ];
+  static bool s_readable[ CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS ];
+  static unsigned s_numFds = 0;
+
+
+  static int findFd( int fd ) {
+    for( unsigned i = 0; i < s_numFds; ++i ) {
+      if( s_fds[ i ] == fd )
+        return int( i );
+    }
+    return -1;
+  }
+
+
+  void canRxWaitPrepareFds( fd_set& ar_rfds, int& ar_maxFd ) {
+    for( unsigned i = 0; i < s_numFds; ++i ) {
+      s_readable[ i ] = false;
+      FD_SET( s_fds[ i ], &ar_rfds );
+      if( s_fds[ i ] > ar_maxFd )
+        ar_maxFd = s_fds[ i ];
+    }
+  }
+
+
+  bool canRxWaitEvaluateFds( const fd_set& arc_rfds, int ai_selectResult ) {
+    bool b_readable = false;
+    if( ai_selectResult <= 0 )
+      return false;
+
+    for( unsigned i = 0; i < s_numFds; ++i ) {
+      s_readable[ i ] = ( FD_ISSET( s_fds[ i ], const_cast<fd_set*>( &arc_rfds ) ) != 0 );
+      b_readable |= s_readable[ i ];
+    }
+    return b_readable;
+  }
+
+} // __HAL
+
+
+namespace HAL {
+
+  bool canRxWaitAddFd( int fd ) {
+    if( __HAL::findFd( fd ) >= 0 )
+      return true;
+
+    if( __HAL::s_numFds >= CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS )
+      return false;
+
+    __HAL::s_fds[ __HAL::s_numFds ] = fd;
+    __HAL::s_readable[ __HAL::s_numFds ] = false;
+    ++__HAL::s_numFds;
+    return true;
+  }
+
+
+  void canRxWaitRemoveFd( int fd ) {
+    const int idx = __HAL::findFd( fd );
+    if( idx < 0 )
+      return;
+
+    --__HAL::s_numFds;
+    __HAL::s_fds[ idx ] = __HAL::s_fds[ __HAL::s_numFds ];
+    __HAL::s_readable[ idx ] = __HAL::s_readable[ __HAL::s_numFds ];
+  }
+
+
+  bool canRxWaitFdIsSet( int fd ) {
+    const int idx = __HAL::findFd( fd );
+    return ( idx >= 0 ) && __HAL::s_readable[ idx ];
+  }
+
+} // HAL
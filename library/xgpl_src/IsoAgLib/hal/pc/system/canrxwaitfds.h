@@ -0,0 +1,47 @@
+/*
+  canrxwaitfds.h: application file descriptors the PC CAN drivers
+    additionally wait for in HAL::canRxWait()
+
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef _HAL_PC_CANRXWAITFDS_H_
+#define _HAL_PC_CANRXWAITFDS_H_
+
+#include <IsoAgLib/isoaglib_config.h>
+
+#ifdef WIN32
+#  include <winsock2.h>
+#else
+#  include <sys/select.h>
+#endif
+
+
+namespace __HAL {
+
+  /** add the descriptors registered by HAL::canRxWaitAddFd() to the set
+      passed to select() by canRxWait() and clear the results of the last wait.
+      @param ar_maxFd gets raised to the highest added descriptor */
+  void canRxWaitPrepareFds( fd_set& ar_rfds, int& ar_maxFd );
+
+  /** remember which registered descriptors are readable after select()
+      @return true if at least one of them is readable */
+  bool canRxWaitEvaluateFds( const fd_set& arc_rfds, int ai_selectResult );
+
+} // __HAL
+
+#endif
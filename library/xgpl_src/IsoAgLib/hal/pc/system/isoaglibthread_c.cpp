@@ -150,11 +150,7 @@ int IsoAgLibThread_c::Exec()
 
   while (!GetRequestToStop())
   {
-    const int32_t i32_sleepTime = IsoAgLib::getISchedulerInstance().timeEventWithWaitMutex();
-
-    if (i32_sleepTime > 0) {
-      IsoAgLib::getISchedulerInstance().waitUntilCanReceiveOrTimeout (i32_sleepTime);
-    }
+    (void)IsoAgLib::getISchedulerInstance().runOnce();
   }
 
   return 0;    
@@ -246,6 +246,34 @@
 #  define CONFIG_CAN_BLOCK_TIME 10
 #endif
 
+/** size of the software send queue of CanIo_c [frames].
+    0 (default) disables the queue and CanIo_c::operator<< blocks
+    up to CONFIG_CAN_BLOCK_TIME if the HAL's send buffer is full.
+    With a queue, sending never blocks: frames are queued by CAN priority
+    (and FIFO within a priority) and passed to the HAL on every timeEvent.
+*/
+#ifndef CONFIG_CAN_TX_QUEUE_SIZE
+#  define CONFIG_CAN_TX_QUEUE_SIZE 0
+#endif
+
+/** queued frames older than this [msec] are discarded (e.g. on bus-off) */
+#ifndef CONFIG_CAN_TX_QUEUE_MAX_AGE
+#  define CONFIG_CAN_TX_QUEUE_MAX_AGE 1000
+#endif
+
+/** number of PGNs that can be given a minimum inter-frame spacing in the send queue */
+#ifndef CONFIG_CAN_TX_QUEUE_PGN_SPACINGS
+#  define CONFIG_CAN_TX_QUEUE_PGN_SPACINGS 8
+#endif
+
+/** number of different PGNs tracked individually by the CAN statistics
+    (only used with USE_CAN_STATISTICS). Frames of further PGNs are only
+    counted in the totals, per SA and as PGN table overflow.
+*/
+#ifndef CONFIG_CAN_STATISTICS_PGN_SLOTS
+#  define CONFIG_CAN_STATISTICS_PGN_SLOTS 64
+#endif
+
 /** define interval for detection of incoming message loss.
     -> should normally NOT be changed by the user/app.
        keep it as is!
@@ -271,16 +299,115 @@
 #  define CONFIG_VT_CLIENT_OP_BITMAPS_MEMORY_MODIFIER
 #endif
 
+// define CONFIG_VT_CLIENT_PICTURE_GRAPHIC_RUNTIME_RLE to upload picture graphics
+// which are given as raw data (e.g. generated at runtime) RLE encoded
+// when that is smaller. The encoding is done while streaming.
+
 // define how many send-queues should be set up.
 #ifndef CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES
 #  define CONFIG_VT_CLIENT_NUM_SEND_PRIORITIES 1
 #endif
 
+// number of obsolete content hash version labels remembered from the
+// VT's Get Versions Response to be deleted when the pool is up.
+#ifndef CONFIG_VT_CLIENT_MAX_OBSOLETE_VERSIONS
+#  define CONFIG_VT_CLIENT_MAX_OBSOLETE_VERSIONS 4
+#endif
+
+// number of (command, object) entries of the VT state shadowed per client
+// connection to suppress redundant Change Numeric Value, Change String Value
+// and Hide/Show Object commands (see CommandHandler_c::enableShadowStateCheck)
+#ifndef CONFIG_VT_CLIENT_SHADOW_STATE_SIZE
+#  define CONFIG_VT_CLIENT_SHADOW_STATE_SIZE 128
+#endif
+
+// size of the blocks of an object pool's arena for the RAM copies of
+// changed objects' attribute structs, allocated when needed
+#ifndef CONFIG_VT_CLIENT_RAM_STRUCT_ARENA_CHUNK_SIZE
+#  define CONFIG_VT_CLIENT_RAM_STRUCT_ARENA_CHUNK_SIZE 1024
+#endif
+
+// define CONFIG_VT_CLIENT_RAM_STRUCT_ARENA_PREFAULT to allocate and touch
+// the first block of that arena at pool registration instead of on the
+// first attribute change.
+
+// number of condensed work state DDIs a CondensedWorkState_c commits per
+// cycle. Each one sends at most one on-change frame per connection, so this
+// is the frame budget per connection and cycle.
+#ifndef CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_DDIS_PER_CYCLE
+#  define CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_DDIS_PER_CYCLE 4
+#endif
+
+// minimum time between two cycles of a CondensedWorkState_c. With the
+// defaults all 16 DDIs of a 256 section boom are out within 80ms.
+#ifndef CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_CYCLE_TIME
+#  define CONFIG_TC_CLIENT_CONDENSED_WORK_STATE_CYCLE_TIME 20
+#endif
+
+// number of samples a PdLogger_c buffers in RAM, they're written as one
+// block to its stream when the buffer is full
+#ifndef CONFIG_TC_CLIENT_PD_LOGGER_BUFFER_SAMPLES
+#  define CONFIG_TC_CLIENT_PD_LOGGER_BUFFER_SAMPLES 256
+#endif
+
+// maximum time a sample stays buffered in a PdLogger_c
+#ifndef CONFIG_TC_CLIENT_PD_LOGGER_FLUSH_PERIOD
+#  define CONFIG_TC_CLIENT_PD_LOGGER_FLUSH_PERIOD 1000
+#endif
+
 // Don't keep this too low, as it will also be used for all other commands!
 #ifndef CONFIG_FS_CLIENT_MAX_WRITE_SIZE
 #  define CONFIG_FS_CLIENT_MAX_WRITE_SIZE 240
 #endif
 
+// block size of the streaming read of the FS client. Responses larger than
+// 1780 bytes need ETP, so for file servers before the IS version it's limited
+// to that (max. 65535)
+#ifndef CONFIG_FS_CLIENT_STREAM_READ_SIZE
+#  define CONFIG_FS_CLIENT_STREAM_READ_SIZE 16384
+#endif
+
+// size of each of the two buffers of an iFsFileWriter_c, one is written
+// while the other one is filled. Writes larger than 1780 bytes need ETP,
+// so for file servers before the IS version it's limited to that (max. 65535)
+#ifndef CONFIG_FS_CLIENT_WRITE_BUFFER_SIZE
+#  define CONFIG_FS_CLIENT_WRITE_BUFFER_SIZE 4096
+#endif
+
+// maximum time data stays in the buffer of an iFsFileWriter_c
+#ifndef CONFIG_FS_CLIENT_WRITE_BEHIND_PERIOD
+#  define CONFIG_FS_CLIENT_WRITE_BEHIND_PERIOD 1000
+#endif
+
+// time file attributes and directory listings of a file server are answered
+// from the FS client's metadata cache, 0 disables the cache
+#ifndef CONFIG_FS_CLIENT_METADATA_CACHE_TTL
+#  define CONFIG_FS_CLIENT_METADATA_CACHE_TTL 2000
+#endif
+
+// files and directory listings the metadata cache of each file server holds,
+// the oldest entry is replaced if full
+#ifndef CONFIG_FS_CLIENT_METADATA_CACHE_FILES
+#  define CONFIG_FS_CLIENT_METADATA_CACHE_FILES 64
+#endif
+#ifndef CONFIG_FS_CLIENT_METADATA_CACHE_DIRECTORIES
+#  define CONFIG_FS_CLIENT_METADATA_CACHE_DIRECTORIES 4
+#endif
+
+// directory entries requested at once when prefetching a directory
+#ifndef CONFIG_FS_CLIENT_PREFETCH_COUNT
+#  define CONFIG_FS_CLIENT_PREFETCH_COUNT 32
+#endif
+
+// files an FsServer_c keeps open for all its clients together (at most 254)
+#ifndef CONFIG_FS_SERVER_MAX_OPEN_FILES
+#  define CONFIG_FS_SERVER_MAX_OPEN_FILES 32
+#endif
+
+// define CONFIG_FS_SERVER_FLUSH_EACH_WRITE to flush every written chunk to
+// the volume (e.g. for loggers that have to survive a power loss), otherwise
+// written data is flushed on seek and close.
+
 
 /* ***** Auto-set dependant defines ***** */
 
@@ -0,0 +1,51 @@
+/*
+  iexternalfdhandler_c.h: handler for application file descriptors
+    served by the run loop of iScheduler_c
+
+
+  (C) Copyright 2009 - 2019 by OSB AG
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Usage under Commercial License:
+  Licensees with a valid commercial license may use this file
+  according to their commercial license agreement. (To obtain a
+  commercial license contact OSB AG via <http://isoaglib.com/en/contact>)
+
+  Usage under GNU General Public License with exceptions for ISOAgLib:
+  Alternatively (if not holding a valid commercial license)
+  use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#ifndef IEXTERNALFDHANDLER_H
+#define IEXTERNALFDHANDLER_H
+
+#include <IsoAgLib/isoaglib_config.h>
+
+#ifdef SYSTEM_PC
+
+namespace IsoAgLib {
+
+/** Implement this to have iScheduler_c::runOnce() / iScheduler_c::run()
+    also wait for an application descriptor (e.g. a socket).
+    @see iScheduler_c::registerExternalFd() */
+class iExternalFdHandler_c {
+public:
+  virtual ~iExternalFdHandler_c() {}
+
+  void fdReadable( int fd ) {
+    onFdReadable( fd );
+  }
+
+private:
+  /** called from the run loop (with the IsoAgLib resource acquired
+      in case of USE_MUTUAL_EXCLUSION) when fd got readable */
+  virtual void onFdReadable( int fd ) = 0;
+};
+
+} // IsoAgLib
+
+#endif
+#endif
@@ -27,6 +27,7 @@
 #include <IsoAgLib/util/iliberr_c.h>
 #include <IsoAgLib/util/iassert.h>
 #include <IsoAgLib/util/impl/util_funcs.h>
+#include <IsoAgLib/scheduler/iexternalfdhandler_c.h>
 
 namespace __IsoAgLib {
 
@@ -38,6 +39,9 @@ namespace __IsoAgLib {
     : Subsystem_c()
     ,mpc_registeredErrorObserver( NULL )
     ,m_taskQueue()
+#ifdef SYSTEM_PC
+    ,m_externalFds()
+#endif
 #ifdef USE_MUTUAL_EXCLUSION
     ,mc_protectAccess()
     ,m_breakTimeEvent( false )
@@ -72,6 +76,9 @@ namespace __IsoAgLib {
     IsoAgLib::getILibErrInstance().close();
 
     isoaglib_assert ( m_taskQueue.empty() );
+#ifdef SYSTEM_PC
+    isoaglib_assert ( m_externalFds.empty() );
+#endif
 
     setClosed();
   }
@@ -95,6 +102,82 @@ namespace __IsoAgLib {
   }
 
 
+  bool Scheduler_c::runOnce() {
+#ifdef USE_MUTUAL_EXCLUSION
+    waitAcquireResource( true );
+#endif
+    const int32_t idleTime = timeEvent();
+#ifdef USE_MUTUAL_EXCLUSION
+    releaseResource();
+#endif
+
+    if( idleTime <= 0 )
+      return false;
+
+    const bool b_event = waitUntilCanReceiveOrTimeout( idleTime );
+
+#ifdef SYSTEM_PC
+    if( b_event && !m_externalFds.empty() )
+      handleExternalFds();
+#endif
+
+    return b_event;
+  }
+
+
+  void Scheduler_c::run( const volatile bool& arb_stop ) {
+    while( !arb_stop )
+      (void)runOnce();
+  }
+
+
+#ifdef SYSTEM_PC
+  bool Scheduler_c::registerExternalFd( int fd, IsoAgLib::iExternalFdHandler_c& handler ) {
+    for( STL_NAMESPACE::list<ExternalFd_s>::iterator i = m_externalFds.begin(); i != m_externalFds.end(); ++i ) {
+      if( i->fd == fd ) {
+        i->handler = &handler;
+        return true;
+      }
+    }
+
+    if( !HAL::canRxWaitAddFd( fd ) )
+      return false;
+
+    ExternalFd_s entry = { fd, &handler };
+    m_externalFds.push_back( entry );
+    return true;
+  }
+
+
+  void Scheduler_c::deregisterExternalFd( int fd ) {
+    for( STL_NAMESPACE::list<ExternalFd_s>::iterator i = m_externalFds.begin(); i != m_externalFds.end(); ++i ) {
+      if( i->fd == fd ) {
+        m_externalFds.erase( i );
+        HAL::canRxWaitRemoveFd( fd );
+        return;
+      }
+    }
+  }
+
+
+  void Scheduler_c::handleExternalFds() {
+#ifdef USE_MUTUAL_EXCLUSION
+    waitAcquireResource( true );
+#endif
+    // the handler may deregister its own descriptor
+    STL_NAMESPACE::list<ExternalFd_s>::iterator i = m_externalFds.begin();
+    while( i != m_externalFds.end() ) {
+      const ExternalFd_s entry = *i++;
+      if( HAL::canRxWaitFdIsSet( entry.fd ) )
+        entry.handler->fdReadable( entry.fd );
+    }
+#ifdef USE_MUTUAL_EXCLUSION
+    releaseResource();
+#endif
+  }
+#endif
+
+
   int32_t Scheduler_c::timeEvent() {
 
 #if defined( ISOAGLIB_SCHEDULER_MAX_TIMEEVENT ) && ( ISOAGLIB_SCHEDULER_MAX_TIMEEVENT > 0 )
@@ -131,7 +214,8 @@ namespace __IsoAgLib {
         // we have to return some amount of mss that we have nothing todo
         // but we cannot return any usefull value. Thus 1h is used what won't
         // hurt.
-        return 3600000L;
+        timeToNextTrigger = 3600000L;
+        break;
       }
 
 #if defined( ISOAGLIB_SCHEDULER_MAX_TIMEEVENT ) && ( ISOAGLIB_SCHEDULER_MAX_TIMEEVENT > 0 )
@@ -151,6 +235,16 @@ namespace __IsoAgLib {
       task.timeEventPost();
     }
 
+#if CONFIG_CAN_TX_QUEUE_SIZE > 0
+    // pass frames queued by the tasks above to the HAL and make sure
+    // to get called again in time for the remaining ones
+    for ( int ind = 0; ind < CAN_INSTANCE_CNT; ind++ ) {
+      const int32_t timeToNextTxQueue = getCanInstance( ind ).processTxQueue();
+      if( ( timeToNextTxQueue >= 0 ) && ( timeToNextTxQueue < timeToNextTrigger ) )
+        timeToNextTrigger = ( timeToNextTxQueue > 0 ) ? timeToNextTxQueue : 1;
+    }
+#endif
+
     return timeToNextTrigger;
   }
 
@@ -24,6 +24,7 @@
 
 namespace IsoAgLib {
   class iErrorObserver_c;
+  class iExternalFdHandler_c;
 }
 
 #include <IsoAgLib/isoaglib_config.h>
@@ -71,6 +72,23 @@ namespace __IsoAgLib {
       void registerTask( SchedulerTask_c& task, int32_t delay );
       void deregisterTask( SchedulerTask_c& task );
 
+      /** one pass of the integrated run loop: timeEvent() and then block in one call
+          until the next task is due, a CAN frame is received, the wait is broken
+          (USE_MUTUAL_EXCLUSION) or a registered external descriptor gets readable.
+          @return true if the wait was ended by an event instead of the timeout */
+      bool runOnce();
+
+      /** call runOnce() until arb_stop gets set (e.g. from a signal handler
+          or an iExternalFdHandler_c) */
+      void run( const volatile bool& arb_stop );
+
+#ifdef SYSTEM_PC
+      /** let runOnce() also wait for fd and call the handler when it is readable.
+          @return false if CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS are registered already */
+      bool registerExternalFd( int fd, IsoAgLib::iExternalFdHandler_c& handler );
+      void deregisterExternalFd( int fd );
+#endif
+
 #ifdef USE_MUTUAL_EXCLUSION
       int releaseResource() {
         return mc_protectAccess.releaseAccess();
@@ -110,6 +128,16 @@ namespace __IsoAgLib {
       //  Attribute: mc_taskQueue
       STL_NAMESPACE::list<SchedulerTask_c*> m_taskQueue;
 
+#ifdef SYSTEM_PC
+      struct ExternalFd_s {
+        int fd;
+        IsoAgLib::iExternalFdHandler_c* handler;
+      };
+      STL_NAMESPACE::list<ExternalFd_s> m_externalFds;
+
+      void handleExternalFds();
+#endif
+
 #ifdef USE_MUTUAL_EXCLUSION
       /** Attribute for the exclusive access of the IsoAgLib for threads */
       HAL::ExclusiveAccess_c mc_protectAccess;
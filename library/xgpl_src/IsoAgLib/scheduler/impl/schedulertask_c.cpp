@@ -30,7 +30,11 @@ namespace __IsoAgLib {
     , m_hardTiming( hardTiming )
     , m_nextTriggerTimeSet( false )
     , m_registered( false )
+    , m_inTimeEvent( false )
+    , m_triggered( false )
+    , m_triggeredRun( false )
     , m_nextTriggerTime( -1 )
+    , m_regularTriggerTime( -1 )
     , m_period( period )
 #if defined( ISOAGLIB_DEBUG_TIMEEVENT ) || defined( ISOAGLIB_TASK_MAX_TIMEEVENT )
     , m_startTime( -1 )
@@ -57,14 +61,44 @@ namespace __IsoAgLib {
   void SchedulerTask_c::setNextTriggerTime( ecutime_t time ) {
     isoaglib_assert( isRegistered() );
 
+    // an explicitly set time overrides a pending trigger()
+    m_triggered = false;
     m_nextTriggerTime = time;
     getSchedulerInstance().rescheduleTask( *this );
     m_nextTriggerTimeSet = true;
   }
 
 
+  void SchedulerTask_c::trigger() {
+    isoaglib_assert( isRegistered() );
+
+    if( m_triggered )
+      return;
+
+    m_triggered = true;
+
+    // during our own timeEvent() timeEventPost() takes care
+    if( m_inTimeEvent )
+      return;
+
+    const ecutime_t now = System_c::getTime();
+    if( m_nextTriggerTime <= now ) {
+      // already due, this run is the triggered one
+      m_regularTriggerTime = m_nextTriggerTime;
+      return;
+    }
+
+    m_regularTriggerTime = m_nextTriggerTime;
+    m_nextTriggerTime = now;
+    getSchedulerInstance().rescheduleTask( *this );
+  }
+
+
   void SchedulerTask_c::timeEventPre() {
     m_nextTriggerTimeSet = false;
+    m_inTimeEvent = true;
+    m_triggeredRun = m_triggered;
+    m_triggered = false;
 #if defined( ISOAGLIB_DEBUG_TIMEEVENT ) || defined( ISOAGLIB_TASK_MAX_TIMEEVENT )
     m_startTime = System_c::getTime();
 #endif
@@ -72,6 +106,8 @@ namespace __IsoAgLib {
 
 
   void SchedulerTask_c::timeEventPost() {
+    m_inTimeEvent = false;
+
 #if defined( ISOAGLIB_DEBUG_TIMEEVENT ) || defined( ISOAGLIB_TASK_MAX_TIMEEVENT )
     m_thisTimeEvent = System_c::getTime() - m_startTime;
 
@@ -98,13 +134,18 @@ namespace __IsoAgLib {
           // relax timing if not set to hard timing: calculate
           // the next trigger time from now and not from the time
           // we would have been theoretically called
-          if( ! m_hardTiming ) {
-            m_nextTriggerTime = System_c::getTime();
-          }
+          if( m_hardTiming && m_triggeredRun && ( m_regularTriggerTime > System_c::getTime() ) ) {
+            // the run was triggered in between: keep the regular grid
+            m_nextTriggerTime = m_regularTriggerTime;
+          } else {
+            if( ! m_hardTiming ) {
+              m_nextTriggerTime = System_c::getTime();
+            }
 
-          m_nextTriggerTime += getPeriod();
-          while( m_nextTriggerTime < System_c::getTime() )
             m_nextTriggerTime += getPeriod();
+            while( m_nextTriggerTime < System_c::getTime() )
+              m_nextTriggerTime += getPeriod();
+          }
 
           getSchedulerInstance().rescheduleTask( *this );
         }
@@ -114,11 +155,20 @@ namespace __IsoAgLib {
         getSchedulerInstance().deregisterTask( *this );
       }
     }
+
+    if( m_triggered && isRegistered() ) {
+      // triggered during the own timeEvent: run once more now
+      m_regularTriggerTime = m_nextTriggerTime;
+      m_nextTriggerTime = System_c::getTime();
+      getSchedulerInstance().rescheduleTask( *this );
+    }
+    m_triggeredRun = false;
   }
 
 
   void SchedulerTask_c::setRegistered( bool r ) {
     m_registered = r;
+    m_triggered = false;
   }
 
 } /// end of namespace
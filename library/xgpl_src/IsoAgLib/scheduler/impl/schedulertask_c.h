@@ -58,6 +58,17 @@ namespace __IsoAgLib {
         setNextTriggerTime( System_c::getTime() );
       }
 
+      /** let the task run as soon as possible - when called from processMsg()
+          right after the current batch of CAN messages - without changing
+          its regular schedule. Multiple calls before the task runs are
+          coalesced to one run. If called from within the task's own
+          timeEvent(), it is run once more immediately afterwards. */
+      void trigger();
+
+      bool isTriggered() const {
+        return m_triggered;
+      }
+
       bool isRegistered() const {
         return m_registered;
       }
@@ -71,7 +82,11 @@ namespace __IsoAgLib {
       bool m_hardTiming;
       bool m_nextTriggerTimeSet;
       bool m_registered;
+      bool m_inTimeEvent;
+      bool m_triggered;
+      bool m_triggeredRun;
       ecutime_t m_nextTriggerTime;
+      ecutime_t m_regularTriggerTime;
       int32_t m_period;
 
 #if defined( ISOAGLIB_DEBUG_TIMEEVENT ) || defined( ISOAGLIB_TASK_MAX_TIMEEVENT )
@@ -23,6 +23,7 @@
 
 #include "impl/scheduler_c.h"
 #include <IsoAgLib/scheduler/ischedulertask_c.h>
+#include <IsoAgLib/scheduler/iexternalfdhandler_c.h>
 
 
 /// Begin Namespace IsoAgLib
@@ -80,6 +81,33 @@ namespace IsoAgLib {
         return Scheduler_c::waitUntilCanReceiveOrTimeout( timeoutInterval );
       }
 
+      /** one pass of the integrated run loop, replacing the usual
+            idleTime = timeEvent(); waitUntilCanReceiveOrTimeout( idleTime );
+          Blocks in one call until the next task is due, a CAN frame is received,
+          the wait is broken or a registered external descriptor gets readable.
+          @return true if the wait was ended by an event instead of the timeout */
+      bool runOnce() {
+        return Scheduler_c::runOnce();
+      }
+
+      /** call runOnce() until arb_stop gets set */
+      void run( const volatile bool& arb_stop ) {
+        Scheduler_c::run( arb_stop );
+      }
+
+#ifdef SYSTEM_PC
+      /** let runOnce()/run() also wait for an application descriptor (socket, pipe)
+          and call handler when it is readable.
+          @return false if CONFIG_HAL_PC_CAN_RX_WAIT_MAX_FDS are registered already */
+      bool registerExternalFd( int fd, iExternalFdHandler_c& handler ) {
+        return Scheduler_c::registerExternalFd( fd, handler );
+      }
+
+      void deregisterExternalFd( int fd ) {
+        Scheduler_c::deregisterExternalFd( fd );
+      }
+#endif
+
 #ifdef USE_MUTUAL_EXCLUSION
       /**
           Lock the resource TimeEvent and call it for CanIo_c
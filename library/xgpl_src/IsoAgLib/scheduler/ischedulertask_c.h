@@ -55,6 +55,11 @@ namespace IsoAgLib {
         SchedulerTask_c::retriggerNow();
       }
 
+      /** run the task as soon as possible (coalesced), keeping its regular schedule */
+      void trigger() {
+        SchedulerTask_c::trigger();
+      }
+
       bool isRegistered() const {
         return SchedulerTask_c::isRegistered();
       }
@@ -0,0 +1,214 @@
+/*
+  pdlogreader.cpp: converts a process data log written by
+    IsoAgLib::iPdLogger_c into CSV
+
+  (C) Copyright 2009 - 2019 by OSB AG and developing partners
+
+  See the repository-log for details on the authors and file-history.
+  (Repository information can be found at <http://isoaglib.com/download>)
+
+  Use, modification and distribution are subject to the GNU General
+  Public License with exceptions for ISOAgLib. (See accompanying
+  file LICENSE.txt or copy at <http://isoaglib.com/download/license>)
+*/
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <stdint.h>
+
+
+namespace {
+
+  struct Channel_s {
+    uint16_t ddi;
+    uint16_t element;
+    uint8_t kind;
+  };
+
+  class Reader_c {
+  public:
+    Reader_c( const std::vector<uint8_t>& data, size_t pos, size_t end ) : m_data( data ), m_pos( pos ), m_end( end ), m_ok( true ) {}
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_pos >= m_end; }
+    size_t pos() const { return m_pos; }
+    size_t remaining() const { return m_end - m_pos; }
+
+    void skip( size_t length ) { m_pos += length; }
+
+    uint8_t getUint8()
+    {
+      if( m_pos >= m_end ) { m_ok = false; return 0; }
+      return m_data[ m_pos++ ];
+    }
+
+    uint16_t getUint16()
+    {
+      const uint16_t low = getUint8();
+      return uint16_t( low | ( uint16_t( getUint8() ) << 8 ) );
+    }
+
+    uint64_t getVarint()
+    {
+      uint64_t value = 0;
+      for( unsigned shift = 0; shift < 64; shift += 7 )
+      {
+        const uint8_t byte = getUint8();
+        value |= uint64_t( byte & 0x7F ) << shift;
+        if( !( byte & 0x80 ) || !m_ok )
+          return value;
+      }
+      m_ok = false;
+      return value;
+    }
+
+    int64_t getSvarint()
+    {
+      const uint64_t value = getVarint();
+      return int64_t( value >> 1 ) ^ -int64_t( value & 1 );
+    }
+
+  private:
+    const std::vector<uint8_t>& m_data;
+    size_t m_pos;
+    size_t m_end;
+    bool m_ok;
+  };
+
+
+  bool readDictionary( Reader_c& block, std::map<uint64_t, Channel_s>& channels )
+  {
+    const uint64_t count = block.getVarint();
+    for( uint64_t i = 0; ( i < count ) && block.ok(); ++i )
+    {
+      const uint64_t index = block.getVarint();
+      Channel_s channel;
+      channel.ddi = block.getUint16();
+      channel.element = block.getUint16();
+      channel.kind = block.getUint8();
+      channels[ index ] = channel;
+    }
+    return block.ok();
+  }
+
+
+  bool readSamples( Reader_c& block, const std::map<uint64_t, Channel_s>& channels, std::ostream& out )
+  {
+    const uint64_t count = block.getVarint();
+    if( !block.ok() || ( count > block.remaining() ) ) // each sample takes at least 3 bytes
+      return false;
+
+    std::vector<uint64_t> index( size_t( count ), 0 );
+    std::vector<int64_t> time( size_t( count ), 0 );
+
+    int64_t t = block.getSvarint();
+    for( uint64_t i = 0; i < count; ++i )
+      index[ i ] = block.getVarint();
+    for( uint64_t i = 0; i < count; ++i )
+    {
+      if( i > 0 )
+        t += block.getSvarint();
+      time[ i ] = t;
+    }
+
+    std::map<uint64_t, int64_t> lastValue; // per channel within this block
+    for( uint64_t i = 0; ( i < count ) && block.ok(); ++i )
+    {
+      int64_t& value = lastValue[ index[ i ] ];
+      value += block.getSvarint();
+
+      std::map<uint64_t, Channel_s>::const_iterator channel = channels.find( index[ i ] );
+      if( channel == channels.end() )
+      {
+        std::cerr << "sample of undefined channel " << index[ i ] << std::endl;
+        return false;
+      }
+
+      out << time[ i ] << ','
+          << channel->second.ddi << ','
+          << channel->second.element << ','
+          << ( channel->second.kind == 0 ? "measurement" : "setpoint" ) << ','
+          << int32_t( value ) << '\n';
+    }
+    return block.ok();
+  }
+
+}
+
+
+int main( int argc, char* argv[] )
+{
+  if( ( argc < 2 ) || ( argc > 3 ) )
+  {
+    std::cerr << "Usage: " << argv[ 0 ] << " <pdlog file> [<csv file>]" << std::endl
+              << "  Converts a process data log written by iPdLogger_c to CSV" << std::endl
+              << "  (time in msec, DDI, element, kind, value), default output is stdout." << std::endl;
+    return 1;
+  }
+
+  std::ifstream in( argv[ 1 ], std::ios::binary );
+  if( !in )
+  {
+    std::cerr << "Can't open " << argv[ 1 ] << std::endl;
+    return 1;
+  }
+  const std::vector<uint8_t> data( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+
+  std::ofstream file;
+  if( argc == 3 )
+  {
+    file.open( argv[ 2 ] );
+    if( !file )
+    {
+      std::cerr << "Can't open " << argv[ 2 ] << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& out = ( argc == 3 ) ? file : std::cout;
+
+  if( ( data.size() < 5 ) || ( data[ 0 ] != 'P' ) || ( data[ 1 ] != 'D' ) || ( data[ 2 ] != 'L' ) || ( data[ 3 ] != 'G' ) )
+  {
+    std::cerr << argv[ 1 ] << " is no process data log" << std::endl;
+    return 1;
+  }
+  if( data[ 4 ] != 1 )
+  {
+    std::cerr << "Unsupported log version " << unsigned( data[ 4 ] ) << std::endl;
+    return 1;
+  }
+
+  out << "time,ddi,element,kind,value\n";
+
+  std::map<uint64_t, Channel_s> channels;
+  Reader_c log( data, 5, data.size() );
+  while( !log.atEnd() )
+  {
+    const uint8_t type = log.getUint8();
+    const uint64_t length = log.getVarint();
+    if( !log.ok() || ( length > log.remaining() ) )
+    {
+      std::cerr << "Truncated block at offset " << log.pos() << std::endl;
+      return 2;
+    }
+
+    const size_t start = log.pos();
+    Reader_c block( data, start, start + size_t( length ) );
+    bool ok = true;
+    switch( type )
+    {
+      case 'D': ok = readDictionary( block, channels ); break;
+      case 'S': ok = readSamples( block, channels, out ); break;
+      default: break; // skip unknown blocks
+    }
+    if( !ok )
+    {
+      std::cerr << "Corrupt block at offset " << start << std::endl;
+      return 2;
+    }
+
+    log.skip( size_t( length ) );
+  }
+
+  return 0;
+}
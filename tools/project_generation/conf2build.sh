@@ -149,6 +149,7 @@ set_default_values()
     PRJ_ISO11783=0
     PRJ_ISO_VIRTUALTERMINAL_CLIENT=0
     PRJ_ISO_FILESERVER_CLIENT=0
+    PRJ_ISO_FILESERVER_SERVER=0
     PRJ_ISO_TASKCONTROLLER_CLIENT=0
     PRJ_RS232_OVER_CAN=0
     PRJ_MULTIPACKET_STREAM_CHUNK=1
@@ -243,6 +244,12 @@ check_set_correct_variables()
         exit 2
     fi
 
+    if [ "$PRJ_ISO11783" -lt 1 -a "$PRJ_ISO_FILESERVER_SERVER" -gt 0 ]; then
+        echo_ "ERROR! Can't utilize PRJ_ISO_FILESERVER_SERVER as ISO11783 is not activated"
+        echo_ "Set PRJ_ISO11783 to 1 if you want ISO 11783 fileserver support."
+        exit 2
+    fi
+
     if [ "$PRJ_ISO11783" -lt 1 -a "$PRJ_ISB_CLIENT" -gt 0 ]; then
         echo_ "ERROR! Can't utilize PRJ_ISB_CLIENT as ISO11783 is not activated"
         echo_ "Set PRJ_ISO11783 to 1 if you want ISO 11783 ISB support."
@@ -455,6 +462,10 @@ comm_features()
         printf '%s' " -o -path '*/Part13_FileServer_Client/*'" >&3
     fi
 
+    if [ "$PRJ_ISO_FILESERVER_SERVER" -gt 0 ]  ; then
+        printf '%s' " -o -path '*/Part13_FileServer_Server/*'" >&3
+    fi
+
     if [ "$PRJ_ISO_TASKCONTROLLER_CLIENT" -gt 0 ]; then
         printf '%s' " -o -path '*/Part10_TaskController_Client/*'" >&3
     fi